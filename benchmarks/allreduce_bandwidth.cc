@@ -0,0 +1,90 @@
+// Compares the bandwidth of allreduce operations with mplr::plus on double values, which is
+// mapped to the predefined MPI_SUM operation, with equivalent user-defined reduction
+// operations, which reduce single values or whole blocks, and with a plain MPI_Allreduce call.
+//
+// usage: benchmark_allreduce_bandwidth [max array size] [repetitions]
+
+#include "mplr/mplr.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// user-defined commutative reduction operation, realized via MPI_Op_create
+struct user_plus {
+  double operator()(double x, double y) const {
+    return x + y;
+  }
+};
+
+// user-defined commutative reduction operation, which reduces whole blocks at once
+struct user_plus_batched {
+  void operator()(const double* in, double* in_out, int n) const {
+    for (int i{0}; i < n; ++i)
+      in_out[i] += in[i];
+  }
+};
+
+namespace mplr {
+
+  template<>
+  struct op_traits<user_plus> {
+    static constexpr bool is_commutative = true;
+  };
+
+  template<>
+  struct op_traits<user_plus_batched> {
+    static constexpr bool is_commutative = true;
+  };
+
+}  // namespace mplr
+
+
+template<typename F>
+double run(const mplr::communicator& comm, int repetitions, F f) {
+  comm.barrier();
+  const double t_0{mplr::wtime()};
+  for (int i{0}; i < repetitions; ++i)
+    f();
+  const double t{mplr::wtime() - t_0};
+  double t_max{0};
+  comm.allreduce(mplr::max<double>(), t, t_max);
+  return t_max;
+}
+
+
+int main(int argc, char* argv[]) {
+  mplr::init(argc, argv);
+  const auto comm_world{mplr::comm_world()};
+  const int max_size{argc > 1 ? std::stoi(argv[1]) : 1 << 22};
+  const int repetitions{argc > 2 ? std::stoi(argv[2]) : 20};
+
+  if (comm_world.rank() == 0)
+    std::cout << "array size  predefined [MB/s]  user-defined [MB/s]  "
+                 "user-defined batched [MB/s]  MPI_Allreduce [MB/s]\n";
+  for (int n{1}; n <= max_size; n *= 4) {
+    std::vector<double> x(n, 1.0);
+    std::vector<double> y(n);
+    const mplr::contiguous_layout<double> l(n);
+    const double t_predefined{run(comm_world, repetitions, [&]() {
+      comm_world.allreduce(mplr::plus<double>(), x.data(), y.data(), l);
+    })};
+    const double t_user{run(comm_world, repetitions, [&]() {
+      comm_world.allreduce(user_plus(), x.data(), y.data(), l);
+    })};
+    const double t_batched{run(comm_world, repetitions, [&]() {
+      comm_world.allreduce(user_plus_batched(), x.data(), y.data(), l);
+    })};
+    const double t_mpi{run(comm_world, repetitions, [&]() {
+      MPI_Allreduce(x.data(), y.data(), n, MPI_DOUBLE, MPI_SUM, comm_world.native_handle());
+    })};
+    if (comm_world.rank() == 0) {
+      const double megabytes{1e-6 * repetitions * n * sizeof(double)};
+      std::cout << n << "  " << megabytes / t_predefined << "  " << megabytes / t_user << "  "
+                << megabytes / t_batched << "  " << megabytes / t_mpi << '\n';
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+// Measures the time of a nearest-neighbour exchange on a ring, where each process sends a
+// small message to its left and to its right neighbour, via an all-to-all operation with
+// one layout per process and via sparse layouts with the point-to-point and the collective
+// schedule.  Layouts are set up in every iteration, as is typical for data-dependent
+// exchange patterns.
+//
+// usage: benchmark_alltoallv_sparse [iterations] [message size]
+
+#include "mplr/mplr.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+using clock_type = std::chrono::steady_clock;
+
+
+double run_dense(const mplr::communicator& comm, int iterations, int n) {
+  const int size{comm.size()};
+  const int rank{comm.rank()};
+  const std::vector<double> send_data(2 * n, rank);
+  std::vector<double> recv_data(2 * n);
+  comm.barrier();
+  const auto t_0{clock_type::now()};
+  for (int i{0}; i < iterations; ++i) {
+    mplr::layouts<double> sendls(size), recvls(size);
+    mplr::displacements senddispls(size), recvdispls(size);
+    const int left{(rank + size - 1) % size}, right{(rank + 1) % size};
+    sendls[left] = recvls[left] = mplr::vector_layout<double>(n);
+    sendls[right] = recvls[right] = mplr::vector_layout<double>(n);
+    // displacements are scaled by the size of the elements
+    senddispls[right] = recvdispls[right] = n;
+    comm.alltoallv(send_data.data(), sendls, senddispls, recv_data.data(), recvls,
+                   recvdispls);
+  }
+  return std::chrono::duration<double>(clock_type::now() - t_0).count();
+}
+
+
+double run_sparse(const mplr::communicator& comm, int iterations, int n,
+                  mplr::sparse_schedule schedule) {
+  const int size{comm.size()};
+  const int rank{comm.rank()};
+  const std::vector<double> send_data(2 * n, rank);
+  std::vector<double> recv_data(2 * n);
+  comm.barrier();
+  const auto t_0{clock_type::now()};
+  for (int i{0}; i < iterations; ++i) {
+    mplr::sparse_layouts<double> ls;
+    ls.push_back((rank + size - 1) % size, mplr::vector_layout<double>(n));
+    ls.push_back((rank + 1) % size, mplr::vector_layout<double>(n), n);
+    comm.alltoallv(send_data.data(), ls, recv_data.data(), ls, mplr::tag_t{0}, schedule);
+  }
+  return std::chrono::duration<double>(clock_type::now() - t_0).count();
+}
+
+
+int main(int argc, char* argv[]) {
+  mplr::init();
+  const int iterations{argc > 1 ? std::atoi(argv[1]) : 1000};
+  const int n{argc > 2 ? std::atoi(argv[2]) : 16};
+  const auto comm_world{mplr::comm_world()};
+  if (comm_world.size() < 3) {
+    if (comm_world.rank() == 0)
+      std::cerr << "at least three processes required\n";
+    return EXIT_FAILURE;
+  }
+  const double t_dense{run_dense(comm_world, iterations, n)};
+  const double t_point_to_point{
+      run_sparse(comm_world, iterations, n, mplr::sparse_schedule::point_to_point)};
+  const double t_collective{
+      run_sparse(comm_world, iterations, n, mplr::sparse_schedule::collective)};
+  if (comm_world.rank() == 0)
+    std::cout << std::setw(24) << "variant" << std::setw(16) << "us per exchange" << '\n'
+              << std::setw(24) << "layouts" << std::setw(16) << t_dense / iterations * 1e6
+              << '\n'
+              << std::setw(24) << "sparse, point-to-point" << std::setw(16)
+              << t_point_to_point / iterations * 1e6 << '\n'
+              << std::setw(24) << "sparse, collective" << std::setw(16)
+              << t_collective / iterations * 1e6 << '\n';
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+// Compares the time per overlap update of a two-dimensional distributed grid as in the
+// heat_equation_Jacobi_method example via blocking sendrecv operations, via non-blocking
+// operations that are set up in every iteration and via a persistent halo exchange plan.
+//
+// usage: benchmark_halo_exchange [iterations] [grid size x] [grid size y]
+
+#include "mplr/mplr.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+
+using grid_type = mplr::distributed_grid<2, double>;
+
+
+// blocking exchange, sending left and right in each dimension
+void update_overlap_sendrecv(const mplr::cartesian_communicator& comm, grid_type& grid) {
+  for (std::size_t i{0}; i < 2; ++i) {
+    auto ranks{comm.shift(i, -1)};
+    comm.sendrecv(grid.data(), grid.left_border_layout(i), ranks.destination, mplr::tag_t{0},
+                  grid.data(), grid.right_mirror_layout(i), ranks.source, mplr::tag_t{0});
+    ranks = comm.shift(i, +1);
+    comm.sendrecv(grid.data(), grid.right_border_layout(i), ranks.destination, mplr::tag_t{0},
+                  grid.data(), grid.left_mirror_layout(i), ranks.source, mplr::tag_t{0});
+  }
+}
+
+
+// non-blocking exchange as in the heat_equation_Jacobi_method example
+void update_overlap_isend_irecv(const mplr::cartesian_communicator& comm, grid_type& grid) {
+  mplr::irequest_pool r;
+  for (std::size_t i{0}; i < 2; ++i) {
+    auto ranks{comm.shift(i, -1)};
+    r.push(comm.isend(grid.data(), grid.left_border_layout(i), ranks.destination));
+    r.push(comm.irecv(grid.data(), grid.right_mirror_layout(i), ranks.source));
+    ranks = comm.shift(i, +1);
+    r.push(comm.isend(grid.data(), grid.right_border_layout(i), ranks.destination));
+    r.push(comm.irecv(grid.data(), grid.left_mirror_layout(i), ranks.source));
+  }
+  r.waitall();
+}
+
+
+template<typename F>
+double run(const mplr::cartesian_communicator& comm, int iterations, F update) {
+  comm.barrier();
+  const double t_0{mplr::wtime()};
+  for (int i{0}; i < iterations; ++i)
+    update();
+  comm.barrier();
+  return (mplr::wtime() - t_0) / iterations;
+}
+
+
+int main(int argc, char* argv[]) {
+  mplr::init(argc, argv);
+  const auto comm_world{mplr::comm_world()};
+  const int iterations{argc > 1 ? std::stoi(argv[1]) : 100000};
+  const int n_x{argc > 2 ? std::stoi(argv[2]) : 768};
+  const int n_y{argc > 3 ? std::stoi(argv[3]) : 512};
+
+  mplr::cartesian_communicator::dimensions size{mplr::cartesian_communicator::non_periodic,
+                                                mplr::cartesian_communicator::non_periodic};
+  mplr::cartesian_communicator comm_c{comm_world, mplr::dims_create(comm_world.size(), size)};
+  grid_type grid(comm_c, {{n_x, 1}, {n_y, 1}});
+  mplr::halo_exchange plan(comm_c, grid);
+
+  const double t_sendrecv{
+      run(comm_c, iterations, [&]() { update_overlap_sendrecv(comm_c, grid); })};
+  const double t_isend_irecv{
+      run(comm_c, iterations, [&]() { update_overlap_isend_irecv(comm_c, grid); })};
+  const double t_plan{run(comm_c, iterations, [&]() { plan.exchange(); })};
+  if (comm_c.rank() == 0)
+    std::cout << "processes: " << comm_c.size() << ", grid size: " << n_x << " x " << n_y
+              << '\n'
+              << "sendrecv:        " << t_sendrecv * 1e6 << " us per update\n"
+              << "isend and irecv: " << t_isend_irecv * 1e6 << " us per update\n"
+              << "persistent plan: " << t_plan * 1e6 << " us per update\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,70 @@
+// Measures the time of an all-reduce operation and of a broadcast over all processes and over
+// a hierarchical communicator.  Nodes are either the groups of processes that share memory or,
+// if a node size is given, are emulated by consecutive ranks.
+//
+// usage: benchmark_hierarchical_collectives [iterations] [message size] [node size]
+
+#include "mplr/mplr.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+using clock_type = std::chrono::steady_clock;
+
+
+template<typename C>
+double run_allreduce(const C& comm, int iterations, int n) {
+  const std::vector<double> send_data(n, comm.rank());
+  std::vector<double> recv_data(n);
+  const mplr::contiguous_layout<double> l(n);
+  mplr::comm_world().barrier();
+  const auto t_0{clock_type::now()};
+  for (int i{0}; i < iterations; ++i)
+    comm.allreduce(mplr::plus<double>(), send_data.data(), recv_data.data(), l);
+  return std::chrono::duration<double>(clock_type::now() - t_0).count();
+}
+
+
+template<typename C>
+double run_bcast(const C& comm, int iterations, int n) {
+  std::vector<double> data(n, comm.rank());
+  const mplr::contiguous_layout<double> l(n);
+  mplr::comm_world().barrier();
+  const auto t_0{clock_type::now()};
+  for (int i{0}; i < iterations; ++i)
+    comm.bcast(i % comm.size(), data.data(), l);
+  return std::chrono::duration<double>(clock_type::now() - t_0).count();
+}
+
+
+int main(int argc, char* argv[]) {
+  mplr::init();
+  const int iterations{argc > 1 ? std::atoi(argv[1]) : 1000};
+  const int n{argc > 2 ? std::atoi(argv[2]) : 1024};
+  const int node_size{argc > 3 ? std::atoi(argv[3]) : 0};
+  const auto comm_world{mplr::comm_world()};
+  const auto hierarchical{
+      node_size > 0 ? mplr::hierarchical_communicator{mplr::communicator::split, comm_world,
+                                                      comm_world.rank() / node_size}
+                    : mplr::hierarchical_communicator{comm_world}};
+  const double t_allreduce_flat{run_allreduce(comm_world, iterations, n)};
+  const double t_allreduce_hierarchical{run_allreduce(hierarchical, iterations, n)};
+  const double t_bcast_flat{run_bcast(comm_world, iterations, n)};
+  const double t_bcast_hierarchical{run_bcast(hierarchical, iterations, n)};
+  if (comm_world.rank() == 0)
+    std::cout << hierarchical.node_count() << " nodes\n"
+              << std::setw(24) << "variant" << std::setw(18) << "us per operation" << '\n'
+              << std::setw(24) << "allreduce, flat" << std::setw(18)
+              << t_allreduce_flat / iterations * 1e6 << '\n'
+              << std::setw(24) << "allreduce, hierarchical" << std::setw(18)
+              << t_allreduce_hierarchical / iterations * 1e6 << '\n'
+              << std::setw(24) << "bcast, flat" << std::setw(18)
+              << t_bcast_flat / iterations * 1e6 << '\n'
+              << std::setw(24) << "bcast, hierarchical" << std::setw(18)
+              << t_bcast_hierarchical / iterations * 1e6 << '\n';
+  return EXIT_SUCCESS;
+}
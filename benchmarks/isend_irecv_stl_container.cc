@@ -0,0 +1,109 @@
+// Compares the throughput of non-blocking sends and receives of non-contiguous STL
+// containers, which are driven by MPLR's progress engine, with a reference implementation
+// that spawns a detached thread per operation.
+//
+// usage: benchmark_isend_irecv_stl_container [messages] [batch size] [container size]
+
+#include "mplr/mplr.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// reference implementation: one detached thread per operation completes a generalized request
+namespace thread_per_op {
+
+  int query(void*, MPI_Status* s) {
+    MPI_Status_set_elements(s, MPI_BYTE, 0);
+    MPI_Status_set_cancelled(s, 0);
+    s->MPI_SOURCE = MPI_UNDEFINED;
+    s->MPI_TAG = MPI_UNDEFINED;
+    return MPI_SUCCESS;
+  }
+
+  int free(void*) {
+    return MPI_SUCCESS;
+  }
+
+  int cancel(void*, int) {
+    return MPI_SUCCESS;
+  }
+
+  template<typename F>
+  mplr::irequest start(F f) {
+    MPI_Request req;
+    MPI_Grequest_start(query, free, cancel, nullptr, &req);
+    std::thread thread([f, req]() mutable {
+      f();
+      MPI_Grequest_complete(req);
+    });
+    thread.detach();
+    return mplr::impl::base_irequest{req};
+  }
+
+}  // namespace thread_per_op
+
+
+template<typename Start>
+double run(const mplr::communicator& comm, int messages, int batch_size, Start start) {
+  comm.barrier();
+  const double t_0{mplr::wtime()};
+  for (int i{0}; i < messages; i += batch_size) {
+    const int n{std::min(batch_size, messages - i)};
+    mplr::irequest_pool pool;
+    for (int j{0}; j < n; ++j)
+      pool.push(start(j));
+    pool.waitall();
+  }
+  comm.barrier();
+  return mplr::wtime() - t_0;
+}
+
+
+int main(int argc, char* argv[]) {
+  mplr::init(argc, argv);
+  const auto comm_world{mplr::comm_world()};
+  // run the program with two or more processes
+  if (comm_world.size() < 2)
+    return EXIT_FAILURE;
+  const int messages{argc > 1 ? std::stoi(argv[1]) : 20000};
+  const int batch_size{argc > 2 ? std::stoi(argv[2]) : 256};
+  const int container_size{argc > 3 ? std::stoi(argv[3]) : 16};
+
+  std::deque<double> message(container_size);
+  std::iota(message.begin(), message.end(), 0);
+  std::vector<std::deque<double>> received(batch_size);
+
+  double t_engine{0};
+  double t_thread{0};
+  if (comm_world.rank() == 0) {
+    t_engine = run(comm_world, messages, batch_size,
+                   [&](int) { return comm_world.isend(message, 1); });
+    t_thread = run(comm_world, messages, batch_size, [&](int) {
+      return thread_per_op::start([&]() { comm_world.send(message, 1); });
+    });
+  } else if (comm_world.rank() == 1) {
+    t_engine = run(comm_world, messages, batch_size,
+                   [&](int j) { return comm_world.irecv(received[j], 0); });
+    t_thread = run(comm_world, messages, batch_size, [&](int j) {
+      return thread_per_op::start([&, j]() { comm_world.recv(received[j], 0); });
+    });
+  } else {
+    // two barriers per run
+    for (int i{0}; i < 4; ++i)
+      comm_world.barrier();
+  }
+  if (comm_world.rank() == 0) {
+    std::cout << "messages: " << messages << ", batch size: " << batch_size
+              << ", container size: " << container_size << '\n'
+              << "progress engine: " << messages / t_engine << " messages/s\n"
+              << "thread per op:   " << messages / t_thread << " messages/s\n";
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+// Measures the overhead of passing displacements that exceed the range of int to an
+// all-to-all operation with layouts, where such displacements are moved into derived data
+// types, relative to a plain MPI_Alltoallw call with int displacements.  The limit is reduced
+// to a small value, such that the large-count code path is taken for moderate message sizes.
+// Optionally, a single all-to-all operation with layouts is timed, in which every process
+// sends the given number of bytes to the next process.  Counts beyond 2^31 exercise the real
+// large-count path, which passes such counts via derived data types.  This needs twice the
+// number of bytes of memory per process.
+//
+// usage: benchmark_large_count [iterations] [message size] [large message bytes]
+
+#define MPLR_LARGE_COUNT_LIMIT 1024
+
+#include "mplr/mplr.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+using clock_type = std::chrono::steady_clock;
+
+
+double run_mplr(const mplr::communicator& comm, int iterations, int n) {
+  const int size{comm.size()};
+  const std::vector<double> send_data(static_cast<std::size_t>(size) * n, comm.rank());
+  std::vector<double> recv_data(static_cast<std::size_t>(size) * n);
+  mplr::layouts<double> ls;
+  mplr::displacements displs;
+  for (int i{0}; i < size; ++i) {
+    ls.push_back(mplr::vector_layout<double>(n));
+    // displacements are scaled by the size of the elements
+    displs.push_back(static_cast<MPI_Aint>(i) * n);
+  }
+  comm.barrier();
+  const auto t_0{clock_type::now()};
+  for (int i{0}; i < iterations; ++i)
+    comm.alltoallv(send_data.data(), ls, displs, recv_data.data(), ls, displs);
+  return std::chrono::duration<double>(clock_type::now() - t_0).count();
+}
+
+
+double run_mpi(const mplr::communicator& comm, int iterations, int n) {
+  const int size{comm.size()};
+  const std::vector<double> send_data(static_cast<std::size_t>(size) * n, comm.rank());
+  std::vector<double> recv_data(static_cast<std::size_t>(size) * n);
+  const std::vector<int> counts(size, n);
+  const std::vector<MPI_Datatype> types(size, MPI_DOUBLE);
+  std::vector<int> displs;
+  for (int i{0}; i < size; ++i)
+    displs.push_back(static_cast<int>(sizeof(double)) * n * i);
+  comm.barrier();
+  const auto t_0{clock_type::now()};
+  for (int i{0}; i < iterations; ++i)
+    MPI_Alltoallw(send_data.data(), counts.data(), displs.data(), types.data(),
+                  recv_data.data(), counts.data(), displs.data(), types.data(),
+                  comm.native_handle());
+  return std::chrono::duration<double>(clock_type::now() - t_0).count();
+}
+
+
+double run_large(const mplr::communicator& comm, std::size_t bytes) {
+  const int size{comm.size()};
+  const int rank{comm.rank()};
+  const std::vector<char> send_data(bytes, 1);
+  std::vector<char> recv_data(bytes);
+  mplr::layouts<char> sendls(size), recvls(size);
+  sendls[(rank + 1) % size] = mplr::contiguous_layout<char>(bytes);
+  recvls[(rank + size - 1) % size] = mplr::contiguous_layout<char>(bytes);
+  const mplr::displacements displs(size);
+  comm.barrier();
+  const auto t_0{clock_type::now()};
+  comm.alltoallv(send_data.data(), sendls, displs, recv_data.data(), recvls, displs);
+  return std::chrono::duration<double>(clock_type::now() - t_0).count();
+}
+
+
+int main(int argc, char* argv[]) {
+  mplr::init();
+  const int iterations{argc > 1 ? std::atoi(argv[1]) : 1000};
+  const int n{argc > 2 ? std::atoi(argv[2]) : 1024};
+  const std::size_t large_bytes{argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 0};
+  const auto comm_world{mplr::comm_world()};
+  const double t_mpi{run_mpi(comm_world, iterations, n)};
+  const double t_mplr{run_mplr(comm_world, iterations, n)};
+  if (comm_world.rank() == 0)
+    std::cout << std::setw(24) << "variant" << std::setw(16) << "us per exchange" << '\n'
+              << std::setw(24) << "MPI_Alltoallw" << std::setw(16)
+              << t_mpi / iterations * 1e6 << '\n'
+              << std::setw(24) << "layouts, large displs" << std::setw(16)
+              << t_mplr / iterations * 1e6 << '\n';
+  if (large_bytes > 0) {
+    const double t_large{run_large(comm_world, large_bytes)};
+    if (comm_world.rank() == 0)
+      std::cout << std::setw(24) << "layouts, large count" << std::setw(16) << t_large * 1e6
+                << "  (" << large_bytes / t_large / 1e9 << " GB/s)\n";
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+// Measures the time for constructing the layouts of a sample-sort-like exchange, i.e., one
+// indexed layout and one three-dimensional subarray layout per process and iteration, with
+// the data type cache disabled and enabled.  Message sizes repeat after a few iterations, as
+// is typical for iterative algorithms.
+//
+// usage: benchmark_layout_construction [iterations] [processes]
+
+#include "mplr/mplr.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+
+using clock_type = std::chrono::steady_clock;
+
+
+double run(int iterations, int processes) {
+  const auto t_0{clock_type::now()};
+  for (int i{0}; i < iterations; ++i) {
+    mplr::layouts<double> ls;
+    for (int p{0}; p < processes; ++p) {
+      const int n{(p * 7 + i) % 16};
+      ls.push_back(mplr::indexed_layout<double>({{n, 2 * p}, {n, 2 * p + 64}}));
+      ls.push_back(mplr::subarray_layout<double>({{64, n + 1, p % 8}, {64, 8, 0}, {8, 8, 0}}));
+    }
+  }
+  return std::chrono::duration<double>(clock_type::now() - t_0).count();
+}
+
+
+int main(int argc, char* argv[]) {
+  mplr::init();
+  const int iterations{argc > 1 ? std::atoi(argv[1]) : 1000};
+  const int processes{argc > 2 ? std::atoi(argv[2]) : 256};
+  const auto comm_world{mplr::comm_world()};
+  const double t_uncached{run(iterations, processes)};
+  mplr::datatype_cache::enable(2 * 16 * static_cast<std::size_t>(processes));
+  const double t_cached{run(iterations, processes)};
+  const auto stats{mplr::datatype_cache::statistics()};
+  if (comm_world.rank() == 0) {
+    const double layouts{2.0 * iterations * processes};
+    std::cout << std::setw(12) << "cache" << std::setw(16) << "ns per layout" << '\n'
+              << std::setw(12) << "disabled" << std::setw(16) << t_uncached / layouts * 1e9
+              << '\n'
+              << std::setw(12) << "enabled" << std::setw(16) << t_cached / layouts * 1e9
+              << '\n'
+              << "hits: " << stats.hits << ", misses: " << stats.misses
+              << ", evictions: " << stats.evictions << '\n';
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+// Compares the throughput of many small messages sent via individual non-blocking sends with
+// the throughput of the same records sent via MPLR's message aggregator.
+//
+// usage: benchmark_message_aggregator [records] [aggregate bytes]
+
+#include "mplr/mplr.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+template<std::size_t N>
+using record = std::array<double, N>;
+
+
+// process 0 sends all records to process 1 via one non-blocking send per record
+template<std::size_t N>
+double run_isend(const mplr::communicator& comm, int records) {
+  constexpr int batch_size{1024};
+  std::vector<record<N>> buffer(batch_size);
+  comm.barrier();
+  const double t_0{mplr::wtime()};
+  for (int i{0}; i < records; i += batch_size) {
+    const int n{std::min(batch_size, records - i)};
+    mplr::irequest_pool pool;
+    for (int j{0}; j < n; ++j) {
+      if (comm.rank() == 0) {
+        buffer[j].fill(i + j);
+        pool.push(comm.isend(buffer[j], 1));
+      } else if (comm.rank() == 1)
+        pool.push(comm.irecv(buffer[j], 0));
+    }
+    pool.waitall();
+  }
+  comm.barrier();
+  return mplr::wtime() - t_0;
+}
+
+
+// process 0 sends all records to process 1 via the message aggregator
+template<std::size_t N>
+double run_aggregator(const mplr::communicator& comm, int records, std::size_t max_bytes) {
+  mplr::message_aggregator<record<N>> aggregator(comm, max_bytes);
+  double sum{0};
+  comm.barrier();
+  const double t_0{mplr::wtime()};
+  if (comm.rank() == 0) {
+    record<N> r;
+    for (int i{0}; i < records; ++i) {
+      r.fill(i);
+      aggregator.push(r, 1);
+    }
+    aggregator.flush();
+  } else if (comm.rank() == 1) {
+    for (int received{0}; received < records;) {
+      const auto batch{aggregator.receive(0)};
+      for (const auto& r : batch)
+        sum += r[0];
+      received += static_cast<int>(batch.size());
+    }
+  }
+  comm.barrier();
+  const double t{mplr::wtime() - t_0};
+  // keep the receive loop from being optimized away
+  if (sum < 0)
+    std::cerr << sum << '\n';
+  return t;
+}
+
+
+template<std::size_t N>
+void run(const mplr::communicator& comm, int records, std::size_t max_bytes) {
+  const double t_isend{run_isend<N>(comm, records)};
+  const double t_aggregator{run_aggregator<N>(comm, records, max_bytes)};
+  if (comm.rank() == 0)
+    std::cout << sizeof(record<N>) << " bytes:\tisend " << records / t_isend
+              << " records/s\taggregator " << records / t_aggregator << " records/s\n";
+}
+
+
+int main(int argc, char* argv[]) {
+  mplr::init(argc, argv);
+  const auto comm_world{mplr::comm_world()};
+  // run the program with two or more processes
+  if (comm_world.size() < 2)
+    return EXIT_FAILURE;
+  const int records{argc > 1 ? std::stoi(argv[1]) : 1000000};
+  const std::size_t max_bytes{argc > 2 ? std::stoul(argv[2]) : std::size_t{1} << 16};
+
+  if (comm_world.rank() == 0)
+    std::cout << "records: " << records << ", aggregate bytes: " << max_bytes << '\n';
+  run<2>(comm_world, records, max_bytes);
+  run<4>(comm_world, records, max_bytes);
+  run<8>(comm_world, records, max_bytes);
+  return EXIT_SUCCESS;
+}
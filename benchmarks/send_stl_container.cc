@@ -0,0 +1,82 @@
+// Compares two strategies for sending non-contiguous STL containers: serializing the container
+// into a contiguous buffer and describing the container's memory by an iterator layout, i.e.,
+// an MPI_Type_create_hindexed datatype, which avoids the intermediate copy.
+//
+// usage: benchmark_send_stl_container [max container size] [repetitions]
+
+#include "mplr/mplr.hpp"
+
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <list>
+#include <numeric>
+#include <set>
+#include <string>
+#include <vector>
+
+
+template<typename F>
+double run(const mplr::communicator& comm, int repetitions, F f) {
+  comm.barrier();
+  const double t_0{mplr::wtime()};
+  for (int i{0}; i < repetitions; ++i)
+    f();
+  comm.barrier();
+  return mplr::wtime() - t_0;
+}
+
+
+template<typename C>
+void benchmark(const mplr::communicator& comm, const char* name, int max_size,
+               int repetitions) {
+  using value_type = typename C::value_type;
+  if (comm.rank() == 0)
+    std::cout << name << "\ncontainer size  copy [MB/s]  hindexed [MB/s]\n";
+  for (int n{1}; n <= max_size; n *= 4) {
+    std::vector<value_type> values(n);
+    std::iota(values.begin(), values.end(), 0);
+    const C data(values.begin(), values.end());
+    std::vector<value_type> received(n);
+    const mplr::contiguous_layout<value_type> l(n);
+    double t_copy{0};
+    double t_hindexed{0};
+    if (comm.rank() == 0) {
+      t_copy = run(comm, repetitions, [&]() {
+        const std::vector<value_type> serial_data(data.begin(), data.end());
+        comm.send(serial_data.data(), l, 1);
+      });
+      t_hindexed = run(comm, repetitions, [&]() {
+        const mplr::iterator_layout<value_type> l_data(data.begin(), data.end());
+        comm.send(&*data.begin(), l_data, 1);
+      });
+    } else if (comm.rank() == 1) {
+      t_copy = run(comm, repetitions, [&]() { comm.recv(received.data(), l, 0); });
+      t_hindexed = run(comm, repetitions, [&]() { comm.recv(received.data(), l, 0); });
+    } else {
+      // two barriers per run
+      for (int i{0}; i < 4; ++i)
+        comm.barrier();
+    }
+    if (comm.rank() == 0) {
+      const double megabytes{1e-6 * repetitions * n * sizeof(value_type)};
+      std::cout << n << "  " << megabytes / t_copy << "  " << megabytes / t_hindexed << '\n';
+    }
+  }
+}
+
+
+int main(int argc, char* argv[]) {
+  mplr::init(argc, argv);
+  const auto comm_world{mplr::comm_world()};
+  // run the program with two or more processes
+  if (comm_world.size() < 2)
+    return EXIT_FAILURE;
+  const int max_size{argc > 1 ? std::stoi(argv[1]) : 1 << 22};
+  const int repetitions{argc > 2 ? std::stoi(argv[2]) : 20};
+
+  benchmark<std::deque<double>>(comm_world, "std::deque<double>", max_size, repetitions);
+  benchmark<std::list<double>>(comm_world, "std::list<double>", max_size, repetitions);
+  benchmark<std::set<int>>(comm_world, "std::set<int>", max_size, repetitions);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+// Compares the wait policies by a ping-pong between two processes, where the responding
+// process delays each reply by a fixed time.  For each policy and delay the benchmark
+// reports the mean round-trip time in excess of the delay and the fraction of the wall time
+// the waiting thread consumes CPU time.
+//
+// usage: benchmark_wait_policy [iterations]
+
+#include "mplr/mplr.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+
+using clock_type = std::chrono::steady_clock;
+
+
+// busy waits to emulate a computation of the given duration
+void compute(std::chrono::nanoseconds duration) {
+  const auto end{clock_type::now() + duration};
+  while (clock_type::now() < end) {
+  }
+}
+
+
+// process 0 sends a ping and waits for the delayed reply of process 1 with the given policy
+template<typename P>
+void run(const mplr::communicator& comm, int iterations, std::chrono::nanoseconds delay,
+         const std::string& name, const P& policy) {
+  double round_trip{0};
+  double cpu{0};
+  comm.barrier();
+  for (int i{0}; i < iterations; ++i) {
+    int x{i};
+    if (comm.rank() == 0) {
+      const auto t_0{clock_type::now()};
+      auto r{comm.irecv(x, 1)};
+      comm.send(x, 1);
+      mplr::detail::thread_stopwatch cpu_time;
+      r.wait(policy);
+      cpu += std::chrono::duration<double>(cpu_time.read()).count();
+      round_trip += std::chrono::duration<double>(clock_type::now() - t_0).count();
+    } else if (comm.rank() == 1) {
+      comm.recv(x, 0);
+      compute(delay);
+      comm.send(x, 0);
+    }
+  }
+  comm.barrier();
+  if (comm.rank() == 0) {
+    const double excess{round_trip / iterations - std::chrono::duration<double>(delay).count()};
+    std::cout << std::setw(10) << std::chrono::duration<double, std::micro>(delay).count()
+              << std::setw(10) << name << std::setw(16) << excess * 1e6 << std::setw(10)
+              << 100 * cpu / round_trip << '\n';
+  }
+}
+
+
+int main(int argc, char* argv[]) {
+  mplr::init(argc, argv);
+  const auto comm_world{mplr::comm_world()};
+  // run the program with two or more processes
+  if (comm_world.size() < 2)
+    return EXIT_FAILURE;
+  const int iterations{argc > 1 ? std::stoi(argv[1]) : 1000};
+
+  if (comm_world.rank() == 0)
+    std::cout << "iterations: " << iterations << '\n'
+              << std::setw(10) << "delay/us" << std::setw(10) << "policy" << std::setw(16)
+              << "excess time/us" << std::setw(10) << "CPU/%" << '\n';
+  for (const std::chrono::nanoseconds delay :
+       {std::chrono::nanoseconds{0}, std::chrono::nanoseconds{std::chrono::microseconds{10}},
+        std::chrono::nanoseconds{std::chrono::microseconds{100}},
+        std::chrono::nanoseconds{std::chrono::milliseconds{1}}}) {
+    run(comm_world, iterations, delay, "busy", mplr::busy_wait{});
+    run(comm_world, iterations, delay, "duty", mplr::duty_ratio{0.01});
+    run(comm_world, iterations, delay, "backoff", mplr::backoff_wait{});
+    mplr::adaptive_wait adaptive;
+    run(comm_world, iterations, delay, "adaptive", adaptive);
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+// Measures the time of an irregular gather, where each process reads a number of randomly
+// chosen elements of a distributed array, via remote memory access in a passive-target
+// epoch and via a two-sided exchange of requested indices and values.
+//
+// usage: benchmark_window_gather [iterations] [elements per process] [reads per process]
+
+#include "mplr/mplr.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+using clock_type = std::chrono::steady_clock;
+
+
+struct read_request {
+  int rank;
+  int index;
+};
+
+
+std::vector<read_request> make_requests(const mplr::communicator& comm, int n, int reads) {
+  std::mt19937 engine(comm.rank());
+  std::uniform_int_distribution<int> rank(0, comm.size() - 1), index(0, n - 1);
+  std::vector<read_request> requests;
+  for (int i{0}; i < reads; ++i)
+    requests.push_back({rank(engine), index(engine)});
+  return requests;
+}
+
+
+double run_window(const mplr::communicator& comm, int iterations, int n,
+                  const std::vector<read_request>& requests) {
+  mplr::window<double> win{comm, static_cast<std::size_t>(n)};
+  std::fill_n(win.data(), n, comm.rank());
+  std::vector<double> values(requests.size());
+  comm.barrier();
+  const auto t_0{clock_type::now()};
+  for (int i{0}; i < iterations; ++i) {
+    win.lock_all();
+    for (std::size_t j{0}; j < requests.size(); ++j)
+      win.get(values[j], requests[j].rank, requests[j].index);
+    win.unlock_all();
+  }
+  const double t{std::chrono::duration<double>(clock_type::now() - t_0).count()};
+  comm.barrier();
+  return t;
+}
+
+
+double run_two_sided(const mplr::communicator& comm, int iterations, int n,
+                     const std::vector<read_request>& requests) {
+  const int size{comm.size()};
+  const std::vector<double> data(n, comm.rank());
+  std::vector<double> values(requests.size());
+  comm.barrier();
+  const auto t_0{clock_type::now()};
+  for (int i{0}; i < iterations; ++i) {
+    // sort the requested indices by rank and send them to their owners
+    std::vector<int> sendcounts(size, 0), recvcounts(size);
+    for (const auto& r : requests)
+      ++sendcounts[r.rank];
+    comm.alltoall(sendcounts.data(), recvcounts.data());
+    mplr::contiguous_layouts<int> sendls, recvls;
+    mplr::displacements senddispls, recvdispls;
+    int send_total{0}, recv_total{0};
+    for (int j{0}; j < size; ++j) {
+      sendls.push_back(mplr::contiguous_layout<int>(sendcounts[j]));
+      recvls.push_back(mplr::contiguous_layout<int>(recvcounts[j]));
+      senddispls.push_back(send_total);
+      recvdispls.push_back(recv_total);
+      send_total += sendcounts[j];
+      recv_total += recvcounts[j];
+    }
+    std::vector<int> indices(send_total), position(requests.size());
+    std::vector<int> offsets(senddispls.begin(), senddispls.end());
+    for (std::size_t j{0}; j < requests.size(); ++j) {
+      position[j] = offsets[requests[j].rank]++;
+      indices[position[j]] = requests[j].index;
+    }
+    std::vector<int> requested(recv_total);
+    comm.alltoallv(indices.data(), sendls, senddispls, requested.data(), recvls, recvdispls);
+    // answer the requests and send the values back
+    std::vector<double> answers(recv_total), answered(send_total);
+    for (int j{0}; j < recv_total; ++j)
+      answers[j] = data[requested[j]];
+    mplr::contiguous_layouts<double> answerls, answeredls;
+    for (int j{0}; j < size; ++j) {
+      answerls.push_back(mplr::contiguous_layout<double>(recvcounts[j]));
+      answeredls.push_back(mplr::contiguous_layout<double>(sendcounts[j]));
+    }
+    comm.alltoallv(answers.data(), answerls, recvdispls, answered.data(), answeredls,
+                   senddispls);
+    for (std::size_t j{0}; j < requests.size(); ++j)
+      values[j] = answered[position[j]];
+  }
+  return std::chrono::duration<double>(clock_type::now() - t_0).count();
+}
+
+
+int main(int argc, char* argv[]) {
+  mplr::init();
+  const int iterations{argc > 1 ? std::atoi(argv[1]) : 100};
+  const int n{argc > 2 ? std::atoi(argv[2]) : 1 << 16};
+  const int reads{argc > 3 ? std::atoi(argv[3]) : 64};
+  const auto comm_world{mplr::comm_world()};
+  const auto requests{make_requests(comm_world, n, reads)};
+  const double t_window{run_window(comm_world, iterations, n, requests)};
+  const double t_two_sided{run_two_sided(comm_world, iterations, n, requests)};
+  if (comm_world.rank() == 0)
+    std::cout << std::setw(24) << "variant" << std::setw(18) << "us per gather" << '\n'
+              << std::setw(24) << "window, passive target" << std::setw(18)
+              << t_window / iterations * 1e6 << '\n'
+              << std::setw(24) << "two-sided exchange" << std::setw(18)
+              << t_two_sided / iterations * 1e6 << '\n';
+  return EXIT_SUCCESS;
+}
@@ -5,34 +5,11 @@
 #include <iostream>
 #include <random>
 #include <tuple>
+#include <utility>
 
 using double_2 = std::tuple<double, double>;
 
 
-template<std::size_t dim, typename T, typename A>
-mplr::irequest_pool update_overlap(const mplr::cartesian_communicator &communicator,
-                                   mplr::distributed_grid<dim, T, A> &distributed_grid,
-                                   mplr::tag_t tag = mplr::tag_t()) {
-  mplr::shift_ranks ranks;
-  mplr::irequest_pool r;
-  for (std::size_t i{0}; i < dim; ++i) {
-    // send to left
-    ranks = communicator.shift(i, -1);
-    r.push(communicator.isend(distributed_grid.data(), distributed_grid.left_border_layout(i),
-                              ranks.destination, tag));
-    r.push(communicator.irecv(distributed_grid.data(), distributed_grid.right_mirror_layout(i),
-                              ranks.source, tag));
-    // send to right
-    ranks = communicator.shift(i, +1);
-    r.push(communicator.isend(distributed_grid.data(), distributed_grid.right_border_layout(i),
-                              ranks.destination, tag));
-    r.push(communicator.irecv(distributed_grid.data(), distributed_grid.left_mirror_layout(i),
-                              ranks.source, tag));
-  }
-  return r;
-}
-
-
 template<std::size_t dim, typename T, typename A>
 void scatter(const mplr::cartesian_communicator &communicator, int root,
              const mplr::local_grid<dim, T, A> &local_grid,
@@ -113,13 +90,17 @@ int main() {
         u_d_1(i, j) = u_d_2(i, j) = 0;  // upper boundary condition
     }
   const double dx_2{dx * dx}, dy_2{dy * dy};
+  // persistent plans that exchange overlapping boundary data of both grids, the grids swap
+  // their storage after each iteration and so do the plans
+  mplr::halo_exchange update_overlap_1(comm_c, u_d_1);
+  mplr::halo_exchange update_overlap_2(comm_c, u_d_2);
   // loop until converged
   bool converged{false};
   int iterations{0};
   while (not converged) {
     iterations++;
     // exchange asynchronously overlapping boundary data
-    mplr::irequest_pool r(update_overlap(comm_c, u_d_1));
+    update_overlap_1.start();
     // apply one Jacobi iteration step for interior region
     double delta_u{0}, sum_u{0};
     for (auto j{u_d_1.begin(1) + 1}, j_end{u_d_1.end(1) - 1}; j < j_end; ++j)
@@ -130,7 +111,7 @@ int main() {
         delta_u += std::abs(u_d_2(i, j) - u_d_1(i, j));
         sum_u += std::abs(u_d_2(i, j));
       }
-    r.waitall();
+    update_overlap_1.wait();
     // apply one Jacobi iteration step for edge region, which requires overlapping boundary data
     for (auto j : {u_d_1.begin(1), u_d_1.end(1) - 1})
       for (auto i{u_d_1.begin(0)}, i_end{u_d_1.end(0)}; i < i_end; ++i) {
@@ -159,6 +140,7 @@ int main() {
     std::tie(delta_u, sum_u) = delta_sum_u;  // unpack from pair
     converged = delta_u / sum_u < 1e-3;      // check for convergence
     u_d_2.swap(u_d_1);
+    std::swap(update_overlap_1, update_overlap_2);
   }
   // gather data and print result
   if (comm_c.rank() == 0) {
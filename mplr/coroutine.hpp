@@ -0,0 +1,441 @@
+#if !(defined MPLR_COROUTINE_HPP)
+
+#define MPLR_COROUTINE_HPP
+
+#include "mplr/mplr.hpp"
+
+#if !(defined __cpp_impl_coroutine)
+#error "mplr/coroutine.hpp requires a compiler with C++20 coroutine support"
+#endif
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace mplr {
+
+  class request_scheduler;
+
+  namespace detail {
+
+    // a suspended coroutine waiting for one or several requests
+    struct scheduled_operation {
+      std::coroutine_handle<> continuation;
+      // number of requests that still have to complete before the coroutine is resumed
+      std::size_t remaining{0};
+      // index of the completed request for coroutines that wait for any request of a pool
+      std::size_t index{0};
+    };
+
+  }  // namespace detail
+
+  //--------------------------------------------------------------------
+
+  /// Coroutine type for coroutines that are run by a \ref request_scheduler.  Within such a
+  /// coroutine, \c irequest and \c prequest objects may be awaited via \c co_await, which
+  /// yields the status of the completed operation, and request pools may be awaited via
+  /// \ref when_all and \ref when_any.  While a coroutine waits for pending requests, the
+  /// scheduler runs other coroutines.
+  class request_task {
+  public:
+#if (!defined MPLR_DOXYGEN_SHOULD_SKIP_THIS)
+    struct promise_type {
+      request_scheduler* scheduler{nullptr};
+      std::exception_ptr exception;
+
+      request_task get_return_object() {
+        return request_task{std::coroutine_handle<promise_type>::from_promise(*this)};
+      }
+
+      std::suspend_always initial_suspend() noexcept {
+        return {};
+      }
+
+      std::suspend_always final_suspend() noexcept {
+        return {};
+      }
+
+      void return_void() {
+      }
+
+      void unhandled_exception() {
+        exception = std::current_exception();
+      }
+    };
+#endif
+
+    /// Deleted copy constructor.
+    request_task(const request_task&) = delete;
+
+    /// Move constructor.
+    /// \param other the task to move from
+    request_task(request_task&& other) noexcept
+        : handle_{std::exchange(other.handle_, nullptr)} {
+    }
+
+    /// Deleted copy operator.
+    request_task& operator=(const request_task&) = delete;
+
+    /// Move operator.
+    /// \param other the task to move from
+    /// \return reference to the moved-to task
+    request_task& operator=(request_task&& other) noexcept {
+      if (this != &other) {
+        if (handle_)
+          handle_.destroy();
+        handle_ = std::exchange(other.handle_, nullptr);
+      }
+      return *this;
+    }
+
+    /// Destroys a task that has not been passed to a scheduler.
+    ~request_task() {
+      if (handle_)
+        handle_.destroy();
+    }
+
+  private:
+    explicit request_task(std::coroutine_handle<promise_type> handle) : handle_{handle} {
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+
+    friend class request_scheduler;
+  };
+
+  //--------------------------------------------------------------------
+
+  /// Single-threaded scheduler that runs coroutines of type \ref request_task.  The requests
+  /// all suspended coroutines wait for are tested for completion in one batch by a single
+  /// call to \c MPI_Testsome, coroutines whose requests have completed are resumed.
+  /// Coroutines that wait for any request of a pool are tested via \c MPI_Testany on their
+  /// pool, such that no further request of the pool completes unnoticed.
+  /// \note Coroutines are resumed by the thread that calls \c run or \c poll.
+  class request_scheduler {
+    struct entry {
+      // location of the request handle that is restored when the request has completed
+      MPI_Request* origin;
+      detail::scheduled_operation* operation;
+      status_t* status;
+    };
+
+    struct any_entry {
+      MPI_Request* handles;
+      int size;
+      detail::scheduled_operation* operation;
+    };
+
+    std::vector<std::coroutine_handle<request_task::promise_type>> tasks_;
+    std::vector<std::coroutine_handle<>> ready_;
+    std::vector<std::coroutine_handle<>> resuming_;
+    std::vector<entry> entries_;
+    std::vector<any_entry> any_entries_;
+    // request handles of all entries, passed to MPI_Testsome
+    std::vector<MPI_Request> handles_;
+    std::vector<int> indices_;
+    std::vector<status_t> statuses_;
+
+    // tests all pending requests, makes coroutines ready whose requests have completed
+    // \return true if any coroutine is ready to be resumed
+    bool test() {
+      if (not any_entries_.empty()) {
+        std::size_t j{0};
+        for (const auto& e : any_entries_) {
+          int index, flag;
+          MPI_Testany(e.size, e.handles, &index, &flag, MPI_STATUS_IGNORE);
+          if (flag != 0) {
+            e.operation->index = static_cast<std::size_t>(index);
+            ready_.push_back(e.operation->continuation);
+          } else
+            any_entries_[j++] = e;
+        }
+        any_entries_.resize(j);
+      }
+      if (not entries_.empty()) {
+        const int n{static_cast<int>(entries_.size())};
+        indices_.resize(n);
+        statuses_.resize(n);
+        int count;
+        MPI_Testsome(n, handles_.data(), &count, indices_.data(),
+                     detail::request_access::native(statuses_.data()));
+        if (count != MPI_UNDEFINED and count > 0) {
+          for (int i{0}; i < count; ++i) {
+            auto& e{entries_[indices_[i]]};
+            // a completed non-persistent request is null now, a completed persistent request
+            // is inactive
+            *e.origin = handles_[indices_[i]];
+            if (e.status != nullptr)
+              *e.status = statuses_[i];
+            if (--e.operation->remaining == 0)
+              ready_.push_back(e.operation->continuation);
+            e.origin = nullptr;
+          }
+          // drop completed requests
+          std::size_t j{0};
+          for (std::size_t i{0}; i < entries_.size(); ++i)
+            if (entries_[i].origin != nullptr) {
+              entries_[j] = entries_[i];
+              handles_[j] = handles_[i];
+              ++j;
+            }
+          entries_.resize(j);
+          handles_.resize(j);
+        }
+      }
+      return not ready_.empty();
+    }
+
+    // resumes all ready coroutines and removes finished coroutines
+    void resume() {
+      resuming_.swap(ready_);
+      for (auto& h : resuming_)
+        h.resume();
+      resuming_.clear();
+      std::exception_ptr exception;
+      std::size_t j{0};
+      for (std::size_t i{0}; i < tasks_.size(); ++i) {
+        auto h{tasks_[i]};
+        if (h.done()) {
+          if (h.promise().exception and not exception)
+            exception = h.promise().exception;
+          h.destroy();
+        } else
+          tasks_[j++] = h;
+      }
+      tasks_.resize(j);
+      if (exception)
+        std::rethrow_exception(exception);
+    }
+
+  public:
+    /// Creates a scheduler without any coroutines.
+    request_scheduler() = default;
+
+    /// Deleted copy constructor.
+    request_scheduler(const request_scheduler&) = delete;
+
+    /// Deleted copy operator.
+    request_scheduler& operator=(const request_scheduler&) = delete;
+
+    /// Destroys all coroutines that have not finished yet.
+    ~request_scheduler() {
+      entries_.clear();
+      any_entries_.clear();
+      for (auto h : tasks_)
+        h.destroy();
+    }
+
+    /// Passes a coroutine to the scheduler.  The coroutine starts running when \c run or
+    /// \c poll is called next.
+    /// \param task the coroutine
+    void spawn(request_task task) {
+      auto h{std::exchange(task.handle_, nullptr)};
+      h.promise().scheduler = this;
+      tasks_.push_back(h);
+      ready_.push_back(h);
+    }
+
+    /// \return number of coroutines that have not finished yet
+    [[nodiscard]] std::size_t size() const {
+      return tasks_.size();
+    }
+
+    /// \return true if all coroutines have finished
+    [[nodiscard]] bool empty() const {
+      return tasks_.empty();
+    }
+
+    /// Runs the coroutines that are ready and tests once for completion of the requests the
+    /// other coroutines wait for.
+    /// \return true if not all coroutines have finished
+    /// \note An exception that escapes from a coroutine is rethrown after the coroutine has
+    /// been destroyed.
+    bool poll() {
+      if (test())
+        resume();
+      return not tasks_.empty();
+    }
+
+    /// Runs all coroutines until they have finished.
+    /// \note An exception that escapes from a coroutine is rethrown after the coroutine has
+    /// been destroyed.
+    void run() {
+      run(busy_wait{});
+    }
+
+    /// Runs all coroutines until they have finished, the thread behaves as given by a wait
+    /// policy while all coroutines wait for pending requests.
+    /// \tparam P type of the wait policy, see \c irequest::wait
+    /// \param policy the wait policy
+    /// \note An exception that escapes from a coroutine is rethrown after the coroutine has
+    /// been destroyed.
+    template<typename P, typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+    void run(const P& policy) {
+      resume();
+      while (not tasks_.empty()) {
+        auto waiter{policy.make_waiter()};
+        while (true) {
+          waiter.polling_loop_begin();
+          if (test())
+            break;
+          waiter.polling_loop_end();
+        }
+        waiter.completed();
+        resume();
+      }
+    }
+
+#if (!defined MPLR_DOXYGEN_SHOULD_SKIP_THIS)
+    void add(detail::scheduled_operation& operation, MPI_Request& request, status_t* status) {
+      ++operation.remaining;
+      entries_.push_back({&request, &operation, status});
+      handles_.push_back(request);
+    }
+
+    void add_any(detail::scheduled_operation& operation, std::vector<MPI_Request>& requests) {
+      operation.remaining = 1;
+      any_entries_.push_back({requests.data(), static_cast<int>(requests.size()), &operation});
+    }
+#endif
+  };
+
+  //--------------------------------------------------------------------
+
+  namespace detail {
+
+    template<typename T>
+    class request_awaiter {
+      mplr::impl::base_request<T>& request_;
+      status_t status_;
+      scheduled_operation operation_;
+
+    public:
+      explicit request_awaiter(mplr::impl::base_request<T>& request) : request_{request} {
+      }
+
+      bool await_ready() {
+        int flag;
+        MPI_Test(&request_access::handle(request_), &flag, request_access::native(&status_));
+        return flag != 0;
+      }
+
+      void await_suspend(std::coroutine_handle<request_task::promise_type> h) {
+        operation_.continuation = h;
+        h.promise().scheduler->add(operation_, request_access::handle(request_), &status_);
+      }
+
+      status_t await_resume() {
+        request_access::release_resources(request_);
+        return status_;
+      }
+    };
+
+    template<typename T, bool any>
+    class pool_awaiter {
+      mplr::impl::request_pool<T>& pool_;
+      scheduled_operation operation_;
+      std::pair<test_result, std::size_t> result_{test_result::completed, 0};
+
+    public:
+      explicit pool_awaiter(mplr::impl::request_pool<T>& pool) : pool_{pool} {
+      }
+
+      bool await_ready() {
+        auto& handles{request_access::handles(pool_)};
+        int flag;
+        if constexpr (any) {
+          int index;
+          MPI_Testany(static_cast<int>(handles.size()), handles.data(), &index, &flag,
+                      MPI_STATUS_IGNORE);
+          if (flag != 0) {
+            if (index == MPI_UNDEFINED)
+              result_ = {test_result::no_active_requests, handles.size()};
+            else
+              result_ = {test_result::completed, static_cast<std::size_t>(index)};
+          }
+        } else
+          MPI_Testall(static_cast<int>(handles.size()), handles.data(), &flag,
+                      MPI_STATUSES_IGNORE);
+        return flag != 0;
+      }
+
+      void await_suspend(std::coroutine_handle<request_task::promise_type> h) {
+        auto& handles{request_access::handles(pool_)};
+        operation_.continuation = h;
+        if constexpr (any)
+          h.promise().scheduler->add_any(operation_, handles);
+        else
+          for (auto& handle : handles)
+            if (handle != MPI_REQUEST_NULL)
+              h.promise().scheduler->add(operation_, handle, nullptr);
+      }
+
+      auto await_resume() {
+        if constexpr (any) {
+          if (operation_.continuation)
+            result_ = {test_result::completed, operation_.index};
+          if (result_.first == test_result::completed)
+            request_access::release_resources(pool_, result_.second);
+          return result_;
+        } else
+          request_access::release_resources(pool_);
+      }
+    };
+
+  }  // namespace detail
+
+  //--------------------------------------------------------------------
+
+  /// Waits within a \ref request_task coroutine for the completion of a non-blocking
+  /// operation.
+  /// \param request the request to wait for
+  /// \return awaitable object, awaiting yields the operation's status after completion
+  inline auto operator co_await(irequest& request) {
+    return detail::request_awaiter<impl::base_irequest>{request};
+  }
+
+  /// Waits within a \ref request_task coroutine for the completion of a non-blocking
+  /// operation.
+  /// \param request the request to wait for
+  /// \return awaitable object, awaiting yields the operation's status after completion
+  inline auto operator co_await(irequest&& request) {
+    return detail::request_awaiter<impl::base_irequest>{request};
+  }
+
+  /// Waits within a \ref request_task coroutine for the completion of a started persistent
+  /// operation.
+  /// \param request the request to wait for
+  /// \return awaitable object, awaiting yields the operation's status after completion
+  inline auto operator co_await(prequest& request) {
+    return detail::request_awaiter<impl::base_prequest>{request};
+  }
+
+  /// Waits within a \ref request_task coroutine for the completion of all pending requests
+  /// of a pool.
+  /// \tparam T type of the requests in the pool
+  /// \param pool the request pool, must not be modified while the coroutine is suspended
+  /// \return awaitable object
+  template<typename T>
+  auto when_all(impl::request_pool<T>& pool) {
+    return detail::pool_awaiter<T, false>{pool};
+  }
+
+  /// Waits within a \ref request_task coroutine for the completion of any pending request
+  /// of a pool.
+  /// \tparam T type of the requests in the pool
+  /// \param pool the request pool, must not be modified while the coroutine is suspended
+  /// \return awaitable object, awaiting yields a pair containing the outcome of the wait
+  /// operation and an index to the completed request if there was any pending request, see
+  /// \c irequest_pool::waitany
+  template<typename T>
+  auto when_any(impl::request_pool<T>& pool) {
+    return detail::pool_awaiter<T, true>{pool};
+  }
+
+}  // namespace mplr
+
+#endif
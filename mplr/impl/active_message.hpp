@@ -0,0 +1,280 @@
+#if !(defined MPLR_ACTIVE_MESSAGE_HPP)
+
+#define MPLR_ACTIVE_MESSAGE_HPP
+
+#include "mplr/impl/comm_group.hpp"
+#include "mplr/impl/error.hpp"
+#include "mplr/impl/layout.hpp"
+#include "mplr/impl/operator.hpp"
+#include "mplr/impl/wait_policy.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace mplr {
+
+  /// Dispatches messages of different kinds, which any process may send to any process at
+  /// any time, to handlers that are registered per tag.  Incoming messages are matched via
+  /// matching probes in batches and are received directly into a buffer that is owned by the
+  /// handler of the message's tag and reused for all messages of this tag.  The dispatcher
+  /// detects global termination, i.e., the state in which all processes wait for messages
+  /// and all sent messages have been handled.
+  /// \note The dispatcher communicates via duplicates of the communicator given at
+  /// construction, thus its messages never interfere with other messages.  Consecutive calls
+  /// of \c run alternate between two duplicates, such that messages which are sent after a
+  /// process has detected termination are not handled by another process that is still
+  /// finishing the previous exchange.  Handlers may send further messages via the dispatcher
+  /// but must not call \c poll or \c run.
+  class active_message_dispatcher {
+    using counter_type = unsigned long long;
+
+    // receives a matched message into the buffer of the handler and invokes the handler
+    using dispatch_function = std::function<void(message_t&, const status_t&)>;
+
+    struct pending_send {
+      std::shared_ptr<void> buffer;
+      irequest request;
+    };
+
+    std::array<communicator, 2> comms_;
+    // number of completed exchanges, selects the communicator of the current exchange
+    std::size_t epoch_{0};
+    std::size_t batch_size_;
+    std::unordered_map<int, dispatch_function> handlers_;
+    std::vector<pending_send> pending_;
+    // numbers of messages sent and handled by this process
+    std::array<counter_type, 2> counts_{0, 0};
+    // termination is detected by waves of non-blocking reductions over the message counts,
+    // the exchange has terminated when two consecutive waves yield the same sums and all sent
+    // messages have been handled
+    std::array<counter_type, 2> wave_counts_{0, 0};
+    std::array<counter_type, 2> wave_sums_{0, 0};
+    std::optional<std::array<counter_type, 2>> last_wave_sums_;
+    std::optional<irequest> wave_;
+
+    [[nodiscard]] const communicator& comm() const {
+      return comms_[epoch_ % 2];
+    }
+
+    template<typename T>
+    void send_buffer(std::shared_ptr<std::vector<T>> buffer, int destination, tag_t t) {
+#if defined MPLR_DEBUG
+      if (destination < 0 or destination >= comm().size())
+        throw invalid_rank();
+#endif
+      const vector_layout<T> l(buffer->size());
+      auto request{comm().isend(buffer->data(), l, destination, t)};
+      pending_.push_back({std::move(buffer), std::move(request)});
+      ++counts_[0];
+    }
+
+    // frees the buffers of completed sends
+    void reclaim() {
+      auto completed{std::partition(pending_.begin(), pending_.end(), [](pending_send& send) {
+        return not send.request.test().has_value();
+      })};
+      pending_.erase(completed, pending_.end());
+    }
+
+    // receives a matched message without handling it, such that its send operation
+    // completes, the message counts as handled for the termination detection
+    void discard(message_t& m, const status_t& s) {
+      std::vector<char> buffer(s.template get_count<char>());
+      const vector_layout<char> l(buffer.size());
+      comm().mrecv(buffer.data(), l, m);
+      ++counts_[1];
+    }
+
+    // advances the termination detection, returns true if global termination was detected
+    bool terminated() {
+      if (wave_) {
+        if (not wave_->test())
+          return false;
+        wave_.reset();
+        if (wave_sums_[0] == wave_sums_[1] and last_wave_sums_ == wave_sums_) {
+          last_wave_sums_.reset();
+          return true;
+        }
+        last_wave_sums_ = wave_sums_;
+      }
+      wave_counts_ = counts_;
+      wave_ = comm().iallreduce(plus<counter_type>(), wave_counts_.data(), wave_sums_.data(),
+                                contiguous_layout<counter_type>(wave_counts_.size()));
+      return false;
+    }
+
+  public:
+    /// Creates a dispatcher without any handlers.
+    /// \param comm communicator whose processes exchange messages via the dispatcher
+    /// \param batch_size maximal number of messages that are handled by a single call to
+    /// \c poll
+    /// \note This is a collective operation that needs to be carried out by all processes of
+    /// the communicator \c comm.
+    explicit active_message_dispatcher(const communicator& comm, std::size_t batch_size = 64)
+        : comms_{communicator{comm, info{}}, communicator{comm, info{}}},
+          batch_size_{std::max<std::size_t>(batch_size, 1)} {
+    }
+
+    active_message_dispatcher(const active_message_dispatcher&) = delete;
+    active_message_dispatcher& operator=(const active_message_dispatcher&) = delete;
+
+    /// Waits until all sends have finished.
+    ~active_message_dispatcher() {
+      for (auto& send : pending_)
+        send.request.wait();
+    }
+
+    /// Registers a handler for messages with a given tag, replaces a previously registered
+    /// handler for this tag.
+    /// \tparam T type of the message data, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \tparam F type of the handler, must be invocable with arguments of the types
+    /// <tt>const std::vector<T>&</tt> and <tt>const status_t&</tt>
+    /// \param t tag of the messages to handle
+    /// \param handler handler that is invoked with the received data and the status of the
+    /// receive operation for each message with tag \c t
+    /// \note The vector that is passed to the handler is reused for the next message with the
+    /// same tag, the data must be copied or moved out if it is needed after the handler has
+    /// returned.
+    template<typename T, typename F>
+    void on(tag_t t, F&& handler) {
+      static_assert(std::is_invocable_v<F&, const std::vector<T>&, const status_t&>,
+                    "handler must be invocable with the received data and a status");
+      handlers_[static_cast<int>(t)] =
+          [this, buffer = std::vector<T>{},
+           handler = std::decay_t<F>(std::forward<F>(handler))](
+              message_t& m, const status_t& s) mutable {
+            const int count{s.template get_count<T>()};
+#if defined MPLR_DEBUG
+            if (count == MPI_UNDEFINED) {
+              discard(m, s);
+              throw invalid_count();
+            }
+#endif
+            buffer.resize(count);
+            const vector_layout<T> l(buffer.size());
+            comm().mrecv(buffer.data(), l, m);
+            ++counts_[1];
+            handler(static_cast<const std::vector<T>&>(buffer), s);
+          };
+    }
+
+    /// Removes the handler for messages with a given tag.
+    /// \param t tag of the messages
+    void remove(tag_t t) {
+      handlers_.erase(static_cast<int>(t));
+    }
+
+    /// Sends a message.  The data is copied or moved into an internal buffer, the function
+    /// returns without waiting for the send operation to finish.
+    /// \tparam T type of the message data, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param data data to send, the handler at the destination must expect messages with
+    /// elements of type \c T
+    /// \param destination rank of the receiving process
+    /// \param t tag of the message, selects the handler at the destination
+    template<typename T, typename A>
+    void send(std::vector<T, A> data, int destination, tag_t t) {
+      if constexpr (std::is_same_v<A, std::allocator<T>>)
+        send_buffer(std::make_shared<std::vector<T>>(std::move(data)), destination, t);
+      else
+        send_buffer(std::make_shared<std::vector<T>>(data.begin(), data.end()), destination, t);
+    }
+
+    /// Sends a message with a single element.  The data is copied into an internal buffer,
+    /// the function returns without waiting for the send operation to finish.
+    /// \tparam T type of the message data, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param data data to send, the handler at the destination must expect messages with
+    /// elements of type \c T
+    /// \param destination rank of the receiving process
+    /// \param t tag of the message, selects the handler at the destination
+    template<typename T>
+    void send(const T& data, int destination, tag_t t) {
+      send_buffer(std::make_shared<std::vector<T>>(1, data), destination, t);
+    }
+
+    /// Receives pending messages and invokes their handlers, frees the buffers of finished
+    /// sends.
+    /// \return number of handled messages, at most the batch size given at construction
+    /// \throw invalid_tag if no handler has been registered for the tag of a pending message,
+    /// the message is discarded
+    std::size_t poll() {
+      reclaim();
+      std::size_t handled{0};
+      while (handled < batch_size_) {
+        auto probed{comm().improbe(any_source, tag_t::any())};
+        if (not probed)
+          break;
+        const auto handler{handlers_.find(static_cast<int>(probed->status.tag()))};
+        if (handler == handlers_.end()) {
+          discard(probed->message, probed->status);
+          throw invalid_tag();
+        }
+        handler->second(probed->message, probed->status);
+        ++handled;
+      }
+      return handled;
+    }
+
+    /// Handles incoming messages until global termination has been detected, i.e., until all
+    /// processes have called \c run and all messages have been handled.
+    /// \note This is a collective operation that needs to be carried out by all processes of
+    /// the communicator.
+    void run() {
+      run(busy_wait{});
+    }
+
+    /// Handles incoming messages until global termination has been detected, i.e., until all
+    /// processes have called \c run and all messages have been handled.  The thread behaves
+    /// as given by a wait policy while no message arrives.
+    /// \tparam P type of the wait policy, see \c irequest::wait
+    /// \param policy the wait policy
+    /// \note This is a collective operation that needs to be carried out by all processes of
+    /// the communicator.
+    template<typename P, typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+    void run(const P& policy) {
+      bool done{false};
+      while (not done) {
+        auto waiter{policy.make_waiter()};
+        while (true) {
+          waiter.polling_loop_begin();
+          if (poll() > 0)
+            break;
+          if (terminated()) {
+            done = true;
+            break;
+          }
+          waiter.polling_loop_end();
+        }
+        waiter.completed();
+      }
+      for (auto& send : pending_)
+        send.request.wait();
+      pending_.clear();
+      ++epoch_;
+    }
+
+    /// \return number of messages that have been sent by this process
+    [[nodiscard]] counter_type sent() const {
+      return counts_[0];
+    }
+
+    /// \return number of messages that have been handled by this process
+    [[nodiscard]] counter_type handled() const {
+      return counts_[1];
+    }
+  };
+
+}  // namespace mplr
+
+#endif
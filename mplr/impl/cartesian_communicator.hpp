@@ -432,6 +432,7 @@ namespace mplr {
                                     bool reorder = true) {
       MPI_Cart_create(other.comm_, dims.dims_.size(), dims.dims_.data(), dims.periodic_.data(),
                       reorder, &comm_);
+      update_descriptor();
     }
 
     /// Creates a new communicator with Cartesian process topology by partitioning a
@@ -448,6 +449,7 @@ namespace mplr {
         throw invalid_size();
 #endif
       MPI_Cart_sub(other.comm_, reinterpret_cast<const int*>(is_included.data()), &comm_);
+      update_descriptor();
     }
 
     /// Move-constructs a communicator.
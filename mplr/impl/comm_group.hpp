@@ -5,11 +5,20 @@
 #include "mplr/impl/command_line.hpp"
 #include "mplr/impl/info.hpp"
 #include "mplr/impl/layout.hpp"
+#include "mplr/impl/progress_engine.hpp"
 #include "mplr/impl/vector.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
-#include <thread>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 
 namespace mplr {
@@ -38,6 +47,22 @@ namespace mplr {
 
   //--------------------------------------------------------------------
 
+  /// Selects how a sparse all-to-all exchange is carried out.
+  enum class sparse_schedule {
+    /// point-to-point messages if each process exchanges data with a few processes only, a
+    /// single collective operation otherwise, requires an additional reduction to agree on
+    /// the schedule
+    automatic,
+    /// non-blocking point-to-point messages to and from the processes with an entry in the
+    /// sparse layouts, the work is proportional to the number of entries
+    point_to_point,
+    /// a single collective all-to-all operation over all processes of the communicator, the
+    /// work is proportional to the number of processes
+    collective
+  };
+
+  //--------------------------------------------------------------------
+
   /// Represents a group of processes.
   class group {
     MPI_Group gr_{MPI_GROUP_EMPTY};
@@ -266,6 +291,112 @@ namespace mplr {
     friend class communicator;
   };
 
+  namespace detail {
+
+    // count and displacement arrays of the variable-size collectives for containers, kept
+    // per thread such that repeated calls do not allocate
+    struct v_collective_scratch {
+      // count that marks a block whose size cannot be passed as an int value, it is exchanged
+      // in place of the actual size such that all processes reject the operation consistently
+      static constexpr int oversized{-1};
+
+      std::vector<int> send_counts;
+      std::vector<int> send_displs;
+      std::vector<MPI_Datatype> send_types;
+      std::vector<int> recv_counts;
+      std::vector<int> recv_displs;
+      std::vector<MPI_Datatype> recv_types;
+
+      template<typename C>
+      static int count(const C& container) {
+        return fits_int_count(container.size()) ? static_cast<int>(container.size())
+                                                : oversized;
+      }
+
+      static bool has_oversized(const std::vector<int>& counts) {
+        return std::find(counts.begin(), counts.end(), oversized) != counts.end();
+      }
+
+      // sets displs to the offsets of consecutive blocks of the given sizes and returns the
+      // total number of elements, returns nothing if a block is oversized or if an offset
+      // cannot be passed as an int value
+      static std::optional<std::size_t> displacements(const std::vector<int>& counts,
+                                                      std::vector<int>& displs) {
+        displs.resize(counts.size());
+        std::size_t total{0};
+        for (std::size_t i{0}; i < counts.size(); ++i) {
+          if (counts[i] == oversized or not fits_int_count(total))
+            return std::nullopt;
+          displs[i] = static_cast<int>(total);
+          total += static_cast<std::size_t>(counts[i]);
+        }
+        return total;
+      }
+
+      // sets the byte displacements and data types of consecutive blocks of the given sizes
+      // for MPI_Alltoallw and returns the total number of elements, a block whose byte
+      // displacement cannot be passed as an int value is placed via a new data type, which is
+      // stored in displaced_types
+      static std::size_t alltoallw_blocks(const std::vector<int>& counts, MPI_Datatype type,
+                                          MPI_Aint extent, std::vector<int>& displs,
+                                          std::vector<MPI_Datatype>& types,
+                                          std::vector<shared_datatype>& displaced_types) {
+        displs.assign(counts.size(), 0);
+        types.assign(counts.size(), type);
+        std::size_t total{0};
+        for (std::size_t i{0}; i < counts.size(); ++i) {
+          MPI_Aint displ{static_cast<MPI_Aint>(total) * extent};
+          total += static_cast<std::size_t>(counts[i]);
+          if (fits_int_count(displ)) {
+            displs[i] = static_cast<int>(displ);
+            continue;
+          }
+          MPI_Datatype displaced_type;
+          MPI_Type_create_hindexed_block(1, 1, &displ, type, &displaced_type);
+          displaced_types.push_back(shared_datatype::commit(displaced_type));
+          types[i] = displaced_types.back().get();
+        }
+        return total;
+      }
+
+      static v_collective_scratch& this_thread() {
+        thread_local v_collective_scratch scratch;
+        return scratch;
+      }
+    };
+
+
+    // contiguous staging buffers of the variable-size collectives for containers, kept per
+    // thread and element type, buffers beyond a size limit are released after each call such
+    // that a single large exchange does not pin its memory for the lifetime of the thread
+    template<typename T>
+    struct v_collective_staging {
+      static constexpr std::size_t max_retained_bytes{std::size_t{1} << 20};
+
+      std::vector<T> send;
+      std::vector<T> recv;
+
+      template<typename V>
+      void pack(const V& blocks) {
+        send.clear();
+        for (const auto& block : blocks)
+          send.insert(send.end(), block.begin(), block.end());
+      }
+
+      void trim() {
+        for (auto* buffer : {&send, &recv})
+          if (buffer->capacity() > max_retained_bytes / sizeof(T))
+            std::vector<T>().swap(*buffer);
+      }
+
+      static v_collective_staging& this_thread() {
+        thread_local v_collective_staging staging;
+        return staging;
+      }
+    };
+
+  }  // namespace detail
+
   //--------------------------------------------------------------------
 
   namespace impl {
@@ -279,11 +410,348 @@ namespace mplr {
         int tag{MPI_ANY_TAG};
       };
 
-      struct isend_irecv_state {
-        MPI_Request req{};
-        isend_irecv_request_state* request_state{nullptr};
+      using isend_function = int (*)(const void*, int, MPI_Datatype, int, int, MPI_Comm,
+                                     MPI_Request*);
+
+      // large non-contiguous STL containers are sent and received without a serialized copy
+      // via an iterator layout if their elements are stored in runs that are long enough to
+      // amortize the datatype processing of the MPI library, i.e., in the chunks of a
+      // std::deque or in large nodes of node-based containers
+      static constexpr std::size_t zero_copy_min_bytes{std::size_t{1} << 24};
+      static constexpr std::size_t zero_copy_min_run_bytes{256};
+
+      template<typename T>
+      static constexpr bool is_zero_copy_sendable_v =
+          std::is_same_v<typename T::value_type,
+                         detail::remove_const_from_members_t<typename T::value_type>> and
+          std::is_lvalue_reference_v<decltype(*std::declval<typename T::const_iterator>())> and
+          (std::is_base_of_v<
+               std::random_access_iterator_tag,
+               typename std::iterator_traits<typename T::const_iterator>::iterator_category> or
+           sizeof(typename T::value_type) >= zero_copy_min_run_bytes);
+
+      // receiving requires resizing the container and assigning to its elements
+      template<typename T>
+      static constexpr bool is_zero_copy_receivable_v =
+          is_zero_copy_sendable_v<T> and detail::has_resize_v<T> and
+          not std::is_const_v<std::remove_reference_t<decltype(*std::declval<T&>().begin())>>;
+
+      template<typename T>
+      static bool use_zero_copy(std::size_t size) {
+        return size * sizeof(typename T::value_type) >= zero_copy_min_bytes;
+      }
+
+      // replaces the contents of an STL container by the values of a range, existing nodes
+      // and capacity of the container are reused, the nodes of sorted containers are
+      // re-inserted at the end, which takes amortized constant time per element if the
+      // values are given in the container's order
+      template<typename T, typename IterT>
+      static void assign_container(T& data, IterT first, IterT last) {
+        if constexpr (detail::has_extract_v<T>) {
+          T old_data;
+          old_data.swap(data);
+          if constexpr (detail::has_reserve_v<T>)
+            data.reserve(std::distance(first, last));
+          for (; first != last; ++first) {
+            if (old_data.empty()) {
+              data.emplace_hint(data.end(), *first);
+            } else {
+              auto node{old_data.extract(old_data.begin())};
+              if constexpr (detail::has_mapped_type_v<T>) {
+                node.key() = first->first;
+                node.mapped() = first->second;
+              } else
+                node.value() = *first;
+              data.insert(data.end(), std::move(node));
+            }
+          }
+        } else
+          data.assign(first, last);
+      }
+
+      // sends a serialized copy of a non-contiguous STL container, the generalized request
+      // is completed by the progress engine as soon as the underlying send has finished
+      template<typename T>
+      class isend_task final : public detail::progress_task {
+        detail::vector<T> buffer_;
+        MPI_Request req_{MPI_REQUEST_NULL};
+        MPI_Request greq_{MPI_REQUEST_NULL};
+        isend_irecv_request_state* request_state_{nullptr};
+
+      public:
+        template<typename IterT>
+        isend_task(std::size_t size, IterT iter) : buffer_(size, iter) {
+        }
+
+        bool progress(detail::progress_sweep&) override {
+          int flag;
+          MPI_Status s;
+          MPI_Test(&req_, &flag, &s);
+          if (flag == 0)
+            return false;
+          request_state_->source = s.MPI_SOURCE;
+          request_state_->tag = s.MPI_TAG;
+          request_state_->datatype = detail::datatype_traits<T>::get_datatype();
+          request_state_->count = 0;
+          MPI_Grequest_complete(greq_);
+          return true;
+        }
+
+        friend class base_communicator;
+      };
+
+      // receives an STL container, the message is matched via MPI_Improbe and received via
+      // MPI_Imrecv, both are polled by the progress engine
+      template<typename T, typename C>
+      class irecv_task final : public detail::progress_task {
+        using value_type = detail::remove_const_from_members_t<typename T::value_type>;
+
+        T& data_;
+        MPI_Comm comm_;
+        int source_;
+        int tag_;
+        bool matched_{false};
+        int count_{0};
+        std::optional<detail::vector<value_type>> buffer_;
+        MPI_Request req_{MPI_REQUEST_NULL};
+        MPI_Request greq_{MPI_REQUEST_NULL};
+        isend_irecv_request_state* request_state_{nullptr};
+
+      public:
+        irecv_task(T& data, MPI_Comm comm, int source, int tag)
+            : data_{data}, comm_{comm}, source_{source}, tag_{tag} {
+        }
+
+        bool progress(detail::progress_sweep& sweep) override {
+          const MPI_Datatype datatype{detail::datatype_traits<value_type>::get_datatype()};
+          if (not matched_) {
+            if (sweep.is_blocked(comm_, source_, tag_))
+              return false;
+            int flag;
+            MPI_Message message;
+            MPI_Status s;
+            MPI_Improbe(source_, tag_, comm_, &flag, &message, &s);
+            if (flag == 0) {
+              sweep.add_unmatched(comm_, source_, tag_);
+              return false;
+            }
+            matched_ = true;
+            MPI_Get_count(&s, datatype, &count_);
+            if constexpr (std::is_base_of_v<detail::contiguous_stl_container, C>) {
+              if constexpr (detail::has_resize_v<T>)
+                data_.resize(count_);
+              MPI_Imrecv(data_.size() > 0 ? &data_[0] : nullptr, count_, datatype, &message,
+                         &req_);
+            } else {
+              bool in_place{false};
+              if constexpr (is_zero_copy_receivable_v<T>) {
+                in_place = use_zero_copy<T>(count_);
+                if (in_place) {
+                  data_.resize(count_);
+                  const iterator_layout<value_type> l(std::begin(data_), std::end(data_));
+                  MPI_Imrecv(&*std::begin(data_), 1,
+                             detail::datatype_traits<layout<value_type>>::get_datatype(l),
+                             &message, &req_);
+                }
+              }
+              if (not in_place) {
+                buffer_.emplace(count_, detail::uninitialized{});
+                MPI_Imrecv(buffer_->data(), count_, datatype, &message, &req_);
+              }
+            }
+          }
+          int flag;
+          MPI_Status s;
+          MPI_Test(&req_, &flag, &s);
+          if (flag == 0)
+            return false;
+          if constexpr (not std::is_base_of_v<detail::contiguous_stl_container, C>) {
+            if (buffer_)
+              assign_container(data_, buffer_->begin(), buffer_->end());
+          }
+          request_state_->source = s.MPI_SOURCE;
+          request_state_->tag = s.MPI_TAG;
+          request_state_->datatype = datatype;
+          request_state_->count = count_;
+          MPI_Grequest_complete(greq_);
+          return true;
+        }
+
+        friend class base_communicator;
+      };
+
+      // hands a task over to the progress engine and returns the generalized request that
+      // represents it
+      template<typename Task>
+      static MPI_Request submit_task(std::unique_ptr<Task> task) {
+        task->request_state_ = new isend_irecv_request_state();
+        MPI_Grequest_start(isend_irecv_query, isend_irecv_free, isend_irecv_cancel,
+                           task->request_state_, &task->greq_);
+        const MPI_Request req{task->greq_};
+        detail::progress_engine::instance().submit(std::move(task));
+        return req;
+      }
+
+      class partitioned_task;
+
+      // emulates partitioned communication, which requires MPI 4.0, each partition is
+      // transferred as a message of its own, partitions are sent in the order of their indices
+      // as soon as all partitions with lower indices are ready, thus, messages match the
+      // receives, which are posted in the same order
+      class partitioned_schedule final
+          : public detail::persistent_schedule,
+            public std::enable_shared_from_this<partitioned_schedule> {
+        char* data_;
+        int partitions_;
+        MPI_Datatype datatype_{MPI_DATATYPE_NULL};
+        MPI_Aint extent_{0};
+        int peer_;
+        int tag_;
+        MPI_Comm comm_;
+        bool is_send_;
+        std::vector<MPI_Request> requests_;
+        // partitions that are ready to be sent or that have arrived
+        std::vector<std::atomic<bool>> done_;
+        // number of partitions whose sends have been posted
+        int posted_{0};
+        std::mutex mutex_;
+
+        void post_ready_sends() {
+          for (; posted_ < partitions_ and done_[posted_]; ++posted_)
+            MPI_Isend(data_ + posted_ * extent_, 1, datatype_, peer_, tag_, comm_,
+                      &requests_[posted_]);
+        }
+
+      public:
+        partitioned_schedule(const void* data, int partitions, MPI_Datatype datatype, int peer,
+                             int tag, MPI_Comm comm, bool is_send)
+            : data_{static_cast<char*>(const_cast<void*>(data))},
+              partitions_{partitions},
+              peer_{peer},
+              tag_{tag},
+              comm_{comm},
+              is_send_{is_send},
+              requests_(partitions, MPI_REQUEST_NULL),
+              done_(partitions) {
+          MPI_Aint lb;
+          MPI_Type_dup(datatype, &datatype_);
+          MPI_Type_get_extent(datatype_, &lb, &extent_);
+        }
+
+        ~partitioned_schedule() override {
+          MPI_Type_free(&datatype_);
+        }
+
+        MPI_Request start() override {
+          {
+            std::lock_guard<std::mutex> lock{mutex_};
+            for (auto& done : done_)
+              done = false;
+            posted_ = 0;
+            if (not is_send_) {
+              for (; posted_ < partitions_; ++posted_)
+                MPI_Irecv(data_ + posted_ * extent_, 1, datatype_, peer_, tag_, comm_,
+                          &requests_[posted_]);
+            }
+          }
+          return submit_task(std::make_unique<partitioned_task>(shared_from_this()));
+        }
+
+        void pready(int partition) override {
+          std::lock_guard<std::mutex> lock{mutex_};
+          done_[partition] = true;
+          post_ready_sends();
+        }
+
+        bool parrived(int partition) override {
+          return done_[partition];
+        }
+
+        // tests for completion of the transfers, called by the progress engine only
+        bool progress() {
+          std::lock_guard<std::mutex> lock{mutex_};
+          if (is_send_) {
+            if (posted_ < partitions_)
+              return false;
+            int flag;
+            MPI_Testall(partitions_, requests_.data(), &flag, MPI_STATUSES_IGNORE);
+            return flag != 0;
+          }
+          bool all_arrived{true};
+          for (int i{0}; i < partitions_; ++i) {
+            if (done_[i])
+              continue;
+            int flag;
+            MPI_Test(&requests_[i], &flag, MPI_STATUS_IGNORE);
+            if (flag != 0)
+              done_[i] = true;
+            else
+              all_arrived = false;
+          }
+          return all_arrived;
+        }
+
+        friend class partitioned_task;
+      };
+
+      // completes the generalized request of a started partitioned_schedule
+      class partitioned_task final : public detail::progress_task {
+        std::shared_ptr<partitioned_schedule> schedule_;
+        MPI_Request greq_{MPI_REQUEST_NULL};
+        isend_irecv_request_state* request_state_{nullptr};
+
+      public:
+        explicit partitioned_task(std::shared_ptr<partitioned_schedule> schedule)
+            : schedule_{std::move(schedule)} {
+        }
+
+        bool progress(detail::progress_sweep&) override {
+          if (not schedule_->progress())
+            return false;
+          request_state_->source = schedule_->is_send_ ? MPI_UNDEFINED : schedule_->peer_;
+          request_state_->tag = schedule_->is_send_ ? MPI_UNDEFINED : schedule_->tag_;
+          request_state_->datatype = schedule_->datatype_;
+          request_state_->count = schedule_->is_send_ ? 0 : schedule_->partitions_;
+          MPI_Grequest_complete(greq_);
+          return true;
+        }
+
+        friend class base_communicator;
       };
 
+      template<typename T>
+      base_irequest isend_container(const T& data, int destination, tag_t t,
+                                    isend_function isend_fn,
+                                    detail::contiguous_const_stl_container) const {
+        using value_type = typename T::value_type;
+        MPI_Request req;
+        isend_fn(data.size() > 0 ? &data[0] : nullptr, static_cast<int>(data.size()),
+                 detail::datatype_traits<value_type>::get_datatype(), destination,
+                 static_cast<int>(t), comm_, &req);
+        return base_irequest{req};
+      }
+
+      template<typename T>
+      base_irequest isend_container(const T& data, int destination, tag_t t,
+                                    isend_function isend_fn, detail::stl_container) const {
+        using value_type = detail::remove_const_from_members_t<typename T::value_type>;
+        if constexpr (is_zero_copy_sendable_v<T>) {
+          if (use_zero_copy<T>(data.size())) {
+            const iterator_layout<value_type> l(std::begin(data), std::end(data));
+            MPI_Request req;
+            isend_fn(&*std::begin(data), 1,
+                     detail::datatype_traits<layout<value_type>>::get_datatype(l), destination,
+                     static_cast<int>(t), comm_, &req);
+            return base_irequest{req};
+          }
+        }
+        auto task{std::make_unique<isend_task<value_type>>(data.size(), std::begin(data))};
+        isend_fn(task->buffer_.data(), static_cast<int>(task->buffer_.size()),
+                 detail::datatype_traits<value_type>::get_datatype(), destination,
+                 static_cast<int>(t), comm_, &task->req_);
+        return base_irequest{submit_task(std::move(task))};
+      }
+
       static int isend_irecv_query(void* state, MPI_Status* s) {
         auto* request_state{static_cast<isend_irecv_request_state*>(state)};
         MPI_Status_set_elements(s, request_state->datatype, request_state->count);
@@ -400,31 +868,93 @@ namespace mplr {
                              typename detail::datatype_traits<T>::data_type_category{});
       }
 
+      // counts and displacements of collective operations with contiguous layouts, which are
+      // passed via the large-count bindings if these are available
+#if defined MPLR_HAS_LARGE_COUNT
+      using count_type = MPI_Count;
+      using displ_type = MPI_Aint;
+#else
+      using count_type = int;
+      using displ_type = int;
+#endif
+
+      // argument arrays of a non-blocking collective operation with contiguous layouts, which
+      // must not be released before the operation has completed, owned by the operation's
+      // request
+      struct icollective_counts {
+        std::vector<count_type> sendcounts;
+        std::vector<displ_type> senddispls;
+        std::vector<count_type> recvcounts;
+        std::vector<displ_type> recvdispls;
+      };
+
+      static count_type count_as_count_type(std::size_t count) {
+#if !(defined MPLR_HAS_LARGE_COUNT)
+        if (not detail::fits_int_count(count))
+          throw invalid_count();
+#endif
+        return static_cast<count_type>(count);
+      }
+
       template<typename T>
-      std::vector<int> sizes_as_vector_of_ints(const contiguous_layouts<T>& layouts) const {
-        std::vector<int> counts;
+      std::vector<count_type> sizes_as_vector_of_counts(
+          const contiguous_layouts<T>& layouts) const {
+        std::vector<count_type> counts;
         counts.reserve(layouts.size());
-        std::transform(layouts.begin(), layouts.end(), std::back_inserter(counts),
-                       [](const auto& layout) { return static_cast<int>(layout.size()); });
+        std::transform(
+            layouts.begin(), layouts.end(), std::back_inserter(counts),
+            [](const auto& layout) { return count_as_count_type(layout.size()); });
         return counts;
       }
 
-      std::vector<int> displacements_as_vector_of_ints(const displacements& displs,
-                                                       int displ_unit = 1) const {
-        std::vector<int> displs_as_int;
-        displs_as_int.reserve(displs.size());
-        std::transform(displs.begin(), displs.end(), std::back_inserter(displs_as_int),
-                       [displ_unit](const auto& displ) {
-#if defined MPLR_DEBUG
-                         if (displ * displ_unit > std::numeric_limits<int>::max())
+      std::vector<displ_type> displacements_as_vector_of_counts(
+          const displacements& displs) const {
+        std::vector<displ_type> displs_as_count;
+        displs_as_count.reserve(displs.size());
+        std::transform(displs.begin(), displs.end(), std::back_inserter(displs_as_count),
+                       [](const auto& displ) {
+#if !(defined MPLR_HAS_LARGE_COUNT)
+                         if (not detail::fits_int_count(displ))
                            throw invalid_displacement();
 #endif
-                         return static_cast<int>(displ * displ_unit);
+                         return static_cast<displ_type>(displ);
                        });
-        return displs_as_int;
+        return displs_as_count;
       }
 
+      // properties of the communicator that do not change during its lifetime, they are
+      // determined once at construction and spare calls into the MPI library in hot paths
+      struct descriptor {
+        int size{0};
+        int rank{MPI_UNDEFINED};
+        bool is_owning{false};
+      };
+
       MPI_Comm comm_{MPI_COMM_NULL};
+      descriptor descriptor_;
+
+      // must be called whenever a new MPI communicator has been assigned to comm_, the
+      // predefined communicators are never freed, the comparisons are skipped for wrapped
+      // MPI communicators that are never owned anyway
+      void update_descriptor(bool may_own = true) {
+        descriptor_ = descriptor{};
+        if (comm_ == MPI_COMM_NULL)
+          return;
+        MPI_Comm_size(comm_, &descriptor_.size);
+        MPI_Comm_rank(comm_, &descriptor_.rank);
+        if (not may_own)
+          return;
+        int result_1;
+        MPI_Comm_compare(comm_, MPI_COMM_WORLD, &result_1);
+        int result_2;
+        MPI_Comm_compare(comm_, MPI_COMM_SELF, &result_2);
+        descriptor_.is_owning = result_1 != MPI_IDENT and result_2 != MPI_IDENT;
+      }
+
+      void free_handle() {
+        if (descriptor_.is_owning)
+          MPI_Comm_free(&comm_);
+      }
 
     public:
       /// Indicates the creation of a new communicator by an operation that is collective
@@ -458,56 +988,51 @@ namespace mplr {
     protected:
       base_communicator() = default;
       explicit base_communicator(MPI_Comm comm) : comm_(comm) {
+        update_descriptor();
+      }
+
+      // indicates the wrapping of an MPI communicator that is never freed
+      class non_owning_tag {};
+
+      explicit base_communicator(MPI_Comm comm, non_owning_tag) : comm_(comm) {
+        update_descriptor(false);
       }
 
       explicit base_communicator(const base_communicator& other, const mplr::info& info)
           : comm_{} {
         MPI_Comm_dup_with_info(other.comm_, info.info_, &comm_);
+        update_descriptor();
       }
 
-      base_communicator(base_communicator&& other) noexcept : comm_{other.comm_} {
+      base_communicator(base_communicator&& other) noexcept
+          : comm_{other.comm_}, descriptor_{other.descriptor_} {
         other.comm_ = MPI_COMM_NULL;
+        other.descriptor_ = descriptor{};
       }
 
       ~base_communicator() {
-        if (is_valid()) {
-          int result_1;
-          MPI_Comm_compare(comm_, MPI_COMM_WORLD, &result_1);
-          int result_2;
-          MPI_Comm_compare(comm_, MPI_COMM_SELF, &result_2);
-          if (result_1 != MPI_IDENT and result_2 != MPI_IDENT)
-            MPI_Comm_free(&comm_);
-        }
+        free_handle();
       }
 
       base_communicator& operator=(const base_communicator& other) = delete;
 
       base_communicator& operator=(base_communicator&& other) noexcept {
         if (this != &other) {
-          if (is_valid()) {
-            int result_1;
-            MPI_Comm_compare(comm_, MPI_COMM_WORLD, &result_1);
-            int result_2;
-            MPI_Comm_compare(comm_, MPI_COMM_SELF, &result_2);
-            if (result_1 != MPI_IDENT and result_2 != MPI_IDENT)
-              MPI_Comm_free(&comm_);
-          }
+          free_handle();
           comm_ = other.comm_;
+          descriptor_ = other.descriptor_;
           other.comm_ = MPI_COMM_NULL;
+          other.descriptor_ = descriptor{};
         }
         return *this;
       }
 
       [[nodiscard]] int size() const {
-        int result;
-        MPI_Comm_size(comm_, &result);
-        return result;
+        return descriptor_.size;
       }
 
       [[nodiscard]] int rank() const {
-        int result;
-        MPI_Comm_rank(comm_, &result);
-        return result;
+        return descriptor_.rank;
       }
 
       void info(const mplr::info& i) const {
@@ -581,6 +1106,12 @@ namespace mplr {
       template<typename T>
       void send(const T& data, int destination, tag_t t, detail::stl_container) const {
         using value_type = detail::remove_const_from_members_t<typename T::value_type>;
+        if constexpr (is_zero_copy_sendable_v<T>) {
+          if (use_zero_copy<T>(data.size())) {
+            send(std::begin(data), std::end(data), destination, t);
+            return;
+          }
+        }
         detail::vector<value_type> serial_data(data.size(), std::begin(data));
         const vector_layout<value_type> l(serial_data.size());
         send(serial_data.data(), l, destination, t);
@@ -626,8 +1157,9 @@ namespace mplr {
       void send(const T* data, const layout<T>& l, int destination, tag_t t = tag_t{0}) const {
         check_dest(destination);
         check_send_tag(t);
-        MPI_Send(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), destination,
-                 static_cast<int>(t), comm_);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Send(buffer.data, buffer.count, buffer.type, destination, static_cast<int>(t),
+                 comm_);
       }
 
       /// Sends a message with several values given by a pair of iterators via a
@@ -668,47 +1200,9 @@ namespace mplr {
         return base_irequest{req};
       }
 
-      template<typename T>
-      void isend(const T& data, int destination, tag_t t, isend_irecv_state* state,
-                 detail::contiguous_const_stl_container) const {
-        using value_type = typename T::value_type;
-        const int count(data.size());
-        MPI_Datatype datatype{detail::datatype_traits<value_type>::get_datatype()};
-        MPI_Request req;
-        MPI_Isend(data.size() > 0 ? &data[0] : nullptr, count, datatype, destination,
-                  static_cast<int>(t), comm_, &req);
-        MPI_Status s;
-        MPI_Wait(&req, &s);
-        state->request_state->source = s.MPI_SOURCE;
-        state->request_state->tag = s.MPI_TAG;
-        state->request_state->datatype = datatype;
-        state->request_state->count = 0;
-        MPI_Grequest_complete(state->req);
-        delete state;
-      }
-
-      template<typename T>
-      void isend(const T& data, int destination, tag_t t, isend_irecv_state* state,
-                 detail::stl_container) const {
-        using value_type = detail::remove_const_from_members_t<typename T::value_type>;
-        const detail::vector<value_type> serial_data(data.size(), std::begin(data));
-        isend(serial_data, destination, t, state, detail::contiguous_const_stl_container{});
-      }
-
       template<typename T, typename C>
       base_irequest isend(const T& data, int destination, tag_t t, C) const {
-        auto* request_state{new isend_irecv_request_state()};
-        MPI_Request req;
-        MPI_Grequest_start(isend_irecv_query, isend_irecv_free, isend_irecv_cancel,
-                           request_state, &req);
-        auto* send_state{new isend_irecv_state()};
-        send_state->req = req;
-        send_state->request_state = request_state;
-        std::thread thread([this, &data, destination, t, send_state]() {
-          isend(data, destination, t, send_state, C{});
-        });
-        thread.detach();
-        return base_irequest{req};
+        return isend_container(data, destination, t, MPI_Isend, C{});
       }
 
     public:
@@ -759,8 +1253,9 @@ namespace mplr {
         check_dest(destination);
         check_send_tag(t);
         MPI_Request req;
-        MPI_Isend(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), destination,
-                  static_cast<int>(t), comm_, &req);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Isend(buffer.data, buffer.count, buffer.type, destination, static_cast<int>(t),
+                  comm_, &req);
         return base_irequest{req};
       }
 
@@ -840,8 +1335,9 @@ namespace mplr {
         check_dest(destination);
         check_send_tag(t);
         MPI_Request req;
-        MPI_Send_init(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), destination,
-                      static_cast<int>(t), comm_, &req);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Send_init(buffer.data, buffer.count, buffer.type, destination, static_cast<int>(t),
+                      comm_, &req);
         return base_prequest{req};
       }
 
@@ -922,6 +1418,12 @@ namespace mplr {
       template<typename T>
       void bsend(const T& data, int destination, tag_t t, detail::stl_container) const {
         using value_type = detail::remove_const_from_members_t<typename T::value_type>;
+        if constexpr (is_zero_copy_sendable_v<T>) {
+          if (use_zero_copy<T>(data.size())) {
+            bsend(std::begin(data), std::end(data), destination, t);
+            return;
+          }
+        }
         detail::vector<value_type> serial_data(data.size(), std::begin(data));
         const vector_layout<value_type> l(serial_data.size());
         bsend(serial_data.data(), l, destination, t);
@@ -968,8 +1470,9 @@ namespace mplr {
       void bsend(const T* data, const layout<T>& l, int destination, tag_t t = tag_t{0}) const {
         check_dest(destination);
         check_send_tag(t);
-        MPI_Bsend(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), destination,
-                  static_cast<int>(t), comm_);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Bsend(buffer.data, buffer.count, buffer.type, destination, static_cast<int>(t),
+                  comm_);
       }
 
       /// Sends a message with several values given by a pair of iterators via a
@@ -1010,45 +1513,9 @@ namespace mplr {
         return base_irequest{req};
       }
 
-      template<typename T>
-      void ibsend(const T& data, int destination, tag_t t, isend_irecv_state* state,
-                  detail::contiguous_const_stl_container) const {
-        using value_type = typename T::value_type;
-        const int count(data.size());
-        MPI_Datatype datatype{detail::datatype_traits<value_type>::get_datatype()};
-        MPI_Request req;
-        MPI_Ibsend(data.size() > 0 ? &data[0] : nullptr, count, datatype, destination,
-                   static_cast<int>(t), comm_, &req);
-        MPI_Status s;
-        MPI_Wait(&req, &s);
-        state->request_state->source = s.MPI_SOURCE;
-        state->request_state->tag = s.MPI_TAG;
-        state->request_state->datatype = datatype;
-        state->request_state->count = 0;
-        MPI_Grequest_complete(state->req);
-        delete state;
-      }
-
-      template<typename T>
-      void ibsend(const T& data, int destination, tag_t t, isend_irecv_state* state,
-                  detail::stl_container) const {
-        using value_type = detail::remove_const_from_members_t<typename T::value_type>;
-        detail::vector<value_type> serial_data(data.size(), std::begin(data));
-        ibsend(serial_data, destination, t, state, detail::contiguous_const_stl_container{});
-      }
-
       template<typename T, typename C>
       irequest ibsend(const T& data, int destination, tag_t t, C) const {
-        auto* request_state{new isend_irecv_request_state()};
-        MPI_Request req;
-        MPI_Grequest_start(isend_irecv_query, isend_irecv_free, isend_irecv_cancel,
-                           request_state, &req);
-        auto* send_state{new isend_irecv_state{req, request_state}};
-        std::thread thread([this, &data, destination, t, send_state]() {
-          ibsend(data, destination, t, send_state, C{});
-        });
-        thread.detach();
-        return base_irequest{req};
+        return isend_container(data, destination, t, MPI_Ibsend, C{});
       }
 
     public:
@@ -1100,8 +1567,9 @@ namespace mplr {
         check_dest(destination);
         check_send_tag(t);
         MPI_Request req;
-        MPI_Ibsend(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), destination,
-                   static_cast<int>(t), comm_, &req);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Ibsend(buffer.data, buffer.count, buffer.type, destination, static_cast<int>(t),
+                   comm_, &req);
         return base_irequest{req};
       }
 
@@ -1181,8 +1649,9 @@ namespace mplr {
         check_dest(destination);
         check_send_tag(t);
         MPI_Request req;
-        MPI_Bsend_init(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l),
-                       destination, static_cast<int>(t), comm_, &req);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Bsend_init(buffer.data, buffer.count, buffer.type, destination, static_cast<int>(t),
+                       comm_, &req);
         return base_prequest{req};
       }
 
@@ -1235,6 +1704,12 @@ namespace mplr {
       template<typename T>
       void ssend(const T& data, int destination, tag_t t, detail::stl_container) const {
         using value_type = detail::remove_const_from_members_t<typename T::value_type>;
+        if constexpr (is_zero_copy_sendable_v<T>) {
+          if (use_zero_copy<T>(data.size())) {
+            ssend(std::begin(data), std::end(data), destination, t);
+            return;
+          }
+        }
         detail::vector<value_type> serial_data(data.size(), std::begin(data));
         const vector_layout<value_type> l(serial_data.size());
         ssend(serial_data.data(), l, destination, t);
@@ -1279,8 +1754,9 @@ namespace mplr {
       void ssend(const T* data, const layout<T>& l, int destination, tag_t t = tag_t{0}) const {
         check_dest(destination);
         check_send_tag(t);
-        MPI_Ssend(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), destination,
-                  static_cast<int>(t), comm_);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Ssend(buffer.data, buffer.count, buffer.type, destination, static_cast<int>(t),
+                  comm_);
       }
 
       /// Sends a message with several values given by a pair of iterators via a
@@ -1321,45 +1797,9 @@ namespace mplr {
         return base_irequest{req};
       }
 
-      template<typename T>
-      void issend(const T& data, int destination, tag_t t, isend_irecv_state* state,
-                  detail::contiguous_const_stl_container) const {
-        using value_type = typename T::value_type;
-        const int count(data.size());
-        MPI_Datatype datatype{detail::datatype_traits<value_type>::get_datatype()};
-        MPI_Request req;
-        MPI_Issend(data.size() > 0 ? &data[0] : nullptr, count, datatype, destination,
-                   static_cast<int>(t), comm_, &req);
-        MPI_Status s;
-        MPI_Wait(&req, &s);
-        state->request_state->source = s.MPI_SOURCE;
-        state->request_state->tag = s.MPI_TAG;
-        state->request_state->datatype = datatype;
-        state->request_state->count = 0;
-        MPI_Grequest_complete(state->req);
-        delete state;
-      }
-
-      template<typename T>
-      void issend(const T& data, int destination, tag_t t, isend_irecv_state* state,
-                  detail::stl_container) const {
-        using value_type = detail::remove_const_from_members_t<typename T::value_type>;
-        detail::vector<value_type> serial_data(data.size(), std::begin(data));
-        issend(serial_data, destination, t, state, detail::contiguous_const_stl_container{});
-      }
-
       template<typename T, typename C>
       irequest issend(const T& data, int destination, tag_t t, C) const {
-        auto* request_state{new isend_irecv_request_state()};
-        MPI_Request req;
-        MPI_Grequest_start(isend_irecv_query, isend_irecv_free, isend_irecv_cancel,
-                           request_state, &req);
-        auto* send_state{new isend_irecv_state{req, request_state}};
-        std::thread thread([this, &data, destination, t, send_state]() {
-          issend(data, destination, t, send_state, C{});
-        });
-        thread.detach();
-        return base_irequest{req};
+        return isend_container(data, destination, t, MPI_Issend, C{});
       }
 
     public:
@@ -1411,8 +1851,9 @@ namespace mplr {
         check_dest(destination);
         check_send_tag(t);
         MPI_Request req;
-        MPI_Issend(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), destination,
-                   static_cast<int>(t), comm_, &req);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Issend(buffer.data, buffer.count, buffer.type, destination, static_cast<int>(t),
+                   comm_, &req);
         return base_irequest{req};
       }
 
@@ -1492,8 +1933,9 @@ namespace mplr {
         check_dest(destination);
         check_send_tag(t);
         MPI_Request req;
-        MPI_Ssend_init(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l),
-                       destination, static_cast<int>(t), comm_, &req);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Ssend_init(buffer.data, buffer.count, buffer.type, destination, static_cast<int>(t),
+                       comm_, &req);
         return base_prequest{req};
       }
 
@@ -1546,6 +1988,12 @@ namespace mplr {
       template<typename T>
       void rsend(const T& data, int destination, tag_t t, detail::stl_container) const {
         using value_type = detail::remove_const_from_members_t<typename T::value_type>;
+        if constexpr (is_zero_copy_sendable_v<T>) {
+          if (use_zero_copy<T>(data.size())) {
+            rsend(std::begin(data), std::end(data), destination, t);
+            return;
+          }
+        }
         detail::vector<value_type> serial_data(data.size(), std::begin(data));
         const vector_layout<value_type> l(serial_data.size());
         rsend(serial_data.data(), l, destination, t);
@@ -1591,8 +2039,9 @@ namespace mplr {
       void rsend(const T* data, const layout<T>& l, int destination, tag_t t = tag_t{0}) const {
         check_dest(destination);
         check_send_tag(t);
-        MPI_Rsend(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), destination,
-                  static_cast<int>(t), comm_);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Rsend(buffer.data, buffer.count, buffer.type, destination, static_cast<int>(t),
+                  comm_);
       }
 
       /// Sends a message with several values given by a pair of iterators via a
@@ -1633,45 +2082,9 @@ namespace mplr {
         return base_irequest{req};
       }
 
-      template<typename T>
-      void irsend(const T& data, int destination, tag_t t, isend_irecv_state* state,
-                  detail::contiguous_const_stl_container) const {
-        using value_type = typename T::value_type;
-        const int count(data.size());
-        MPI_Datatype datatype{detail::datatype_traits<value_type>::get_datatype()};
-        MPI_Request req;
-        MPI_Irsend(data.size() > 0 ? &data[0] : nullptr, count, datatype, destination,
-                   static_cast<int>(t), comm_, &req);
-        MPI_Status s;
-        MPI_Wait(&req, &s);
-        state->request_state->source = s.MPI_SOURCE;
-        state->request_state->tag = s.MPI_TAG;
-        state->request_state->datatype = datatype;
-        state->request_state->count = 0;
-        MPI_Grequest_complete(state->req);
-        delete state;
-      }
-
-      template<typename T>
-      void irsend(const T& data, int destination, tag_t t, isend_irecv_state* state,
-                  detail::stl_container) const {
-        using value_type = detail::remove_const_from_members_t<typename T::value_type>;
-        detail::vector<value_type> serial_data(data.size(), std::begin(data));
-        irsend(serial_data, destination, t, state, detail::contiguous_const_stl_container{});
-      }
-
       template<typename T, typename C>
       irequest irsend(const T& data, int destination, tag_t t, C) const {
-        auto* request_state{new isend_irecv_request_state()};
-        MPI_Request req;
-        MPI_Grequest_start(isend_irecv_query, isend_irecv_free, isend_irecv_cancel,
-                           request_state, &req);
-        auto* send_state{new isend_irecv_state{req, request_state}};
-        std::thread thread([this, &data, destination, t, send_state]() {
-          irsend(data, destination, t, send_state, C{});
-        });
-        thread.detach();
-        return base_irequest{req};
+        return isend_container(data, destination, t, MPI_Irsend, C{});
       }
 
     public:
@@ -1722,8 +2135,9 @@ namespace mplr {
         check_dest(destination);
         check_send_tag(t);
         MPI_Request req;
-        MPI_Irsend(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), destination,
-                   static_cast<int>(t), comm_, &req);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Irsend(buffer.data, buffer.count, buffer.type, destination, static_cast<int>(t),
+                   comm_, &req);
         return base_irequest{req};
       }
 
@@ -1803,8 +2217,9 @@ namespace mplr {
         check_dest(destination);
         check_send_tag(t);
         MPI_Request req;
-        MPI_Rsend_init(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l),
-                       destination, static_cast<int>(t), comm_, &req);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Rsend_init(buffer.data, buffer.count, buffer.type, destination, static_cast<int>(t),
+                       comm_, &req);
         return base_prequest{req};
       }
 
@@ -1874,11 +2289,20 @@ namespace mplr {
         int count{0};
         MPI_Get_count(ps, detail::datatype_traits<value_type>::get_datatype(), &count);
         check_count(count);
+        if constexpr (is_zero_copy_receivable_v<T>) {
+          if (use_zero_copy<T>(count)) {
+            data.resize(count);
+            const iterator_layout<value_type> l(std::begin(data), std::end(data));
+            MPI_Mrecv(&*std::begin(data), 1,
+                      detail::datatype_traits<layout<value_type>>::get_datatype(l), &message,
+                      ps);
+            return s;
+          }
+        }
         detail::vector<value_type> serial_data(count, detail::uninitialized{});
         MPI_Mrecv(serial_data.data(), count,
                   detail::datatype_traits<value_type>::get_datatype(), &message, ps);
-        T new_data(serial_data.begin(), serial_data.end());
-        data.swap(new_data);
+        assign_container(data, serial_data.begin(), serial_data.end());
         return s;
       }
 
@@ -1929,8 +2353,9 @@ namespace mplr {
         check_source(source);
         check_recv_tag(t);
         status_t s;
-        MPI_Recv(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), source,
-                 static_cast<int>(t), comm_, static_cast<MPI_Status*>(&s));
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Recv(buffer.data, buffer.count, buffer.type, source, static_cast<int>(t), comm_,
+                 static_cast<MPI_Status*>(&s));
         return s;
       }
 
@@ -1971,31 +2396,10 @@ namespace mplr {
         return base_irequest{req};
       }
 
-      template<typename T>
-      void irecv(T& data, int source, tag_t t, isend_irecv_state* state,
-                 detail::stl_container) const {
-        using value_type = detail::remove_const_from_members_t<typename T::value_type>;
-        const status_t s{recv(data, source, t)};
-        state->request_state->source = s.source();
-        state->request_state->tag = static_cast<int>(s.tag());
-        state->request_state->datatype = detail::datatype_traits<value_type>::get_datatype();
-        state->request_state->count = s.get_count<value_type>();
-        MPI_Grequest_complete(state->req);
-        delete state;
-      }
-
       template<typename T, typename C>
       irequest irecv(T& data, int source, tag_t t, C) const {
-        auto* request_state{new isend_irecv_request_state()};
-        MPI_Request req;
-        MPI_Grequest_start(isend_irecv_query, isend_irecv_free, isend_irecv_cancel,
-                           request_state, &req);
-        auto* recv_state{new isend_irecv_state{req, request_state}};
-        std::thread thread([this, &data, source, t, recv_state]() {
-          irecv(data, source, t, recv_state, C{});
-        });
-        thread.detach();
-        return base_irequest{req};
+        return base_irequest{submit_task(
+            std::make_unique<irecv_task<T, C>>(data, comm_, source, static_cast<int>(t)))};
       }
 
     public:
@@ -2044,8 +2448,9 @@ namespace mplr {
         check_source(source);
         check_recv_tag(t);
         MPI_Request req;
-        MPI_Irecv(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), source,
-                  static_cast<int>(t), comm_, &req);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Irecv(buffer.data, buffer.count, buffer.type, source, static_cast<int>(t), comm_,
+                  &req);
         return base_irequest{req};
       }
 
@@ -2124,8 +2529,9 @@ namespace mplr {
         check_source(source);
         check_recv_tag(t);
         MPI_Request req;
-        MPI_Recv_init(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), source,
-                      static_cast<int>(t), comm_, &req);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Recv_init(buffer.data, buffer.count, buffer.type, source, static_cast<int>(t),
+                      comm_, &req);
         return base_prequest{req};
       }
 
@@ -2155,6 +2561,72 @@ namespace mplr {
         }
       }
 
+      // === partitioned communication ===
+      /// Creates a persistent communication request to send a message, which is split into
+      /// partitions that may become ready for transfer independently of each other, e.g.,
+      /// because they are filled by different threads.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param data pointer to the data to send
+      /// \param partitions number of partitions
+      /// \param l memory layout of a single partition, the i-th partition starts i times the
+      /// extent of the layout after the address given in \c data
+      /// \param destination rank of the receiving process
+      /// \param t tag associated to this message
+      /// \return persistent communication request, partitions are marked as ready via
+      /// \c prequest::pready after the request has been started
+      /// \note Partitioned communication requires MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PARTITIONED_COMMUNICATION is not defined, each partition is sent as a
+      /// message of its own as soon as it and all partitions with lower indices are ready.  In
+      /// this case, the tag must not be used by other messages between the two processes while
+      /// the request is active.
+      template<typename T>
+      prequest psend_init(const T* data, int partitions, const layout<T>& l, int destination,
+                          tag_t t = tag_t{0}) const {
+        check_dest(destination);
+        check_send_tag(t);
+        const MPI_Datatype type{detail::datatype_traits<layout<T>>::get_datatype(l)};
+#if defined MPLR_HAS_PARTITIONED_COMMUNICATION
+        MPI_Request req;
+        MPI_Psend_init(data, partitions, 1, type, destination, static_cast<int>(t), comm_,
+                       MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return base_prequest{std::make_shared<partitioned_schedule>(
+            data, partitions, type, destination, static_cast<int>(t), comm_, true)};
+#endif
+      }
+
+      /// Creates a persistent communication request to receive a message, which is split into
+      /// partitions that may be accessed as soon as they have arrived.
+      /// \tparam T type of the data to receive, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param data pointer to the data to receive
+      /// \param partitions number of partitions
+      /// \param l memory layout of a single partition, the i-th partition starts i times the
+      /// extent of the layout after the address given in \c data
+      /// \param source rank of the sending process, must not be <tt>\ref any_source</tt>
+      /// \param t tag associated to this message, must not be \c tag_t::any
+      /// \return persistent communication request, the arrival of single partitions may be
+      /// tested via \c prequest::parrived after the request has been started
+      /// \note See \c psend_init for the emulation of partitioned communication.
+      template<typename T>
+      prequest precv_init(T* data, int partitions, const layout<T>& l, int source,
+                          tag_t t = tag_t{0}) const {
+        check_source(source);
+        check_recv_tag(t);
+        const MPI_Datatype type{detail::datatype_traits<layout<T>>::get_datatype(l)};
+#if defined MPLR_HAS_PARTITIONED_COMMUNICATION
+        MPI_Request req;
+        MPI_Precv_init(data, partitions, 1, type, source, static_cast<int>(t), comm_,
+                       MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return base_prequest{std::make_shared<partitioned_schedule>(
+            data, partitions, type, source, static_cast<int>(t), comm_, false)};
+#endif
+      }
+
       // === probe ===
       // --- blocking probe ---
       /// Blocking test for an incoming message.
@@ -2257,8 +2729,8 @@ namespace mplr {
       template<typename T>
       status_t mrecv(T* data, const layout<T>& l, message_t& m) const {
         status_t s;
-        MPI_Mrecv(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), &m,
-                  static_cast<MPI_Status*>(&s));
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Mrecv(buffer.data, buffer.count, buffer.type, &m, static_cast<MPI_Status*>(&s));
         return s;
       }
 
@@ -2323,7 +2795,8 @@ namespace mplr {
       template<typename T>
       irequest imrecv(T* data, const layout<T>& l, message_t& m) const {
         MPI_Request req;
-        MPI_Imrecv(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), &m, &req);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Imrecv(buffer.data, buffer.count, buffer.type, &m, &req);
         return base_irequest{req};
       }
 
@@ -2402,10 +2875,12 @@ namespace mplr {
         check_send_tag(send_tag);
         check_recv_tag(recv_tag);
         status_t s;
-        MPI_Sendrecv(send_data, 1, detail::datatype_traits<layout<T>>::get_datatype(sendl),
-                     destination, static_cast<int>(send_tag), recv_data, 1,
-                     detail::datatype_traits<layout<T>>::get_datatype(recvl), source,
-                     static_cast<int>(recv_tag), comm_, static_cast<MPI_Status*>(&s));
+        const auto send_buffer{detail::make_layout_buffer(send_data, sendl)};
+        const auto recv_buffer{detail::make_layout_buffer(recv_data, recvl)};
+        MPI_Sendrecv(send_buffer.data, send_buffer.count, send_buffer.type, destination,
+                     static_cast<int>(send_tag), recv_buffer.data, recv_buffer.count,
+                     recv_buffer.type, source, static_cast<int>(recv_tag), comm_,
+                     static_cast<MPI_Status*>(&s));
         return s;
       }
 
@@ -2500,9 +2975,10 @@ namespace mplr {
         check_send_tag(send_tag);
         check_recv_tag(recv_tag);
         status_t s;
-        MPI_Sendrecv_replace(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l),
-                             destination, static_cast<int>(send_tag), source,
-                             static_cast<int>(recv_tag), comm_, static_cast<MPI_Status*>(&s));
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Sendrecv_replace(buffer.data, buffer.count, buffer.type, destination,
+                             static_cast<int>(send_tag), source, static_cast<int>(recv_tag),
+                             comm_, static_cast<MPI_Status*>(&s));
         return s;
       }
 
@@ -2543,6 +3019,17 @@ namespace mplr {
         MPI_Barrier(comm_);
       }
 
+      /// Blocks until all processes in the communicator have reached this method, the waiting
+      /// thread behaves as given by a wait policy.
+      /// \tparam P type of the wait policy, see \c irequest::wait
+      /// \param policy the wait policy
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.
+      template<typename P, typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+      void barrier(const P& policy) const {
+        ibarrier().wait(policy);
+      }
+
       // --- non-blocking barrier ---
       /// Notifies the process that it has reached the barrier and returns immediately.
       /// \return communication request
@@ -2554,6 +3041,27 @@ namespace mplr {
         return base_irequest{req};
       }
 
+      // --- persistent barrier ---
+      /// Creates a persistent request for a barrier.
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      [[nodiscard]] prequest barrier_init() const {
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Barrier_init(comm_, MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule([comm{comm_}]() {
+          MPI_Request req;
+          MPI_Ibarrier(comm, &req);
+          return req;
+        });
+#endif
+      }
+
       // === broadcast ===
       // --- blocking broadcast ---
       /// Broadcasts a message from a process to all other processes.
@@ -2580,26 +3088,59 @@ namespace mplr {
       template<typename T>
       void bcast(int root_rank, T* data, const layout<T>& l) const {
         check_root(root_rank);
-        MPI_Bcast(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), root_rank,
-                  comm_);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Bcast(buffer.data, buffer.count, buffer.type, root_rank, comm_);
       }
 
-      // --- non-blocking broadcast ---
-      /// Broadcasts a message from a process to all other processes in a non-blocking
-      /// manner.
+      /// Broadcasts a message from a process to all other processes, the waiting thread
+      /// behaves as given by a wait policy.
       /// \tparam T type of the data to send, must meet the requirements as described in the
       /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \tparam P type of the wait policy, see \c irequest::wait
       /// \param root_rank rank of the sending process
       /// \param data buffer for sending/receiving data
-      /// \return request representing the ongoing message transfer
+      /// \param policy the wait policy
       /// \note This is a collective operation and must be called by all processes in the
       /// communicator.
-      template<typename T>
-      irequest ibcast(int root_rank, T& data) const {
-        check_root(root_rank);
-        MPI_Request req;
-        MPI_Ibcast(&data, 1, detail::datatype_traits<T>::get_datatype(), root_rank, comm_,
-                   &req);
+      template<typename T, typename P,
+               typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+      void bcast(int root_rank, T& data, const P& policy) const {
+        ibcast(root_rank, data).wait(policy);
+      }
+
+      /// Broadcasts a message from a process to all other processes, the waiting thread
+      /// behaves as given by a wait policy.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \tparam P type of the wait policy, see \c irequest::wait
+      /// \param root_rank rank of the sending process
+      /// \param data buffer for sending/receiving data
+      /// \param l memory layout of the data to send/receive
+      /// \param policy the wait policy
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.
+      template<typename T, typename P,
+               typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+      void bcast(int root_rank, T* data, const layout<T>& l, const P& policy) const {
+        ibcast(root_rank, data, l).wait(policy);
+      }
+
+      // --- non-blocking broadcast ---
+      /// Broadcasts a message from a process to all other processes in a non-blocking
+      /// manner.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the sending process
+      /// \param data buffer for sending/receiving data
+      /// \return request representing the ongoing message transfer
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.
+      template<typename T>
+      irequest ibcast(int root_rank, T& data) const {
+        check_root(root_rank);
+        MPI_Request req;
+        MPI_Ibcast(&data, 1, detail::datatype_traits<T>::get_datatype(), root_rank, comm_,
+                   &req);
         return base_irequest{req};
       }
 
@@ -2617,11 +3158,70 @@ namespace mplr {
       irequest ibcast(int root_rank, T* data, const layout<T>& l) const {
         check_root(root_rank);
         MPI_Request req;
-        MPI_Ibcast(data, 1, detail::datatype_traits<layout<T>>::get_datatype(l), root_rank,
-                   comm_, &req);
+        const auto buffer{detail::make_layout_buffer(data, l)};
+        MPI_Ibcast(buffer.data, buffer.count, buffer.type, root_rank, comm_, &req);
         return base_irequest{req};
       }
 
+      // --- persistent broadcast ---
+      /// Creates a persistent request for broadcasting a message from a process to all other
+      /// processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the sending process
+      /// \param data buffer for sending/receiving data
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest bcast_init(int root_rank, T& data) const {
+        check_root(root_rank);
+        const MPI_Datatype type{detail::datatype_traits<T>::get_datatype()};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Bcast_init(&data, 1, type, root_rank, comm_, MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule([&data, type, root_rank, comm{comm_}]() {
+          MPI_Request req;
+          MPI_Ibcast(&data, 1, type, root_rank, comm, &req);
+          return req;
+        });
+#endif
+      }
+
+      /// Creates a persistent request for broadcasting a message from a process to all other
+      /// processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the sending process
+      /// \param data buffer for sending/receiving data
+      /// \param l memory layout of the data to send/receive, must not be destroyed before the
+      /// request
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest bcast_init(int root_rank, T* data, const layout<T>& l) const {
+        check_root(root_rank);
+        const MPI_Datatype type{detail::datatype_traits<layout<T>>::get_datatype(l)};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Bcast_init(data, 1, type, root_rank, comm_, MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule([data, type, root_rank, comm{comm_}]() {
+          MPI_Request req;
+          MPI_Ibcast(data, 1, type, root_rank, comm, &req);
+          return req;
+        });
+#endif
+      }
+
       // === gather ===
       // === root gets a single value from each rank and stores in contiguous memory
       // --- blocking gather ---
@@ -2706,6 +3306,77 @@ namespace mplr {
         return base_irequest{req};
       }
 
+      // --- persistent gather ---
+      /// Creates a persistent request for gathering messages from all processes at a single
+      /// root process.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the receiving process
+      /// \param send_data data to send
+      /// \param recv_data pointer to continuous storage for incoming messages, may be a null
+      /// pointer at non-root processes
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest gather_init(int root_rank, const T& send_data, T* recv_data) const {
+        check_root(root_rank);
+        const MPI_Datatype type{detail::datatype_traits<T>::get_datatype()};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Gather_init(&send_data, 1, type, recv_data, 1, type, root_rank, comm_,
+                        MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule([&send_data, recv_data, type, root_rank, comm{comm_}]() {
+          MPI_Request req;
+          MPI_Igather(&send_data, 1, type, recv_data, 1, type, root_rank, comm, &req);
+          return req;
+        });
+#endif
+      }
+
+      /// Creates a persistent request for gathering messages from all processes at a single
+      /// root process.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the receiving process
+      /// \param send_data data buffer for sending data
+      /// \param sendl memory layout of the data to send, must not be destroyed before the
+      /// request
+      /// \param recv_data pointer to continuous storage for incoming messages, may be a null
+      /// pointer at non-root processes
+      /// \param recvl memory layout of the data to receive, must not be destroyed before the
+      /// request
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest gather_init(int root_rank, const T* send_data,
+                                         const layout<T>& sendl, T* recv_data,
+                                         const layout<T>& recvl) const {
+        check_root(root_rank);
+        const MPI_Datatype sendtype{detail::datatype_traits<layout<T>>::get_datatype(sendl)};
+        const MPI_Datatype recvtype{detail::datatype_traits<layout<T>>::get_datatype(recvl)};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Gather_init(send_data, 1, sendtype, recv_data, 1, recvtype, root_rank, comm_,
+                        MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule(
+            [send_data, sendtype, recv_data, recvtype, root_rank, comm{comm_}]() {
+              MPI_Request req;
+              MPI_Igather(send_data, 1, sendtype, recv_data, 1, recvtype, root_rank, comm, &req);
+              return req;
+            });
+#endif
+      }
+
       // --- blocking gather, non-root variant ---
       /// Gather messages from all processes at a single root process.
       /// \tparam T type of the data to send, must meet the requirements as described in the
@@ -2839,6 +3510,13 @@ namespace mplr {
       /// \param recvdispls displacements of the data to receive by the root rank
       /// \note This is a collective operation and must be called (possibly by utilizing another
       /// overload) by all processes in the communicator.
+      /// \throw invalid_count if a count does not fit into an int value and MPI provides no
+      /// large-count functions
+      /// \throw invalid_displacement if a displacement does not fit into an int value and MPI
+      /// provides no large-count functions
+      /// \note Without the large-count functions of MPI 4.0, all counts and displacements must
+      /// fit into int values.  As only the process that holds a larger value throws, such data
+      /// must be exchanged via the overloads for \c layouts.
       template<typename T>
       void gatherv(int root_rank, const T* send_data, const contiguous_layout<T>& sendl,
                    T* recv_data, const contiguous_layouts<T>& recvls,
@@ -2846,11 +3524,19 @@ namespace mplr {
         check_root(root_rank);
         check_size(recvls);
         check_size(recvdispls);
-        const auto recvcounts{sizes_as_vector_of_ints(recvls)};
-        const auto reacvdispls_int(displacements_as_vector_of_ints(recvdispls));
-        MPI_Gatherv(send_data, sendl.size(), detail::datatype_traits<T>::get_datatype(),
-                    recv_data, recvcounts.data(), reacvdispls_int.data(),
-                    detail::datatype_traits<T>::get_datatype(), root_rank, comm_);
+        const auto recvcounts{sizes_as_vector_of_counts(recvls)};
+        const auto recvdispls_as_count{displacements_as_vector_of_counts(recvdispls)};
+#if defined MPLR_HAS_LARGE_COUNT
+        MPI_Gatherv_c(send_data, count_as_count_type(sendl.size()),
+                      detail::datatype_traits<T>::get_datatype(), recv_data, recvcounts.data(),
+                      recvdispls_as_count.data(), detail::datatype_traits<T>::get_datatype(),
+                      root_rank, comm_);
+#else
+        MPI_Gatherv(send_data, count_as_count_type(sendl.size()),
+                    detail::datatype_traits<T>::get_datatype(), recv_data, recvcounts.data(),
+                    recvdispls_as_count.data(), detail::datatype_traits<T>::get_datatype(),
+                    root_rank, comm_);
+#endif
       }
 
       // --- non-blocking gather ---
@@ -2918,6 +3604,13 @@ namespace mplr {
       /// \return request representing the ongoing message transfer
       /// \note This is a collective operation and must be called (possibly by utilizing another
       /// overload) by all processes in the communicator.
+      /// \throw invalid_count if a count does not fit into an int value and MPI provides no
+      /// large-count functions
+      /// \throw invalid_displacement if a displacement does not fit into an int value and MPI
+      /// provides no large-count functions
+      /// \note Without the large-count functions of MPI 4.0, all counts and displacements must
+      /// fit into int values.  As only the process that holds a larger value throws, such data
+      /// must be exchanged via the overloads for \c layouts.
       template<typename T>
       irequest igatherv(int root_rank, const T* send_data, const contiguous_layout<T>& sendl,
                         T* recv_data, const contiguous_layouts<T>& recvls,
@@ -2925,13 +3618,81 @@ namespace mplr {
         check_root(root_rank);
         check_size(recvls);
         check_size(recvdispls);
-        const auto recvcounts{sizes_as_vector_of_ints(recvls)};
-        const auto recvdispls_int(displacements_as_vector_of_ints(recvdispls));
+        auto counts{std::make_shared<icollective_counts>()};
+        counts->recvcounts = sizes_as_vector_of_counts(recvls);
+        counts->recvdispls = displacements_as_vector_of_counts(recvdispls);
         MPI_Request req;
-        MPI_Igatherv(send_data, sendl.size(), detail::datatype_traits<T>::get_datatype(),
-                     recv_data, recvcounts.data(), recvdispls_int.data(),
+#if defined MPLR_HAS_LARGE_COUNT
+        MPI_Igatherv_c(send_data, count_as_count_type(sendl.size()),
+                       detail::datatype_traits<T>::get_datatype(), recv_data,
+                       counts->recvcounts.data(), counts->recvdispls.data(),
+                       detail::datatype_traits<T>::get_datatype(), root_rank, comm_, &req);
+#else
+        MPI_Igatherv(send_data, count_as_count_type(sendl.size()),
+                     detail::datatype_traits<T>::get_datatype(), recv_data,
+                     counts->recvcounts.data(), counts->recvdispls.data(),
                      detail::datatype_traits<T>::get_datatype(), root_rank, comm_, &req);
-        return base_irequest{req};
+#endif
+        return base_irequest{req, std::move(counts)};
+      }
+
+      // --- persistent gather ---
+      /// Creates a persistent request for gathering messages with a variable amount of data
+      /// from all processes at a single root process.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the receiving process
+      /// \param send_data data to send
+      /// \param sendl memory layout of the data to send
+      /// \param recv_data pointer to continuous storage for incoming messages, may be a null
+      /// pointer at non-root processes
+      /// \param recvls memory layouts of the data to receive by the root rank, must not be
+      /// destroyed before the request
+      /// \param recvdispls displacements of the data to receive by the root rank
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest gatherv_init(int root_rank, const T* send_data,
+                                          const layout<T>& sendl, T* recv_data,
+                                          const layouts<T>& recvls,
+                                          const displacements& recvdispls) const {
+        check_root(root_rank);
+        check_size(recvls);
+        check_size(recvdispls);
+        const int n{size()};
+        auto ls{std::make_shared<internal_layouts<T>>(n)};
+        ls->sendls[root_rank] = sendl;
+        const auto& sendls{ls->sendls};
+        const auto& internal_recvls{rank() == root_rank ? recvls : ls->recvls};
+        return alltoallw_init(send_data, sendls, displacements(n), recv_data, internal_recvls,
+                              recvdispls, std::move(ls));
+      }
+
+      /// Creates a persistent request for gathering messages with a variable amount of data
+      /// from all processes at a single root process.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the receiving process
+      /// \param send_data data to send
+      /// \param sendl memory layout of the data to send
+      /// \param recv_data pointer to continuous storage for incoming messages, may be a null
+      /// pointer at non-root processes
+      /// \param recvls memory layouts of the data to receive by the root rank, must not be
+      /// destroyed before the request
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest gatherv_init(int root_rank, const T* send_data,
+                                          const layout<T>& sendl, T* recv_data,
+                                          const layouts<T>& recvls) const {
+        return gatherv_init(root_rank, send_data, sendl, recv_data, recvls,
+                            displacements(size()));
       }
 
       // --- blocking gather, non-root variant ---
@@ -2966,11 +3727,23 @@ namespace mplr {
       /// \note This is a collective operation and must be called (possibly by utilizing another
       /// overload) by all processes in the communicator. This particular overload can only be
       /// called by non-root processes.
+      /// \throw invalid_count if a count does not fit into an int value and MPI provides no
+      /// large-count functions
+      /// \note Without the large-count functions of MPI 4.0, all counts and displacements must
+      /// fit into int values.  As only the process that holds a larger value throws, such data
+      /// must be exchanged via the overloads for \c layouts.
       template<typename T>
       void gatherv(int root_rank, const T* send_data, const contiguous_layout<T>& sendl) const {
         check_nonroot(root_rank);
-        MPI_Gatherv(send_data, sendl.size(), detail::datatype_traits<T>::get_datatype(),
-                    nullptr, nullptr, nullptr, MPI_DATATYPE_NULL, root_rank, comm_);
+#if defined MPLR_HAS_LARGE_COUNT
+        MPI_Gatherv_c(send_data, count_as_count_type(sendl.size()),
+                      detail::datatype_traits<T>::get_datatype(), nullptr, nullptr, nullptr,
+                      MPI_DATATYPE_NULL, root_rank, comm_);
+#else
+        MPI_Gatherv(send_data, count_as_count_type(sendl.size()),
+                    detail::datatype_traits<T>::get_datatype(), nullptr, nullptr, nullptr,
+                    MPI_DATATYPE_NULL, root_rank, comm_);
+#endif
       }
 
       // --- non-blocking gather, non-root variant ---
@@ -3007,13 +3780,25 @@ namespace mplr {
       /// \note This is a collective operation and must be called (possibly by utilizing another
       /// overload) by all processes in the communicator. This particular overload can only be
       /// called by non-root processes.
+      /// \throw invalid_count if a count does not fit into an int value and MPI provides no
+      /// large-count functions
+      /// \note Without the large-count functions of MPI 4.0, all counts and displacements must
+      /// fit into int values.  As only the process that holds a larger value throws, such data
+      /// must be exchanged via the overloads for \c layouts.
       template<typename T>
       irequest igatherv(int root_rank, const T* send_data,
                         const contiguous_layout<T>& sendl) const {
         check_nonroot(root_rank);
         MPI_Request req;
-        MPI_Igatherv(send_data, sendl.size(), detail::datatype_traits<T>::get_datatype(),
-                     nullptr, nullptr, nullptr, MPI_DATATYPE_NULL, root_rank, comm_, &req);
+#if defined MPLR_HAS_LARGE_COUNT
+        MPI_Igatherv_c(send_data, count_as_count_type(sendl.size()),
+                       detail::datatype_traits<T>::get_datatype(), nullptr, nullptr, nullptr,
+                       MPI_DATATYPE_NULL, root_rank, comm_, &req);
+#else
+        MPI_Igatherv(send_data, count_as_count_type(sendl.size()),
+                     detail::datatype_traits<T>::get_datatype(), nullptr, nullptr, nullptr,
+                     MPI_DATATYPE_NULL, root_rank, comm_, &req);
+#endif
         return base_irequest{req};
       }
 
@@ -3089,6 +3874,69 @@ namespace mplr {
         return base_irequest{req};
       }
 
+      // --- persistent allgather ---
+      /// Creates a persistent request for gathering messages from all processes and
+      /// distributing the result to all processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param send_data data to send
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest allgather_init(const T& send_data, T* recv_data) const {
+        const MPI_Datatype type{detail::datatype_traits<T>::get_datatype()};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Allgather_init(&send_data, 1, type, recv_data, 1, type, comm_, MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule([&send_data, recv_data, type, comm{comm_}]() {
+          MPI_Request req;
+          MPI_Iallgather(&send_data, 1, type, recv_data, 1, type, comm, &req);
+          return req;
+        });
+#endif
+      }
+
+      /// Creates a persistent request for gathering messages from all processes and
+      /// distributing the result to all processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param send_data data to send
+      /// \param sendl memory layout of the data to send, must not be destroyed before the
+      /// request
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \param recvl memory layout of the data to receive, must not be destroyed before the
+      /// request
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest allgather_init(const T* send_data, const layout<T>& sendl,
+                                            T* recv_data, const layout<T>& recvl) const {
+        const MPI_Datatype sendtype{detail::datatype_traits<layout<T>>::get_datatype(sendl)};
+        const MPI_Datatype recvtype{detail::datatype_traits<layout<T>>::get_datatype(recvl)};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Allgather_init(send_data, 1, sendtype, recv_data, 1, recvtype, comm_,
+                           MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule(
+            [send_data, sendtype, recv_data, recvtype, comm{comm_}]() {
+              MPI_Request req;
+              MPI_Iallgather(send_data, 1, sendtype, recv_data, 1, recvtype, comm, &req);
+              return req;
+            });
+#endif
+      }
+
       // === get varying amount of data from each rank and stores in non-contiguous memory
       // --- blocking allgather ---
       /// Gather messages with a variable amount of data from all processes and
@@ -3140,17 +3988,32 @@ namespace mplr {
       /// \param recvdispls displacements of the data to receive
       /// \note This is a collective operation and must be called (possibly by utilizing another
       /// overload) by all processes in the communicator.
+      /// \throw invalid_count if a count does not fit into an int value and MPI provides no
+      /// large-count functions
+      /// \throw invalid_displacement if a displacement does not fit into an int value and MPI
+      /// provides no large-count functions
+      /// \note Without the large-count functions of MPI 4.0, all counts and displacements must
+      /// fit into int values.  As only the process that holds a larger value throws, such data
+      /// must be exchanged via the overloads for \c layouts.
       template<typename T>
       void allgatherv(const T* send_data, const contiguous_layout<T>& sendl, T* recv_data,
                       const contiguous_layouts<T>& recvls,
                       const displacements& recvdispls) const {
         check_size(recvls);
         check_size(recvdispls);
-        const auto recvcounts{sizes_as_vector_of_ints(recvls)};
-        const auto recvdispls_int(displacements_as_vector_of_ints(recvdispls));
-        MPI_Allgatherv(send_data, sendl.size(), detail::datatype_traits<T>::get_datatype(),
-                       recv_data, recvcounts.data(), recvdispls_int.data(),
-                       detail::datatype_traits<T>::get_datatype(), comm_);
+        const auto recvcounts{sizes_as_vector_of_counts(recvls)};
+        const auto recvdispls_as_count{displacements_as_vector_of_counts(recvdispls)};
+#if defined MPLR_HAS_LARGE_COUNT
+        MPI_Allgatherv_c(send_data, count_as_count_type(sendl.size()),
+                         detail::datatype_traits<T>::get_datatype(), recv_data,
+                         recvcounts.data(), recvdispls_as_count.data(),
+                         detail::datatype_traits<T>::get_datatype(), comm_);
+#else
+        MPI_Allgatherv(send_data, count_as_count_type(sendl.size()),
+                       detail::datatype_traits<T>::get_datatype(), recv_data, recvcounts.data(),
+                       recvdispls_as_count.data(), detail::datatype_traits<T>::get_datatype(),
+                       comm_);
+#endif
       }
 
       // --- non-blocking allgather ---
@@ -3206,19 +4069,85 @@ namespace mplr {
       /// \return request representing the ongoing message transfer
       /// \note This is a collective operation and must be called (possibly by utilizing another
       /// overload) by all processes in the communicator.
+      /// \throw invalid_count if a count does not fit into an int value and MPI provides no
+      /// large-count functions
+      /// \throw invalid_displacement if a displacement does not fit into an int value and MPI
+      /// provides no large-count functions
+      /// \note Without the large-count functions of MPI 4.0, all counts and displacements must
+      /// fit into int values.  As only the process that holds a larger value throws, such data
+      /// must be exchanged via the overloads for \c layouts.
       template<typename T>
       irequest iallgatherv(const T* send_data, const contiguous_layout<T>& sendl, T* recv_data,
                            const contiguous_layouts<T>& recvls,
                            const displacements& recvdispls) const {
         check_size(recvls);
         check_size(recvdispls);
-        const auto recvcounts{sizes_as_vector_of_ints(recvls)};
-        const auto recvdispls_int(displacements_as_vector_of_ints(recvdispls));
+        auto counts{std::make_shared<icollective_counts>()};
+        counts->recvcounts = sizes_as_vector_of_counts(recvls);
+        counts->recvdispls = displacements_as_vector_of_counts(recvdispls);
         MPI_Request req;
-        MPI_Iallgatherv(send_data, sendl.size(), detail::datatype_traits<T>::get_datatype(),
-                        recv_data, recvcounts.data(), recvdispls_int.data(),
+#if defined MPLR_HAS_LARGE_COUNT
+        MPI_Iallgatherv_c(send_data, count_as_count_type(sendl.size()),
+                          detail::datatype_traits<T>::get_datatype(), recv_data,
+                          counts->recvcounts.data(), counts->recvdispls.data(),
+                          detail::datatype_traits<T>::get_datatype(), comm_, &req);
+#else
+        MPI_Iallgatherv(send_data, count_as_count_type(sendl.size()),
+                        detail::datatype_traits<T>::get_datatype(), recv_data,
+                        counts->recvcounts.data(), counts->recvdispls.data(),
                         detail::datatype_traits<T>::get_datatype(), comm_, &req);
-        return base_irequest{req};
+#endif
+        return base_irequest{req, std::move(counts)};
+      }
+
+      // --- persistent allgather ---
+      /// Creates a persistent request for gathering messages with a variable amount of data
+      /// from all processes and distributing the result to all processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param send_data data to send
+      /// \param sendl memory layout of the data to send
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \param recvls memory layouts of the data to receive, must not be destroyed before the
+      /// request
+      /// \param recvdispls displacements of the data to receive
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest allgatherv_init(const T* send_data, const layout<T>& sendl,
+                                             T* recv_data, const layouts<T>& recvls,
+                                             const displacements& recvdispls) const {
+        check_size(recvls);
+        check_size(recvdispls);
+        const int n{size()};
+        auto ls{std::make_shared<internal_layouts<T>>(n)};
+        ls->sendls = layouts<T>(n, sendl);
+        const auto& sendls{ls->sendls};
+        return alltoallw_init(send_data, sendls, displacements(n), recv_data, recvls,
+                              recvdispls, std::move(ls));
+      }
+
+      /// Creates a persistent request for gathering messages with a variable amount of data
+      /// from all processes and distributing the result to all processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param send_data data to send
+      /// \param sendl memory layout of the data to send
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \param recvls memory layouts of the data to receive, must not be destroyed before the
+      /// request
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest allgatherv_init(const T* send_data, const layout<T>& sendl,
+                                             T* recv_data, const layouts<T>& recvls) const {
+        return allgatherv_init(send_data, sendl, recv_data, recvls, displacements(size()));
       }
 
       // === scatter ===
@@ -3305,6 +4234,78 @@ namespace mplr {
         return base_irequest{req};
       }
 
+      // --- persistent scatter ---
+      /// Creates a persistent request for scattering messages from a single root process to
+      /// all processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the sending process
+      /// \param send_data pointer to continuous storage for outgoing messages, may be a null
+      /// pointer at non-root processes
+      /// \param recv_data data to receive
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest scatter_init(int root_rank, const T* send_data, T& recv_data) const {
+        check_root(root_rank);
+        const MPI_Datatype type{detail::datatype_traits<T>::get_datatype()};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Scatter_init(send_data, 1, type, &recv_data, 1, type, root_rank, comm_,
+                         MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule([send_data, &recv_data, type, root_rank, comm{comm_}]() {
+          MPI_Request req;
+          MPI_Iscatter(send_data, 1, type, &recv_data, 1, type, root_rank, comm, &req);
+          return req;
+        });
+#endif
+      }
+
+      /// Creates a persistent request for scattering messages from a single root process to
+      /// all processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the sending process
+      /// \param send_data pointer to continuous storage for outgoing messages, may be a null
+      /// pointer at non-root processes
+      /// \param sendl memory layout of the data to send, must not be destroyed before the
+      /// request
+      /// \param recv_data data to receive
+      /// \param recvl memory layout of the data to receive, must not be destroyed before the
+      /// request
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest scatter_init(int root_rank, const T* send_data,
+                                          const layout<T>& sendl, T* recv_data,
+                                          const layout<T>& recvl) const {
+        check_root(root_rank);
+        const MPI_Datatype sendtype{detail::datatype_traits<layout<T>>::get_datatype(sendl)};
+        const MPI_Datatype recvtype{detail::datatype_traits<layout<T>>::get_datatype(recvl)};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Scatter_init(send_data, 1, sendtype, recv_data, 1, recvtype, root_rank, comm_,
+                         MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule(
+            [send_data, sendtype, recv_data, recvtype, root_rank, comm{comm_}]() {
+              MPI_Request req;
+              MPI_Iscatter(send_data, 1, sendtype, recv_data, 1, recvtype, root_rank, comm,
+                           &req);
+              return req;
+            });
+#endif
+      }
+
       // --- blocking scatter, non-root variant ---
       /// Scatter messages from a single root process to all processes.
       /// \param root_rank rank of the sending process
@@ -3433,6 +4434,13 @@ namespace mplr {
       /// \param recvl memory layout of the data to receive by the root rank
       /// \note This is a collective operation and must be called (possibly by utilizing another
       /// overload) by all processes in the communicator.
+      /// \throw invalid_count if a count does not fit into an int value and MPI provides no
+      /// large-count functions
+      /// \throw invalid_displacement if a displacement does not fit into an int value and MPI
+      /// provides no large-count functions
+      /// \note Without the large-count functions of MPI 4.0, all counts and displacements must
+      /// fit into int values.  As only the process that holds a larger value throws, such data
+      /// must be exchanged via the overloads for \c layouts.
       template<typename T>
       void scatterv(int root_rank, const T* send_data, const contiguous_layouts<T>& sendls,
                     const displacements& senddispls, T* recv_data,
@@ -3440,11 +4448,19 @@ namespace mplr {
         check_root(root_rank);
         check_size(sendls);
         check_size(senddispls);
-        const auto sendcounts{sizes_as_vector_of_ints(sendls)};
-        const auto senddispls_int(displacements_as_vector_of_ints(senddispls));
-        MPI_Scatterv(send_data, sendcounts.data(), senddispls_int.data(),
-                     detail::datatype_traits<T>::get_datatype(), recv_data, recvl.size(),
+        const auto sendcounts{sizes_as_vector_of_counts(sendls)};
+        const auto senddispls_as_count{displacements_as_vector_of_counts(senddispls)};
+#if defined MPLR_HAS_LARGE_COUNT
+        MPI_Scatterv_c(send_data, sendcounts.data(), senddispls_as_count.data(),
+                       detail::datatype_traits<T>::get_datatype(), recv_data,
+                       count_as_count_type(recvl.size()),
+                       detail::datatype_traits<T>::get_datatype(), root_rank, comm_);
+#else
+        MPI_Scatterv(send_data, sendcounts.data(), senddispls_as_count.data(),
+                     detail::datatype_traits<T>::get_datatype(), recv_data,
+                     count_as_count_type(recvl.size()),
                      detail::datatype_traits<T>::get_datatype(), root_rank, comm_);
+#endif
       }
 
       // --- non-blocking scatter ---
@@ -3513,6 +4529,13 @@ namespace mplr {
       /// \return request representing the ongoing message transfer
       /// \note This is a collective operation and must be called (possibly by utilizing another
       /// overload) by all processes in the communicator.
+      /// \throw invalid_count if a count does not fit into an int value and MPI provides no
+      /// large-count functions
+      /// \throw invalid_displacement if a displacement does not fit into an int value and MPI
+      /// provides no large-count functions
+      /// \note Without the large-count functions of MPI 4.0, all counts and displacements must
+      /// fit into int values.  As only the process that holds a larger value throws, such data
+      /// must be exchanged via the overloads for \c layouts.
       template<typename T>
       irequest iscatterv(int root_rank, const T* send_data, const contiguous_layouts<T>& sendls,
                          const displacements& senddispls, T* recv_data,
@@ -3520,13 +4543,81 @@ namespace mplr {
         check_root(root_rank);
         check_size(sendls);
         check_size(senddispls);
-        const auto sendcounts{sizes_as_vector_of_ints(sendls)};
-        const auto senddispls_int(displacements_as_vector_of_ints(senddispls));
+        auto counts{std::make_shared<icollective_counts>()};
+        counts->sendcounts = sizes_as_vector_of_counts(sendls);
+        counts->senddispls = displacements_as_vector_of_counts(senddispls);
         MPI_Request req;
-        MPI_Iscatterv(send_data, sendcounts.data(), senddispls_int.data(),
-                      detail::datatype_traits<T>::get_datatype(), recv_data, recvl.size(),
+#if defined MPLR_HAS_LARGE_COUNT
+        MPI_Iscatterv_c(send_data, counts->sendcounts.data(), counts->senddispls.data(),
+                        detail::datatype_traits<T>::get_datatype(), recv_data,
+                        count_as_count_type(recvl.size()),
+                        detail::datatype_traits<T>::get_datatype(), root_rank, comm_, &req);
+#else
+        MPI_Iscatterv(send_data, counts->sendcounts.data(), counts->senddispls.data(),
+                      detail::datatype_traits<T>::get_datatype(), recv_data,
+                      count_as_count_type(recvl.size()),
                       detail::datatype_traits<T>::get_datatype(), root_rank, comm_, &req);
-        return base_irequest{req};
+#endif
+        return base_irequest{req, std::move(counts)};
+      }
+
+      // --- persistent scatter ---
+      /// Creates a persistent request for scattering messages with a variable amount of data
+      /// from a single root process to all processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the sending process
+      /// \param send_data pointer to continuous storage for outgoing messages, may be a null
+      /// pointer at non-root processes
+      /// \param sendls memory layouts of the data to send, must not be destroyed before the
+      /// request
+      /// \param senddispls displacements of the data to send by the root rank
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \param recvl memory layout of the data to receive by the root rank
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest scatterv_init(int root_rank, const T* send_data,
+                                           const layouts<T>& sendls,
+                                           const displacements& senddispls, T* recv_data,
+                                           const layout<T>& recvl) const {
+        check_root(root_rank);
+        check_size(sendls);
+        check_size(senddispls);
+        const int n{size()};
+        auto ls{std::make_shared<internal_layouts<T>>(n)};
+        ls->recvls[root_rank] = recvl;
+        const auto& internal_sendls{rank() == root_rank ? sendls : ls->sendls};
+        const auto& recvls{ls->recvls};
+        return alltoallw_init(send_data, internal_sendls, senddispls, recv_data, recvls,
+                              displacements(n), std::move(ls));
+      }
+
+      /// Creates a persistent request for scattering messages with a variable amount of data
+      /// from a single root process to all processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param root_rank rank of the sending process
+      /// \param send_data pointer to continuous storage for outgoing messages, may be a null
+      /// pointer at non-root processes
+      /// \param sendls memory layouts of the data to send, must not be destroyed before the
+      /// request
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \param recvl memory layout of the data to receive by the root rank
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest scatterv_init(int root_rank, const T* send_data,
+                                           const layouts<T>& sendls, T* recv_data,
+                                           const layout<T>& recvl) const {
+        return scatterv_init(root_rank, send_data, sendls, displacements(size()), recv_data,
+                             recvl);
       }
 
       // --- blocking scatter, non-root variant ---
@@ -3561,11 +4652,23 @@ namespace mplr {
       /// \note This is a collective operation and must be called (possibly by utilizing another
       /// overload) by all processes in the communicator. This particular overload can only be
       /// called by non-root processes.
+      /// \throw invalid_count if a count does not fit into an int value and MPI provides no
+      /// large-count functions
+      /// \note Without the large-count functions of MPI 4.0, all counts and displacements must
+      /// fit into int values.  As only the process that holds a larger value throws, such data
+      /// must be exchanged via the overloads for \c layouts.
       template<typename T>
       void scatterv(int root_rank, T* recv_data, const contiguous_layout<T>& recvl) const {
         check_root(root_rank);
-        MPI_Scatterv(nullptr, nullptr, nullptr, MPI_DATATYPE_NULL, recv_data, recvl.size(),
+#if defined MPLR_HAS_LARGE_COUNT
+        MPI_Scatterv_c(nullptr, nullptr, nullptr, MPI_DATATYPE_NULL, recv_data,
+                       count_as_count_type(recvl.size()),
+                       detail::datatype_traits<T>::get_datatype(), root_rank, comm_);
+#else
+        MPI_Scatterv(nullptr, nullptr, nullptr, MPI_DATATYPE_NULL, recv_data,
+                     count_as_count_type(recvl.size()),
                      detail::datatype_traits<T>::get_datatype(), root_rank, comm_);
+#endif
       }
 
       // --- non-blocking scatter, non-root variant ---
@@ -3602,12 +4705,24 @@ namespace mplr {
       /// \note This is a collective operation and must be called (possibly by utilizing another
       /// overload) by all processes in the communicator. This particular overload can only be
       /// called by non-root processes.
+      /// \throw invalid_count if a count does not fit into an int value and MPI provides no
+      /// large-count functions
+      /// \note Without the large-count functions of MPI 4.0, all counts and displacements must
+      /// fit into int values.  As only the process that holds a larger value throws, such data
+      /// must be exchanged via the overloads for \c layouts.
       template<typename T>
       irequest iscatterv(int root_rank, T* recv_data, const contiguous_layout<T>& recvl) const {
         check_root(root_rank);
         MPI_Request req;
-        MPI_Iscatterv(nullptr, nullptr, nullptr, MPI_DATATYPE_NULL, recv_data, recvl.size(),
+#if defined MPLR_HAS_LARGE_COUNT
+        MPI_Iscatterv_c(nullptr, nullptr, nullptr, MPI_DATATYPE_NULL, recv_data,
+                        count_as_count_type(recvl.size()),
+                        detail::datatype_traits<T>::get_datatype(), root_rank, comm_, &req);
+#else
+        MPI_Iscatterv(nullptr, nullptr, nullptr, MPI_DATATYPE_NULL, recv_data,
+                      count_as_count_type(recvl.size()),
                       detail::datatype_traits<T>::get_datatype(), root_rank, comm_, &req);
+#endif
         return base_irequest{req};
       }
 
@@ -3709,6 +4824,71 @@ namespace mplr {
         return base_irequest{req};
       }
 
+      // --- persistent all-to-all ---
+      /// Creates a persistent request for sending messages to all processes and receiving
+      /// messages from all processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param send_data pointer to continuous storage for outgoing messages
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \return persistent request
+      /// \details See \c alltoall for the arrangement of send- and receive-data.
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest alltoall_init(const T* send_data, T* recv_data) const {
+        const MPI_Datatype type{detail::datatype_traits<T>::get_datatype()};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Alltoall_init(send_data, 1, type, recv_data, 1, type, comm_, MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule([send_data, recv_data, type, comm{comm_}]() {
+          MPI_Request req;
+          MPI_Ialltoall(send_data, 1, type, recv_data, 1, type, comm, &req);
+          return req;
+        });
+#endif
+      }
+
+      /// Creates a persistent request for sending messages to all processes and receiving
+      /// messages from all processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param send_data pointer to continuous storage for outgoing messages
+      /// \param sendl memory layout of the data to send, must not be destroyed before the
+      /// request
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \param recvl memory layout of the data to receive, must not be destroyed before the
+      /// request
+      /// \return persistent request
+      /// \details See \c alltoall for the arrangement of send- and receive-data.
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest alltoall_init(const T* send_data, const layout<T>& sendl,
+                                           T* recv_data, const layout<T>& recvl) const {
+        const MPI_Datatype sendtype{detail::datatype_traits<layout<T>>::get_datatype(sendl)};
+        const MPI_Datatype recvtype{detail::datatype_traits<layout<T>>::get_datatype(recvl)};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Alltoall_init(send_data, 1, sendtype, recv_data, 1, recvtype, comm_, MPI_INFO_NULL,
+                          &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule(
+            [send_data, sendtype, recv_data, recvtype, comm{comm_}]() {
+              MPI_Request req;
+              MPI_Ialltoall(send_data, 1, sendtype, recv_data, 1, recvtype, comm, &req);
+              return req;
+            });
+#endif
+      }
+
       // === each rank sends a varying number of values to each rank with possibly different
       // layouts
       // --- blocking all-to-all ---
@@ -3742,15 +4922,13 @@ namespace mplr {
         check_size(recvdispls);
         check_size(recvls);
         const std::vector<int> counts(recvls.size(), 1);
-        const auto senddispls_int{displacements_as_vector_of_ints(senddispls, sizeof(T))};
-        const auto recvdispls_int{displacements_as_vector_of_ints(recvdispls, sizeof(T))};
-        static_assert(
-            sizeof(decltype(*sendls())) == sizeof(MPI_Datatype),
-            "compiler adds some unexpected padding, reinterpret cast will yield wrong results");
-        MPI_Alltoallw(send_data, counts.data(), senddispls_int.data(),
-                      reinterpret_cast<const MPI_Datatype*>(sendls()), recv_data, counts.data(),
-                      recvdispls_int.data(), reinterpret_cast<const MPI_Datatype*>(recvls()),
-                      comm_);
+        std::vector<int> senddispls_int, recvdispls_int;
+        std::vector<MPI_Datatype> sendtypes, recvtypes;
+        std::vector<detail::shared_datatype> displaced_types;
+        alltoallw_arguments(sendls, senddispls, senddispls_int, sendtypes, displaced_types);
+        alltoallw_arguments(recvls, recvdispls, recvdispls_int, recvtypes, displaced_types);
+        MPI_Alltoallw(send_data, counts.data(), senddispls_int.data(), sendtypes.data(),
+                      recv_data, counts.data(), recvdispls_int.data(), recvtypes.data(), comm_);
       }
 
       /// Sends messages with a variable amount of data to all processes and receives
@@ -3774,6 +4952,13 @@ namespace mplr {
       /// i-th memory block in the array \c recv_data was received from the i-th process.
       /// \note This is a collective operation and must be called (possibly by utilizing another
       /// overload) by all processes in the communicator.
+      /// \throw invalid_count if a count does not fit into an int value and MPI provides no
+      /// large-count functions
+      /// \throw invalid_displacement if a displacement does not fit into an int value and MPI
+      /// provides no large-count functions
+      /// \note Without the large-count functions of MPI 4.0, all counts and displacements must
+      /// fit into int values.  As only the process that holds a larger value throws, such data
+      /// must be exchanged via the overloads for \c layouts.
       template<typename T>
       void alltoallv(const T* send_data, const contiguous_layouts<T>& sendls,
                      const displacements& senddispls, T* recv_data,
@@ -3783,14 +4968,21 @@ namespace mplr {
         check_size(sendls);
         check_size(recvdispls);
         check_size(recvls);
-        const auto sendcounts{sizes_as_vector_of_ints(sendls)};
-        const auto senddispls_as_int{displacements_as_vector_of_ints(senddispls)};
-        const auto recvcounts{sizes_as_vector_of_ints(recvls)};
-        const auto recvdispls_as_int{displacements_as_vector_of_ints(recvdispls)};
-        MPI_Alltoallv(send_data, sendcounts.data(), senddispls_as_int.data(),
+        const auto sendcounts{sizes_as_vector_of_counts(sendls)};
+        const auto senddispls_as_count{displacements_as_vector_of_counts(senddispls)};
+        const auto recvcounts{sizes_as_vector_of_counts(recvls)};
+        const auto recvdispls_as_count{displacements_as_vector_of_counts(recvdispls)};
+#if defined MPLR_HAS_LARGE_COUNT
+        MPI_Alltoallv_c(send_data, sendcounts.data(), senddispls_as_count.data(),
+                        detail::datatype_traits<T>::get_datatype(), recv_data,
+                        recvcounts.data(), recvdispls_as_count.data(),
+                        detail::datatype_traits<T>::get_datatype(), comm_);
+#else
+        MPI_Alltoallv(send_data, sendcounts.data(), senddispls_as_count.data(),
                       detail::datatype_traits<T>::get_datatype(), recv_data, recvcounts.data(),
-                      recvdispls_as_int.data(), detail::datatype_traits<T>::get_datatype(),
+                      recvdispls_as_count.data(), detail::datatype_traits<T>::get_datatype(),
                       comm_);
+#endif
       }
 
       /// Sends messages with a variable amount of data to all processes and receives
@@ -3823,78 +5015,105 @@ namespace mplr {
 
       // --- non-blocking all-to-all ---
     protected:
-      struct ialltoallv_request_state {
-        MPI_Status status{};
+      // argument arrays of a non-blocking all-to-all operation, which must not be released
+      // before the operation has completed, owned by the operation's request
+      struct ialltoallv_resources {
+        std::vector<int> sendcounts;
+        std::vector<int> senddispls;
+        std::vector<MPI_Datatype> sendtypes;
+        std::vector<int> recvcounts;
+        std::vector<int> recvdispls;
+        std::vector<MPI_Datatype> recvtypes;
+        // data types that place layouts at displacements which exceed the range of int
+        std::vector<detail::shared_datatype> displaced_types;
+        // layouts that were created internally by a persistent operation
+        std::shared_ptr<void> internal_layouts;
       };
 
+      // send and receive layouts of the persistent gather and scatter operations with
+      // variable amounts of data, which are implemented via a persistent all-to-all operation
       template<typename T>
-      struct ialltoallv_state {
-        MPI_Request req{};
-        layouts<T> sendl;
-        layouts<T> recvl;
-        std::vector<int> counts;
-        std::vector<int> senddispls_int;
-        std::vector<int> recvdispls_int;
-        ialltoallv_request_state* request_state{nullptr};
-
-        ialltoallv_state(const layouts<T>& sendl, const layouts<T>& recvl,
-                         std::vector<int>&& counts, std::vector<int>&& senddispls_int,
-                         std::vector<int>&& recvdispls_int)
-            : sendl{sendl},
-              recvl{recvl},
-              counts{std::move(counts)},
-              senddispls_int{std::move(senddispls_int)},
-              recvdispls_int{std::move(recvdispls_int)} {
-        }
-        ialltoallv_state(const layouts<T>& recvl, std::vector<int>&& counts,
-                         std::vector<int>&& recvdispls_int)
-            : sendl{},
-              recvl{recvl},
-              counts{std::move(counts)},
-              senddispls_int{},
-              recvdispls_int{std::move(recvdispls_int)} {
+      struct internal_layouts {
+        layouts<T> sendls;
+        layouts<T> recvls;
+
+        explicit internal_layouts(int n) : sendls(n), recvls(n) {
         }
       };
 
-      static int ialltoallv_query(void* state, MPI_Status* s) {
-        auto* request_state{static_cast<ialltoallv_request_state*>(state)};
-        const int error_backup{s->MPI_ERROR};
-        *s = request_state->status;
-        s->MPI_ERROR = error_backup;
-        return MPI_SUCCESS;
-      }
-
-      static int ialltoallv_free(void* state) {
-        auto* request_state{static_cast<ialltoallv_request_state*>(state)};
-        delete request_state;
-        return MPI_SUCCESS;
-      }
-
-      static int ialltoallv_cancel([[maybe_unused]] void* state,
-                                   [[maybe_unused]] int complete) {
-        return MPI_SUCCESS;
+      template<typename T>
+      static std::vector<MPI_Datatype> datatypes_as_vector(const layouts<T>& ls) {
+        std::vector<MPI_Datatype> types;
+        types.reserve(ls.size());
+        std::transform(ls.begin(), ls.end(), std::back_inserter(types), [](const auto& l) {
+          return detail::datatype_traits<layout<T>>::get_datatype(l);
+        });
+        return types;
+      }
+
+      // converts memory layouts and displacements in units of T into the argument arrays of
+      // MPI_Alltoallw, a displacement that cannot be passed as an int value is moved into a
+      // new data type, which places the layout at this displacement and which is stored in
+      // displaced_types
+      template<typename T>
+      static void alltoallw_arguments(const layouts<T>& ls, const displacements& displs,
+                                      std::vector<int>& displs_int,
+                                      std::vector<MPI_Datatype>& types,
+                                      std::vector<detail::shared_datatype>& displaced_types) {
+        displs_int.clear();
+        displs_int.reserve(ls.size());
+        types = datatypes_as_vector(ls);
+        for (std::size_t i{0}; i < ls.size(); ++i) {
+          const MPI_Aint displ{displs[i] * static_cast<MPI_Aint>(sizeof(T))};
+          if (detail::fits_int_count(displ)) {
+            displs_int.push_back(static_cast<int>(displ));
+            continue;
+          }
+          MPI_Datatype displaced_type;
+          MPI_Type_create_hindexed_block(1, 1, &displ, types[i], &displaced_type);
+          displaced_types.push_back(detail::shared_datatype::commit(displaced_type));
+          displs_int.push_back(0);
+          types[i] = displaced_types.back().get();
+        }
       }
 
+      // creates a persistent all-to-all operation, which keeps the given internally created
+      // layouts alive
       template<typename T>
-      void ialltoallv_task(const T* send_data, T* recv_data, ialltoallv_state<T>* state) const {
+      prequest alltoallw_init(const T* send_data, const layouts<T>& sendls,
+                              const displacements& senddispls, T* recv_data,
+                              const layouts<T>& recvls, const displacements& recvdispls,
+                              std::shared_ptr<void> internal_layouts) const {
+        check_size(senddispls);
+        check_size(sendls);
+        check_size(recvdispls);
+        check_size(recvls);
+        auto resources{std::make_shared<ialltoallv_resources>()};
+        resources->internal_layouts = std::move(internal_layouts);
+        resources->recvcounts.assign(recvls.size(), 1);
+        alltoallw_arguments(sendls, senddispls, resources->senddispls, resources->sendtypes,
+                            resources->displaced_types);
+        alltoallw_arguments(recvls, recvdispls, resources->recvdispls, resources->recvtypes,
+                            resources->displaced_types);
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
         MPI_Request req;
-        static_assert(
-            sizeof(decltype(*state->sendl())) == sizeof(MPI_Datatype),
-            "compiler adds some unexpected padding, reinterpret cast will yield wrong results");
-        if (send_data != nullptr)
-          MPI_Ialltoallw(send_data, state->counts.data(), state->senddispls_int.data(),
-                         reinterpret_cast<const MPI_Datatype*>(state->sendl()), recv_data,
-                         state->counts.data(), state->recvdispls_int.data(),
-                         reinterpret_cast<const MPI_Datatype*>(state->recvl()), comm_, &req);
-        else
-          MPI_Ialltoallw(MPI_IN_PLACE, nullptr, nullptr, nullptr, recv_data,
-                         state->counts.data(), state->recvdispls_int.data(),
-                         reinterpret_cast<const MPI_Datatype*>(state->recvl()), comm_, &req);
-        MPI_Status s;
-        MPI_Wait(&req, &s);
-        state->request_state->status = s;
-        MPI_Grequest_complete(state->req);
-        delete state;
+        MPI_Alltoallw_init(send_data, resources->recvcounts.data(),
+                           resources->senddispls.data(), resources->sendtypes.data(), recv_data,
+                           resources->recvcounts.data(), resources->recvdispls.data(),
+                           resources->recvtypes.data(), comm_, MPI_INFO_NULL, &req);
+        return base_prequest{req, std::move(resources)};
+#else
+        return make_persistent_schedule(
+            [send_data, recv_data, resources{std::move(resources)}, comm{comm_}]() {
+              MPI_Request req;
+              MPI_Ialltoallw(send_data, resources->recvcounts.data(),
+                             resources->senddispls.data(), resources->sendtypes.data(),
+                             recv_data, resources->recvcounts.data(),
+                             resources->recvdispls.data(), resources->recvtypes.data(), comm,
+                             &req);
+              return req;
+            });
+#endif
       }
 
     public:
@@ -3928,21 +5147,17 @@ namespace mplr {
         check_size(sendls);
         check_size(recvdispls);
         check_size(recvls);
-        auto* request_state{new ialltoallv_request_state()};
+        auto resources{std::make_shared<ialltoallv_resources>()};
+        resources->recvcounts.assign(recvls.size(), 1);
+        alltoallw_arguments(sendls, senddispls, resources->senddispls, resources->sendtypes,
+                            resources->displaced_types);
+        alltoallw_arguments(recvls, recvdispls, resources->recvdispls, resources->recvtypes,
+                            resources->displaced_types);
         MPI_Request req;
-        MPI_Grequest_start(ialltoallv_query, ialltoallv_free, ialltoallv_cancel, request_state,
-                           &req);
-        auto* alltoall_state{
-            new ialltoallv_state<T>(sendls, recvls, std::vector<int>(recvls.size(), 1),
-                                    displacements_as_vector_of_ints(senddispls, sizeof(T)),
-                                    displacements_as_vector_of_ints(recvdispls, sizeof(T)))};
-        alltoall_state->req = req;
-        alltoall_state->request_state = request_state;
-        std::thread thread([this, send_data, recv_data, alltoall_state]() {
-          ialltoallv_task(send_data, recv_data, alltoall_state);
-        });
-        thread.detach();
-        return base_irequest{req};
+        MPI_Ialltoallw(send_data, resources->recvcounts.data(), resources->senddispls.data(),
+                       resources->sendtypes.data(), recv_data, resources->recvcounts.data(),
+                       resources->recvdispls.data(), resources->recvtypes.data(), comm_, &req);
+        return base_irequest{req, std::move(resources)};
       }
 
       /// Sends messages with a variable amount of data to all processes and receives
@@ -3967,6 +5182,13 @@ namespace mplr {
       /// i-th memory block in the array \c recv_data was received from the i-th process.
       /// \note This is a collective operation and must be called (possibly by utilizing another
       /// overload) by all processes in the communicator.
+      /// \throw invalid_count if a count does not fit into an int value and MPI provides no
+      /// large-count functions
+      /// \throw invalid_displacement if a displacement does not fit into an int value and MPI
+      /// provides no large-count functions
+      /// \note Without the large-count functions of MPI 4.0, all counts and displacements must
+      /// fit into int values.  As only the process that holds a larger value throws, such data
+      /// must be exchanged via the overloads for \c layouts.
       template<typename T>
       irequest ialltoallv(const T* send_data, const contiguous_layouts<T>& sendls,
                           const displacements& senddispls, T* recv_data,
@@ -3976,16 +5198,24 @@ namespace mplr {
         check_size(sendls);
         check_size(recvdispls);
         check_size(recvls);
-        const auto sendcounts{sizes_as_vector_of_ints(sendls)};
-        const auto senddispls_as_int{displacements_as_vector_of_ints(senddispls)};
-        const auto recvcounts{sizes_as_vector_of_ints(recvls)};
-        const auto recvdispls_as_int{displacements_as_vector_of_ints(recvdispls)};
+        auto counts{std::make_shared<icollective_counts>()};
+        counts->sendcounts = sizes_as_vector_of_counts(sendls);
+        counts->senddispls = displacements_as_vector_of_counts(senddispls);
+        counts->recvcounts = sizes_as_vector_of_counts(recvls);
+        counts->recvdispls = displacements_as_vector_of_counts(recvdispls);
         MPI_Request req;
-        MPI_Ialltoallv(send_data, sendcounts.data(), senddispls_as_int.data(),
-                       detail::datatype_traits<T>::get_datatype(), recv_data, recvcounts.data(),
-                       recvdispls_as_int.data(), detail::datatype_traits<T>::get_datatype(),
-                       comm_, &req);
-        return base_irequest{req};
+#if defined MPLR_HAS_LARGE_COUNT
+        MPI_Ialltoallv_c(send_data, counts->sendcounts.data(), counts->senddispls.data(),
+                         detail::datatype_traits<T>::get_datatype(), recv_data,
+                         counts->recvcounts.data(), counts->recvdispls.data(),
+                         detail::datatype_traits<T>::get_datatype(), comm_, &req);
+#else
+        MPI_Ialltoallv(send_data, counts->sendcounts.data(), counts->senddispls.data(),
+                       detail::datatype_traits<T>::get_datatype(), recv_data,
+                       counts->recvcounts.data(), counts->recvdispls.data(),
+                       detail::datatype_traits<T>::get_datatype(), comm_, &req);
+#endif
+        return base_irequest{req, std::move(counts)};
       }
 
       /// Sends messages with a variable amount of data to all processes and receives
@@ -4011,10 +5241,134 @@ namespace mplr {
       /// \note This is a collective operation and must be called (possibly by utilizing another
       /// overload) by all processes in the communicator.
       template<typename T>
-      irequest ialltoallv(const T* send_data, const layouts<T>& sendls, T* recv_data,
-                          const layouts<T>& recvls) const {
+      irequest ialltoallv(const T* send_data, const layouts<T>& sendls, T* recv_data,
+                          const layouts<T>& recvls) const {
+        const displacements sendrecvdispls(size());
+        return ialltoallv(send_data, sendls, sendrecvdispls, recv_data, recvls, sendrecvdispls);
+      }
+
+      // --- persistent all-to-all ---
+      /// Creates a persistent request for sending messages with a variable amount of data to
+      /// all processes and receiving messages with a variable amount of data from all
+      /// processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param send_data pointer to continuous storage for outgoing messages
+      /// \param sendls memory layouts of the data to send, must not be destroyed before the
+      /// request
+      /// \param senddispls displacements of the data to send
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \param recvls memory layouts of the data to receive, must not be destroyed before the
+      /// request
+      /// \param recvdispls displacements of the data to receive
+      /// \return persistent request
+      /// \details See \c alltoallv for the arrangement of send- and receive-data.
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest alltoallv_init(const T* send_data, const layouts<T>& sendls,
+                                            const displacements& senddispls, T* recv_data,
+                                            const layouts<T>& recvls,
+                                            const displacements& recvdispls) const {
+        return alltoallw_init(send_data, sendls, senddispls, recv_data, recvls, recvdispls,
+                              nullptr);
+      }
+
+      /// Creates a persistent request for sending messages with a variable amount of data to
+      /// all processes and receiving messages with a variable amount of data from all
+      /// processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param send_data pointer to continuous storage for outgoing messages
+      /// \param sendls memory layouts of the data to send
+      /// \param senddispls displacements of the data to send
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \param recvls memory layouts of the data to receive
+      /// \param recvdispls displacements of the data to receive
+      /// \return persistent request
+      /// \details See \c alltoallv for the arrangement of send- and receive-data.
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      /// \throw invalid_count if a count does not fit into an int value and MPI provides no
+      /// large-count functions
+      /// \throw invalid_displacement if a displacement does not fit into an int value and MPI
+      /// provides no large-count functions
+      /// \note Without the large-count functions of MPI 4.0, all counts and displacements must
+      /// fit into int values.  As only the process that holds a larger value throws, such data
+      /// must be exchanged via the overloads for \c layouts.
+      template<typename T>
+      [[nodiscard]] prequest alltoallv_init(const T* send_data,
+                                            const contiguous_layouts<T>& sendls,
+                                            const displacements& senddispls, T* recv_data,
+                                            const contiguous_layouts<T>& recvls,
+                                            const displacements& recvdispls) const {
+        check_size(senddispls);
+        check_size(sendls);
+        check_size(recvdispls);
+        check_size(recvls);
+        auto counts{std::make_shared<icollective_counts>()};
+        counts->sendcounts = sizes_as_vector_of_counts(sendls);
+        counts->senddispls = displacements_as_vector_of_counts(senddispls);
+        counts->recvcounts = sizes_as_vector_of_counts(recvls);
+        counts->recvdispls = displacements_as_vector_of_counts(recvdispls);
+        const MPI_Datatype type{detail::datatype_traits<T>::get_datatype()};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+#if defined MPLR_HAS_LARGE_COUNT
+        MPI_Alltoallv_init_c(send_data, counts->sendcounts.data(), counts->senddispls.data(),
+                             type, recv_data, counts->recvcounts.data(),
+                             counts->recvdispls.data(), type, comm_, MPI_INFO_NULL, &req);
+#else
+        MPI_Alltoallv_init(send_data, counts->sendcounts.data(), counts->senddispls.data(),
+                           type, recv_data, counts->recvcounts.data(),
+                           counts->recvdispls.data(), type, comm_, MPI_INFO_NULL, &req);
+#endif
+        return base_prequest{req, std::move(counts)};
+#else
+        return make_persistent_schedule(
+            [send_data, recv_data, type, counts{std::move(counts)}, comm{comm_}]() {
+              MPI_Request req;
+#if defined MPLR_HAS_LARGE_COUNT
+              MPI_Ialltoallv_c(send_data, counts->sendcounts.data(), counts->senddispls.data(),
+                               type, recv_data, counts->recvcounts.data(),
+                               counts->recvdispls.data(), type, comm, &req);
+#else
+              MPI_Ialltoallv(send_data, counts->sendcounts.data(), counts->senddispls.data(),
+                             type, recv_data, counts->recvcounts.data(),
+                             counts->recvdispls.data(), type, comm, &req);
+#endif
+              return req;
+            });
+#endif
+      }
+
+      /// Creates a persistent request for sending messages with a variable amount of data to
+      /// all processes and receiving messages with a variable amount of data from all
+      /// processes.
+      /// \tparam T type of the data to send, must meet the requirements as described in the
+      /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+      /// \param send_data pointer to continuous storage for outgoing messages
+      /// \param sendls memory layouts of the data to send, must not be destroyed before the
+      /// request
+      /// \param recv_data pointer to continuous storage for incoming messages
+      /// \param recvls memory layouts of the data to receive, must not be destroyed before the
+      /// request
+      /// \return persistent request
+      /// \details See \c alltoallv for the arrangement of send- and receive-data.
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T>
+      [[nodiscard]] prequest alltoallv_init(const T* send_data, const layouts<T>& sendls,
+                                            T* recv_data, const layouts<T>& recvls) const {
         const displacements sendrecvdispls(size());
-        return ialltoallv(send_data, sendls, sendrecvdispls, recv_data, recvls, sendrecvdispls);
+        return alltoallv_init(send_data, sendls, sendrecvdispls, recv_data, recvls,
+                              sendrecvdispls);
       }
 
       // === reduce ===
@@ -4063,6 +5417,52 @@ namespace mplr {
                    comm_);
       }
 
+      /// Performs a reduction operation over all processes, the waiting thread behaves as
+      /// given by a wait policy.
+      /// \tparam F type representing the reduction operation, reduction operation is performed
+      /// on data of type \c T
+      /// \tparam T type of input and output data of the reduction operation, must meet the
+      /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+      /// section
+      /// \tparam P type of the wait policy, see \c irequest::wait
+      /// \param f reduction operation
+      /// \param root_rank rank of the process that will receive the reduction result
+      /// \param send_data input data for the reduction operation
+      /// \param recv_data will hold the result of the reduction operation if rank equals root_rank
+      /// \param policy the wait policy
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.
+      template<typename T, typename F, typename P,
+               typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+      void reduce(F&& f, int root_rank, const T& send_data, T& recv_data,
+                  const P& policy) const {
+        ireduce(std::forward<F>(f), root_rank, send_data, recv_data).wait(policy);
+      }
+
+      /// Performs a reduction operation over all processes, the waiting thread behaves as
+      /// given by a wait policy.
+      /// \tparam F type representing the element-wise reduction operation, reduction operation is
+      /// performed on data of type \c T
+      /// \tparam T type of input and output data of the reduction operation, must meet the
+      /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+      /// section
+      /// \tparam P type of the wait policy, see \c irequest::wait
+      /// \param f reduction operation
+      /// \param root_rank rank of the process that will receive the reduction result
+      /// \param send_data input buffer for the reduction operation
+      /// \param recv_data will hold the results of the reduction operation if rank equals
+      /// root_rank, may be nullptr if rank does no equal to root_rank
+      /// \param l memory layouts of the data to send and to receive
+      /// \param policy the wait policy
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.
+      template<typename T, typename F, typename P,
+               typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+      void reduce(F&& f, int root_rank, const T* send_data, T* recv_data,
+                  const contiguous_layout<T>& l, const P& policy) const {
+        ireduce(std::forward<F>(f), root_rank, send_data, recv_data, l).wait(policy);
+      }
+
       // --- non-blocking reduce ---
       /// Performs a reduction operation over all processes in a non-blocking manner.
       /// \tparam F type representing the reduction operation, reduction operation is performed
@@ -4113,6 +5513,68 @@ namespace mplr {
         return base_irequest{req};
       }
 
+      // --- persistent reduce ---
+      /// Creates a persistent request for a reduction operation over all processes.
+      /// \tparam F type representing the reduction operation, reduction operation is performed
+      /// on data of type \c T
+      /// \tparam T type of input and output data of the reduction operation, must meet the
+      /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+      /// section
+      /// \param f reduction operation
+      /// \param root_rank rank of the process that will receive the reduction result
+      /// \param send_data input data for the reduction operation
+      /// \param recv_data will hold the result of the reduction operation if rank equals root_rank
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T, typename F>
+      [[nodiscard]] prequest reduce_init(F&& f, int root_rank, const T& send_data,
+                                         T& recv_data) const {
+        return reduce_init(std::forward<F>(f), root_rank, &send_data, &recv_data,
+                           contiguous_layout<T>{1});
+      }
+
+      /// Creates a persistent request for a reduction operation over all processes.
+      /// \tparam F type representing the element-wise reduction operation, reduction operation is
+      /// performed on data of type \c T
+      /// \tparam T type of input and output data of the reduction operation, must meet the
+      /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+      /// section
+      /// \param f reduction operation
+      /// \param root_rank rank of the process that will receive the reduction result
+      /// \param send_data input buffer for the reduction operation
+      /// \param recv_data will hold the results of the reduction operation if rank equals
+      /// root_rank, may be nullptr if rank does no equal to root_rank
+      /// \param l memory layouts of the data to send and to receive
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T, typename F>
+      [[nodiscard]] prequest reduce_init(F&& f, int root_rank, const T* send_data, T* recv_data,
+                                         const contiguous_layout<T>& l) const {
+        check_root(root_rank);
+        const int count{static_cast<int>(l.size())};
+        const MPI_Datatype type{detail::datatype_traits<T>::get_datatype()};
+        const MPI_Op op{detail::get_op<T, std::decay_t<F>>(std::forward<F>(f)).mpi_op};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Reduce_init(send_data, recv_data, count, type, op, root_rank, comm_, MPI_INFO_NULL,
+                        &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule(
+            [send_data, recv_data, count, type, op, root_rank, comm{comm_}]() {
+              MPI_Request req;
+              MPI_Ireduce(send_data, recv_data, count, type, op, root_rank, comm, &req);
+              return req;
+            });
+#endif
+      }
+
       // === all-reduce ===
       // --- blocking all-reduce ---
       /// Performs a reduction operation over all processes and broadcasts the result.
@@ -4152,6 +5614,48 @@ namespace mplr {
                       detail::get_op<T, std::decay_t<F>>(std::forward<F>(f)).mpi_op, comm_);
       }
 
+      /// Performs a reduction operation over all processes and broadcasts the result, the
+      /// waiting thread behaves as given by a wait policy.
+      /// \tparam F type representing the reduction operation, reduction operation is performed
+      /// on data of type \c T
+      /// \tparam T type of input and output data of the reduction operation, must meet the
+      /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+      /// section
+      /// \tparam P type of the wait policy, see \c irequest::wait
+      /// \param f reduction operation
+      /// \param send_data input data for the reduction operation
+      /// \param recv_data will hold the result of the reduction operation
+      /// \param policy the wait policy
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.
+      template<typename T, typename F, typename P,
+               typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+      void allreduce(F&& f, const T& send_data, T& recv_data, const P& policy) const {
+        iallreduce(std::forward<F>(f), send_data, recv_data).wait(policy);
+      }
+
+      /// Performs a reduction operation over all processes and broadcasts the result, the
+      /// waiting thread behaves as given by a wait policy.
+      /// \tparam F type representing the element-wise reduction operation, reduction operation is
+      /// performed on data of type \c T
+      /// \tparam T type of input and output data of the reduction operation, must meet the
+      /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+      /// section
+      /// \tparam P type of the wait policy, see \c irequest::wait
+      /// \param f reduction operation
+      /// \param send_data input buffer for the reduction operation
+      /// \param recv_data will hold the results of the reduction operation
+      /// \param l memory layouts of the data to send and to receive
+      /// \param policy the wait policy
+      /// \note This is a collective operation and must be called (possibly by utilizing another
+      /// overload) by all processes in the communicator.
+      template<typename T, typename F, typename P,
+               typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+      void allreduce(F&& f, const T* send_data, T* recv_data, const contiguous_layout<T>& l,
+                     const P& policy) const {
+        iallreduce(std::forward<F>(f), send_data, recv_data, l).wait(policy);
+      }
+
       // --- non-blocking all-reduce ---
       /// Performs a reduction operation over all processes and broadcasts the result in a
       /// non-blocking manner.
@@ -4199,6 +5703,63 @@ namespace mplr {
         return base_irequest{req};
       }
 
+      // --- persistent all-reduce ---
+      /// Creates a persistent request for a reduction operation over all processes, which
+      /// broadcasts the result.
+      /// \tparam F type representing the reduction operation, reduction operation is performed
+      /// on data of type \c T
+      /// \tparam T type of input and output data of the reduction operation, must meet the
+      /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+      /// section
+      /// \param f reduction operation
+      /// \param send_data input data for the reduction operation
+      /// \param recv_data will hold the result of the reduction operation
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T, typename F>
+      [[nodiscard]] prequest allreduce_init(F&& f, const T& send_data, T& recv_data) const {
+        return allreduce_init(std::forward<F>(f), &send_data, &recv_data,
+                              contiguous_layout<T>{1});
+      }
+
+      /// Creates a persistent request for a reduction operation over all processes, which
+      /// broadcasts the result.
+      /// \tparam F type representing the element-wise reduction operation, reduction operation is
+      /// performed on data of type \c T
+      /// \tparam T type of input and output data of the reduction operation, must meet the
+      /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+      /// section
+      /// \param f reduction operation
+      /// \param send_data input buffer for the reduction operation
+      /// \param recv_data will hold the results of the reduction operation
+      /// \param l memory layouts of the data to send and to receive
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T, typename F>
+      [[nodiscard]] prequest allreduce_init(F&& f, const T* send_data, T* recv_data,
+                                            const contiguous_layout<T>& l) const {
+        const int count{static_cast<int>(l.size())};
+        const MPI_Datatype type{detail::datatype_traits<T>::get_datatype()};
+        const MPI_Op op{detail::get_op<T, std::decay_t<F>>(std::forward<F>(f)).mpi_op};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Allreduce_init(send_data, recv_data, count, type, op, comm_, MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule([send_data, recv_data, count, type, op, comm{comm_}]() {
+          MPI_Request req;
+          MPI_Iallreduce(send_data, recv_data, count, type, op, comm, &req);
+          return req;
+        });
+#endif
+      }
+
       // === reduce-scatter-block ===
       // --- blocking reduce-scatter-block ---
       /// Performs a reduction operation over all processes and scatters the result.
@@ -4292,6 +5853,68 @@ namespace mplr {
         return base_irequest{req};
       }
 
+      // --- persistent reduce-scatter-block ---
+      /// Creates a persistent request for a reduction operation over all processes, which
+      /// scatters the result.
+      /// \tparam F type representing the element-wise reduction operation, reduction operation is
+      /// performed on data of type \c T
+      /// \tparam T type of input and output data of the reduction operation, must meet the
+      /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+      /// section
+      /// \param f reduction operation
+      /// \param send_data input buffer for the reduction operation, number of elements in buffer
+      /// send_data must equal the size of the communicator
+      /// \param recv_data will hold the result of the reduction operation
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T, typename F>
+      [[nodiscard]] prequest reduce_scatter_block_init(F&& f, const T* send_data,
+                                                       T& recv_data) const {
+        return reduce_scatter_block_init(std::forward<F>(f), send_data, &recv_data,
+                                         contiguous_layout<T>{1});
+      }
+
+      /// Creates a persistent request for a reduction operation over all processes, which
+      /// scatters the result.
+      /// \tparam F type representing the element-wise reduction operation, reduction operation is
+      /// performed on data of type \c T
+      /// \tparam T type of input and output data of the reduction operation, must meet the
+      /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+      /// section
+      /// \param f reduction operation
+      /// \param send_data input buffer for the reduction operation, number of elements in buffer
+      /// send_data must equal the size of the communicator times the number of elements given by
+      /// the layout parameter
+      /// \param recv_data will hold the results of the reduction operation
+      /// \param recvcount memory layouts of the data to send and to receive
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T, typename F>
+      [[nodiscard]] prequest reduce_scatter_block_init(
+          F&& f, const T* send_data, T* recv_data, const contiguous_layout<T>& recvcount) const {
+        const int count{static_cast<int>(recvcount.size())};
+        const MPI_Datatype type{detail::datatype_traits<T>::get_datatype()};
+        const MPI_Op op{detail::get_op<T, std::decay_t<F>>(std::forward<F>(f)).mpi_op};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Reduce_scatter_block_init(send_data, recv_data, count, type, op, comm_,
+                                      MPI_INFO_NULL, &req);
+        return base_prequest{req};
+#else
+        return make_persistent_schedule([send_data, recv_data, count, type, op, comm{comm_}]() {
+          MPI_Request req;
+          MPI_Ireduce_scatter_block(send_data, recv_data, count, type, op, comm, &req);
+          return req;
+        });
+#endif
+      }
+
       // === reduce-scatter ===
       // --- blocking reduce-scatter ---
       /// Performs a reduction operation over all processes and scatters the result.
@@ -4345,6 +5968,50 @@ namespace mplr {
         return base_irequest{req};
       }
 
+      // --- persistent reduce-scatter ---
+      /// Creates a persistent request for a reduction operation over all processes, which
+      /// scatters the result.
+      /// \tparam F type representing the element-wise reduction operation, reduction operation is
+      /// performed on data of type \c T
+      /// \tparam T type of input and output data of the reduction operation, must meet the
+      /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+      /// section
+      /// \param f reduction operation
+      /// \param send_data input data for the reduction operation, number of elements in buffer
+      /// send_data must equal the sum of the number of elements given by the collection of layout
+      /// parameters
+      /// \param recv_data will hold the results of the reduction operation
+      /// \param recvcounts memory layouts of the data to send and to receive
+      /// \return persistent request
+      /// \note This is a collective operation and must be called by all processes in the
+      /// communicator.  Persistent collective operations require MPI 4.0.  If the macro
+      /// \c MPLR_HAS_PERSISTENT_COLLECTIVES is not defined, starting the request starts the
+      /// corresponding non-blocking operation with the arguments given here.
+      template<typename T, typename F>
+      [[nodiscard]] prequest reduce_scatter_init(F&& f, const T* send_data, T* recv_data,
+                                                 const contiguous_layouts<T>& recvcounts) const {
+        check_size(recvcounts);
+        auto counts{std::make_shared<std::vector<int>>()};
+        counts->reserve(recvcounts.size());
+        for (const auto& l : recvcounts)
+          counts->push_back(static_cast<int>(l.size()));
+        const MPI_Datatype type{detail::datatype_traits<T>::get_datatype()};
+        const MPI_Op op{detail::get_op<T, std::decay_t<F>>(std::forward<F>(f)).mpi_op};
+#if defined MPLR_HAS_PERSISTENT_COLLECTIVES
+        MPI_Request req;
+        MPI_Reduce_scatter_init(send_data, recv_data, counts->data(), type, op, comm_,
+                                MPI_INFO_NULL, &req);
+        return base_prequest{req, std::move(counts)};
+#else
+        return make_persistent_schedule(
+            [send_data, recv_data, counts{std::move(counts)}, type, op, comm{comm_}]() {
+              MPI_Request req;
+              MPI_Ireduce_scatter(send_data, recv_data, counts->data(), type, op, comm, &req);
+              return req;
+            });
+#endif
+      }
+
       // === scan ===
       // --- blocking scan ---
       /// Performs partial reduction operation (scan) over all processes.
@@ -4522,6 +6189,9 @@ namespace mplr {
     explicit communicator(MPI_Comm comm) : base{comm} {
     }
 
+    explicit communicator(MPI_Comm comm, non_owning_tag t) : base{comm, t} {
+    }
+
   public:
     /// Creates an empty communicator with no associated process.
     communicator() = default;
@@ -4579,6 +6249,7 @@ namespace mplr {
     explicit communicator([[maybe_unused]] comm_collective_tag comm_collective,
                           const communicator& other, const group& gr) {
       MPI_Comm_create(other.comm_, gr.gr_, &comm_);
+      update_descriptor();
     }
 
     /// Constructs a new communicator from an existing one with a specified communication
@@ -4592,6 +6263,7 @@ namespace mplr {
     explicit communicator([[maybe_unused]] group_collective_tag group_collective,
                           const communicator& other, const group& gr, tag_t t = tag_t{0}) {
       MPI_Comm_create_group(other.comm_, gr.gr_, static_cast<int>(t), &comm_);
+      update_descriptor();
     }
 
     /// Constructs a new communicator from an existing one with a specified communication
@@ -4613,6 +6285,7 @@ namespace mplr {
                     "not an enumeration type or underlying enumeration type too large");
       MPI_Comm_split(other.comm_, detail::underlying_type<color_type>::value(color),
                      detail::underlying_type<key_type>::value(key), &comm_);
+      update_descriptor();
     }
 
     /// Constructs a new communicator from an existing one by spitting the communicator
@@ -4630,6 +6303,7 @@ namespace mplr {
                     "not an enumeration type or underlying enumeration type too large");
       MPI_Comm_split_type(other.comm_, MPI_COMM_TYPE_SHARED,
                           detail::underlying_type<key_type>::value(key), MPI_INFO_NULL, &comm_);
+      update_descriptor();
     }
 
     communicator& operator=(const communicator& other) = delete;
@@ -4839,11 +6513,13 @@ namespace mplr {
                    const displacements& sendrecvdispls) const {
       check_size(sendrecvdispls);
       check_size(sendrecvls);
-      const std::vector<int> counts(sendrecvls.size(), 1);
-      const auto sendrecvdispls_int{displacements_as_vector_of_ints(sendrecvdispls, sizeof(T))};
-      MPI_Alltoallw(MPI_IN_PLACE, nullptr, nullptr, nullptr, sendrecv_data, counts.data(),
-                    sendrecvdispls_int.data(),
-                    reinterpret_cast<const MPI_Datatype*>(sendrecvls()), comm_);
+      ialltoallv_resources resources;
+      resources.recvcounts.assign(sendrecvls.size(), 1);
+      alltoallw_arguments(sendrecvls, sendrecvdispls, resources.recvdispls,
+                          resources.recvtypes, resources.displaced_types);
+      MPI_Alltoallw(MPI_IN_PLACE, nullptr, nullptr, nullptr, sendrecv_data,
+                    resources.recvcounts.data(), resources.recvdispls.data(),
+                    resources.recvtypes.data(), comm_);
     }
 
     /// Sends messages with a variable amount of data to all processes and receives
@@ -4893,20 +6569,15 @@ namespace mplr {
                         const displacements& sendrecvdispls) const {
       check_size(sendrecvdispls);
       check_size(sendrecvls);
-      auto* request_state{new ialltoallv_request_state()};
+      auto resources{std::make_shared<ialltoallv_resources>()};
+      resources->recvcounts.assign(sendrecvls.size(), 1);
+      alltoallw_arguments(sendrecvls, sendrecvdispls, resources->recvdispls,
+                          resources->recvtypes, resources->displaced_types);
       MPI_Request req;
-      MPI_Grequest_start(ialltoallv_query, ialltoallv_free, ialltoallv_cancel, request_state,
-                         &req);
-      auto* alltoall_state{
-          new ialltoallv_state<T>(sendrecvls, std::vector<int>(sendrecvls.size(), 1),
-                                  displacements_as_vector_of_ints(sendrecvdispls, sizeof(T)))};
-      alltoall_state->req = req;
-      alltoall_state->request_state = request_state;
-      std::thread thread([this, sendrecv_data, alltoall_state]() {
-        ialltoallv_task(static_cast<T*>(nullptr), sendrecv_data, alltoall_state);
-      });
-      thread.detach();
-      return impl::base_irequest{req};
+      MPI_Ialltoallw(MPI_IN_PLACE, nullptr, nullptr, nullptr, sendrecv_data,
+                     resources->recvcounts.data(), resources->recvdispls.data(),
+                     resources->recvtypes.data(), comm_, &req);
+      return impl::base_irequest{req, std::move(resources)};
     }
 
     /// Sends messages with a variable amount of data to all processes and receives
@@ -4932,6 +6603,393 @@ namespace mplr {
       return ialltoallv(sendrecv_data, sendrecvls, displacements(size()));
     }
 
+    // === variable-size collectives for containers ===
+    // message sizes are exchanged internally, data is transferred via the contiguous
+    // variants of the collective operations, only alltoallv creates derived data types for
+    // blocks whose displacements exceed the range of int
+    using base::gatherv;
+    using base::allgatherv;
+    using base::scatterv;
+
+    /// Gathers vectors of variable length from all processes at a single root process.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \tparam A allocator of the vectors
+    /// \param root_rank rank of the receiving process
+    /// \param send_data data to send
+    /// \return concatenation of the data of all processes in the order of their ranks at the
+    /// root process, empty vector at all other processes
+    /// \details Message sizes are exchanged between all processes, such that all of them
+    /// reject data that cannot be gathered.
+    /// \throw invalid_count on all processes if the size of a vector or the offset of a vector
+    /// in the gathered data cannot be passed as an int value
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.
+    template<typename T, typename A>
+    std::vector<T, A> gatherv(int root_rank, const std::vector<T, A>& send_data) const {
+      check_root(root_rank);
+      auto& scratch{detail::v_collective_scratch::this_thread()};
+      const int send_count{scratch.count(send_data)};
+      scratch.recv_counts.resize(size());
+      MPI_Allgather(&send_count, 1, MPI_INT, scratch.recv_counts.data(), 1, MPI_INT, comm_);
+      const auto recv_count{scratch.displacements(scratch.recv_counts, scratch.recv_displs)};
+      if (not recv_count)
+        throw invalid_count();
+      std::vector<T, A> recv_data(send_data.get_allocator());
+      if (rank() == root_rank)
+        recv_data.resize(*recv_count);
+      MPI_Gatherv(send_data.data(), send_count, detail::datatype_traits<T>::get_datatype(),
+                  recv_data.data(), scratch.recv_counts.data(), scratch.recv_displs.data(),
+                  detail::datatype_traits<T>::get_datatype(), root_rank, comm_);
+      return recv_data;
+    }
+
+    /// Gathers vectors of variable length from all processes and distributes the result to
+    /// all processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \tparam A allocator of the vectors
+    /// \param send_data data to send
+    /// \return concatenation of the data of all processes in the order of their ranks
+    /// \throw invalid_count on all processes if the size of a vector or the offset of a vector
+    /// in the gathered data cannot be passed as an int value
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.
+    template<typename T, typename A>
+    std::vector<T, A> allgatherv(const std::vector<T, A>& send_data) const {
+      auto& scratch{detail::v_collective_scratch::this_thread()};
+      const int send_count{scratch.count(send_data)};
+      scratch.recv_counts.resize(size());
+      MPI_Allgather(&send_count, 1, MPI_INT, scratch.recv_counts.data(), 1, MPI_INT, comm_);
+      const auto recv_count{scratch.displacements(scratch.recv_counts, scratch.recv_displs)};
+      if (not recv_count)
+        throw invalid_count();
+      std::vector<T, A> recv_data(*recv_count, send_data.get_allocator());
+      MPI_Allgatherv(send_data.data(), send_count, detail::datatype_traits<T>::get_datatype(),
+                     recv_data.data(), scratch.recv_counts.data(), scratch.recv_displs.data(),
+                     detail::datatype_traits<T>::get_datatype(), comm_);
+      return recv_data;
+    }
+
+    /// Scatters vectors of variable length from a single root process to all processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \tparam A allocator of the vectors
+    /// \param root_rank rank of the sending process
+    /// \param send_data one vector for each process in the order of their ranks, significant
+    /// at the root process only
+    /// \return the vector which was sent by the root process to this process
+    /// \throw invalid_count on all processes if the size of a vector or the offset of a vector
+    /// in the concatenated data of the root process cannot be passed as an int value
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.
+    template<typename T, typename A>
+    std::vector<T, A> scatterv(int root_rank,
+                               const std::vector<std::vector<T, A>>& send_data) const {
+      check_root(root_rank);
+      auto& scratch{detail::v_collective_scratch::this_thread()};
+      auto& staging{detail::v_collective_staging<T>::this_thread()};
+      const bool is_root{rank() == root_rank};
+      if (is_root) {
+#if defined MPLR_DEBUG
+        if (static_cast<int>(send_data.size()) != size())
+          throw invalid_size();
+#endif
+        scratch.send_counts.clear();
+        for (const auto& data : send_data)
+          scratch.send_counts.push_back(scratch.count(data));
+        // the sizes are replaced by markers, which make all processes throw
+        if (scratch.displacements(scratch.send_counts, scratch.send_displs))
+          staging.pack(send_data);
+        else
+          scratch.send_counts.assign(send_data.size(), scratch.oversized);
+      }
+      int recv_count{0};
+      MPI_Scatter(scratch.send_counts.data(), 1, MPI_INT, &recv_count, 1, MPI_INT, root_rank,
+                  comm_);
+      if (recv_count == scratch.oversized)
+        throw invalid_count();
+      std::vector<T, A> recv_data(recv_count, A{});
+      MPI_Scatterv(staging.send.data(), scratch.send_counts.data(), scratch.send_displs.data(),
+                   detail::datatype_traits<T>::get_datatype(), recv_data.data(), recv_count,
+                   detail::datatype_traits<T>::get_datatype(), root_rank, comm_);
+      staging.trim();
+      return recv_data;
+    }
+
+    /// Sends vectors of variable length to all processes and receives vectors of variable
+    /// length from all processes, in-place variant.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \tparam A allocator of the vectors
+    /// \param sendrecv_data one vector for each process in the order of their ranks, the i-th
+    /// vector is sent to the i-th process and is replaced by the vector received from the
+    /// i-th process
+    /// \details Message sizes are exchanged internally.  The received data replaces the
+    /// content of the vectors in \c sendrecv_data, their capacity is reused.  The total
+    /// amount of data may exceed the range of int.
+    /// \throw invalid_count on all processes if the size of a vector cannot be passed as an
+    /// int value
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.
+    template<typename T, typename A>
+    void alltoallv(std::vector<std::vector<T, A>>& sendrecv_data) const {
+#if defined MPLR_DEBUG
+      if (static_cast<int>(sendrecv_data.size()) != size())
+        throw invalid_size();
+#endif
+      auto& scratch{detail::v_collective_scratch::this_thread()};
+      auto& staging{detail::v_collective_staging<T>::this_thread()};
+      scratch.send_counts.clear();
+      for (const auto& data : sendrecv_data)
+        scratch.send_counts.push_back(scratch.count(data));
+      // all sizes are replaced by markers, which make all processes throw
+      const bool any_oversized{scratch.has_oversized(scratch.send_counts)};
+      if (any_oversized)
+        scratch.send_counts.assign(sendrecv_data.size(), scratch.oversized);
+      scratch.recv_counts.resize(size());
+      MPI_Alltoall(scratch.send_counts.data(), 1, MPI_INT, scratch.recv_counts.data(), 1,
+                   MPI_INT, comm_);
+      if (any_oversized or scratch.has_oversized(scratch.recv_counts))
+        throw invalid_count();
+      staging.pack(sendrecv_data);
+      const MPI_Datatype type{detail::datatype_traits<T>::get_datatype()};
+      const MPI_Aint extent{static_cast<MPI_Aint>(sizeof(T))};
+      std::vector<detail::shared_datatype> displaced_types;
+      scratch.alltoallw_blocks(scratch.send_counts, type, extent, scratch.send_displs,
+                               scratch.send_types, displaced_types);
+      staging.recv.resize(scratch.alltoallw_blocks(scratch.recv_counts, type, extent,
+                                                   scratch.recv_displs, scratch.recv_types,
+                                                   displaced_types));
+      MPI_Alltoallw(staging.send.data(), scratch.send_counts.data(),
+                    scratch.send_displs.data(), scratch.send_types.data(),
+                    staging.recv.data(), scratch.recv_counts.data(),
+                    scratch.recv_displs.data(), scratch.recv_types.data(), comm_);
+      auto first{staging.recv.begin()};
+      for (std::size_t i{0}; i < sendrecv_data.size(); ++i) {
+        sendrecv_data[i].assign(first, first + scratch.recv_counts[i]);
+        first += scratch.recv_counts[i];
+      }
+      staging.trim();
+    }
+
+    // === sparse data exchange ===
+    /// Sends messages with a variable amount of data to a data-dependent set of processes and
+    /// receives the messages that other processes send to this process, without knowing the
+    /// senders in advance.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \tparam A allocator of the containers
+    /// \param send_data map from destination ranks to the data to send to them
+    /// \param t tag associated to all messages of the exchange
+    /// \return list of source ranks and the data received from them in the order of arrival
+    /// \details The exchange implements the non-blocking consensus algorithm: all messages
+    /// are sent via non-blocking synchronous sends, incoming messages are received via
+    /// matching probes.  A process enters a non-blocking barrier when all its sends have been
+    /// received, the exchange ends when the barrier has completed.  The work per process is
+    /// proportional to the number of its communication partners, not to the number of
+    /// processes.
+    /// \throw invalid_count if a received message does not hold a whole number of elements
+    /// of type \c T, the message is discarded
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.  As messages with tag \c t from any process are received, no other
+    /// messages with this tag must be sent via this communicator during the exchange.  A
+    /// subsequent exchange on the same communicator must use another tag unless the
+    /// processes synchronize in between.
+    template<typename T, typename A>
+    std::vector<std::pair<int, std::vector<T, A>>> sparse_exchange(
+        const std::map<int, std::vector<T, A>>& send_data, tag_t t) const {
+      return sparse_exchange(send_data, t, busy_wait{});
+    }
+
+    /// Sends messages with a variable amount of data to a data-dependent set of processes and
+    /// receives the messages that other processes send to this process, without knowing the
+    /// senders in advance, the waiting thread behaves as given by a wait policy.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \tparam A allocator of the containers
+    /// \tparam P type of the wait policy, see \c irequest::wait
+    /// \param send_data map from destination ranks to the data to send to them
+    /// \param t tag associated to all messages of the exchange
+    /// \param policy the wait policy, applied while no message arrives
+    /// \return list of source ranks and the data received from them in the order of arrival
+    /// \details See the overload without wait policy.
+    /// \throw invalid_count if a received message does not hold a whole number of elements
+    /// of type \c T, the message is discarded
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.  As messages with tag \c t from any process are received, no other
+    /// messages with this tag must be sent via this communicator during the exchange.
+    template<typename T, typename A, typename P,
+             typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+    std::vector<std::pair<int, std::vector<T, A>>> sparse_exchange(
+        const std::map<int, std::vector<T, A>>& send_data, tag_t t, const P& policy) const {
+      check_send_tag(t);
+      irequest_pool sends;
+      for (const auto& [destination, data] : send_data) {
+        check_dest(destination);
+        sends.push(issend(data.data(), vector_layout<T>(data.size()), destination, t));
+      }
+      std::vector<std::pair<int, std::vector<T, A>>> recv_data;
+      std::optional<irequest> barrier;
+      auto waiter{policy.make_waiter()};
+      while (true) {
+        waiter.polling_loop_begin();
+        if (barrier) {
+          if (barrier->test())
+            break;
+        } else if (sends.testall())
+          barrier = ibarrier();
+        if (auto m{improbe(any_source, t)}) {
+          const int count{m->status.template get_count<T>()};
+          if (count == MPI_UNDEFINED) {
+            // the message is received and discarded, such that its send operation completes
+            std::vector<char> bytes(m->status.template get_count<char>());
+            mrecv(bytes.data(), vector_layout<char>(bytes.size()), m->message);
+            throw invalid_count();
+          }
+          std::vector<T, A> data(count);
+          mrecv(data.data(), vector_layout<T>(data.size()), m->message);
+          recv_data.emplace_back(m->status.source(), std::move(data));
+        } else
+          waiter.polling_loop_end();
+      }
+      waiter.completed();
+      return recv_data;
+    }
+
+    // === sparse all-to-all ===
+  private:
+    // the automatic schedule of a sparse all-to-all exchange uses a single collective
+    // operation if any process exchanges data with more than this fraction of all processes
+    static constexpr int sparse_alltoallv_dense_fraction{4};
+
+    template<typename T>
+    static T* displaced(T* data, MPI_Aint displacement) {
+      return data + displacement;
+    }
+
+    // expands sparse layouts into the argument arrays of MPI_Alltoallw, processes without an
+    // entry exchange zero bytes, displacements that cannot be passed as int values are moved
+    // into new data types
+    template<typename T>
+    ialltoallv_resources sparse_alltoallv_resources(const sparse_layouts<T>& sendls,
+                                                    const sparse_layouts<T>& recvls) const {
+      ialltoallv_resources resources;
+      const auto expand{[this, &resources](const sparse_layouts<T>& ls,
+                                           std::vector<int>& counts, std::vector<int>& displs,
+                                           std::vector<MPI_Datatype>& types) {
+        counts.assign(size(), 0);
+        displs.assign(size(), 0);
+        types.assign(size(), MPI_BYTE);
+        for (const auto& e : ls) {
+#if defined MPLR_DEBUG
+          if (e.rank < 0 or e.rank >= size())
+            throw invalid_rank();
+#endif
+          counts[e.rank] = 1;
+          types[e.rank] = detail::datatype_traits<layout<T>>::get_datatype(e.l);
+          const MPI_Aint displ{e.displacement * static_cast<MPI_Aint>(sizeof(T))};
+          if (detail::fits_int_count(displ))
+            displs[e.rank] = static_cast<int>(displ);
+          else {
+            MPI_Datatype displaced_type;
+            MPI_Type_create_hindexed_block(1, 1, &displ, types[e.rank], &displaced_type);
+            resources.displaced_types.push_back(
+                detail::shared_datatype::commit(displaced_type));
+            types[e.rank] = resources.displaced_types.back().get();
+          }
+        }
+      }};
+      expand(sendls, resources.sendcounts, resources.senddispls, resources.sendtypes);
+      expand(recvls, resources.recvcounts, resources.recvdispls, resources.recvtypes);
+      return resources;
+    }
+
+    template<typename T>
+    void sparse_alltoallv_post(irequest_pool& requests, const T* send_data,
+                               const sparse_layouts<T>& sendls, T* recv_data,
+                               const sparse_layouts<T>& recvls, tag_t t) const {
+      for (const auto& e : recvls)
+        requests.push(irecv(displaced(recv_data, e.displacement), e.l, e.rank, t));
+      for (const auto& e : sendls)
+        requests.push(isend(displaced(send_data, e.displacement), e.l, e.rank, t));
+    }
+
+  public:
+    /// Sends messages with a variable amount of data to some processes and receives messages
+    /// with a variable amount of data from some processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param send_data pointer to continuous storage for outgoing messages
+    /// \param sendls ranks, memory layouts and displacements of the data to send
+    /// \param recv_data pointer to continuous storage for incoming messages
+    /// \param recvls ranks, memory layouts and displacements of the data to receive
+    /// \param t tag associated to all messages of the exchange if they are sent via
+    /// point-to-point messages, must be given explicitly as it must not be used by other
+    /// messages
+    /// \param schedule how the exchange is carried out, must be the same at all processes
+    /// \details Each entry of \c sendls describes the data that is sent to a single process,
+    /// each entry of \c recvls describes the data that is received from a single process.  A
+    /// process must have an entry for a partner in \c recvls if and only if the partner has
+    /// an entry for this process in \c sendls, the type signatures of both layouts must
+    /// match.  No data is exchanged with processes without an entry.  With a point-to-point
+    /// schedule, the work per process is proportional to the number of its entries, not to
+    /// the number of processes.  The automatic schedule falls back to \c MPI_Alltoallw if
+    /// any process exchanges data with more than a quarter of all processes.
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.  No other messages with tag \c t must be sent via this communicator
+    /// during the exchange.
+    template<typename T>
+    void alltoallv(const T* send_data, const sparse_layouts<T>& sendls, T* recv_data,
+                   const sparse_layouts<T>& recvls, tag_t t,
+                   sparse_schedule schedule = sparse_schedule::automatic) const {
+      check_send_tag(t);
+      if (schedule == sparse_schedule::automatic) {
+        int partners{static_cast<int>(std::max(sendls.size(), recvls.size()))};
+        MPI_Allreduce(MPI_IN_PLACE, &partners, 1, MPI_INT, MPI_MAX, comm_);
+        schedule = partners > size() / sparse_alltoallv_dense_fraction
+                       ? sparse_schedule::collective
+                       : sparse_schedule::point_to_point;
+      }
+      if (schedule == sparse_schedule::collective) {
+        const auto resources{sparse_alltoallv_resources(sendls, recvls)};
+        MPI_Alltoallw(send_data, resources.sendcounts.data(), resources.senddispls.data(),
+                      resources.sendtypes.data(), recv_data, resources.recvcounts.data(),
+                      resources.recvdispls.data(), resources.recvtypes.data(), comm_);
+      } else {
+        irequest_pool requests;
+        sparse_alltoallv_post(requests, send_data, sendls, recv_data, recvls, t);
+        requests.waitall();
+      }
+    }
+
+    /// Sends messages with a variable amount of data to some processes and receives messages
+    /// with a variable amount of data from some processes in a non-blocking manner via
+    /// point-to-point messages.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param send_data pointer to continuous storage for outgoing messages
+    /// \param sendls ranks, memory layouts and displacements of the data to send
+    /// \param recv_data pointer to continuous storage for incoming messages
+    /// \param recvls ranks, memory layouts and displacements of the data to receive
+    /// \param t tag associated to all messages of the exchange, must be given explicitly as
+    /// it must not be used by other messages
+    /// \return pool of requests representing the ongoing message transfers, one request for
+    /// each entry of \c recvls followed by one request for each entry of \c sendls
+    /// \details See the blocking variant for the meaning of the layouts.  The work per process
+    /// is proportional to the number of its entries, not to the number of processes.
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.  No other messages with tag \c t must be sent via this communicator
+    /// before the exchange has completed.
+    template<typename T>
+    irequest_pool ialltoallv(const T* send_data, const sparse_layouts<T>& sendls, T* recv_data,
+                             const sparse_layouts<T>& recvls, tag_t t) const {
+      check_send_tag(t);
+      irequest_pool requests;
+      sparse_alltoallv_post(requests, send_data, sendls, recv_data, recvls, t);
+      return requests;
+    }
+
     // === reduce ===
     using base::reduce;
     using base::ireduce;
@@ -5479,6 +7537,9 @@ namespace mplr {
     explicit inter_communicator(MPI_Comm comm) : base{comm} {
     }
 
+    explicit inter_communicator(MPI_Comm comm, non_owning_tag t) : base{comm, t} {
+    }
+
   public:
     /// Creates a new inter-communicator from two existing communicators.
     /// \param local_communicator communicator that contains the local group of the new
@@ -5497,6 +7558,7 @@ namespace mplr {
         : base{} {
       MPI_Intercomm_create(local_communicator.comm_, local_leader, peer_communicator.comm_,
                            remote_leader, static_cast<int>(t), &comm_);
+      update_descriptor();
     }
 
     /// Creates a new inter-communicator which is equivalent to an existing one.
@@ -5619,6 +7681,7 @@ namespace mplr {
       : base{} {
     const int high{order == merge_order_type::order_high};
     MPI_Intercomm_merge(other.comm_, high, &comm_);
+    update_descriptor();
   }
 
   inline inter_communicator communicator::spawn(int root_rank, int max_procs,
@@ -5853,7 +7916,7 @@ namespace mplr {
   public:
     /// Creates a new communicator from an MPI communicator.
     /// \param comm MPI communicator that will be wrapped
-    explicit mpi_communicator(MPI_Comm comm) : communicator{comm} {
+    explicit mpi_communicator(MPI_Comm comm) : communicator{comm, non_owning_tag{}} {
     }
 
     mpi_communicator(const mpi_communicator& other) = delete;
@@ -5862,11 +7925,6 @@ namespace mplr {
     /// \param other the other communicator to move from
     mpi_communicator(mpi_communicator&& other) noexcept = default;
 
-    /// Destructor.
-    ~mpi_communicator() {
-      comm_ = MPI_COMM_NULL;
-    }
-
     mpi_communicator& operator=(const mpi_communicator& other) = delete;
 
     /// Move-assigns a communicator.
@@ -5887,7 +7945,8 @@ namespace mplr {
   public:
     /// Creates a new inter-communicator form an MPI communicator.
     /// \param comm MPI inter-communicator that will be wrapped
-    explicit mpi_inter_communicator(MPI_Comm comm) : inter_communicator{comm} {
+    explicit mpi_inter_communicator(MPI_Comm comm)
+        : inter_communicator{comm, non_owning_tag{}} {
     }
 
     mpi_inter_communicator(const mpi_communicator& other) = delete;
@@ -5896,11 +7955,6 @@ namespace mplr {
     /// \param other the other inter-communicator to move from
     mpi_inter_communicator(mpi_inter_communicator&& other) noexcept = default;
 
-    /// Destructor.
-    ~mpi_inter_communicator() {
-      comm_ = MPI_COMM_NULL;
-    }
-
     mpi_inter_communicator& operator=(const mpi_inter_communicator& other) = delete;
 
     /// Move-assigns an inter-communicator.
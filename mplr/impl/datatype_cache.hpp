@@ -0,0 +1,227 @@
+#if !(defined MPLR_DATATYPE_CACHE_HPP)
+
+#define MPLR_DATATYPE_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace mplr {
+
+  /// Counters of the data type cache.
+  struct datatype_cache_statistics {
+    /// number of layouts whose data type was found in the cache
+    std::size_t hits{0};
+    /// number of layouts whose data type was created and inserted into the cache
+    std::size_t misses{0};
+    /// number of data types that were removed from the cache because it was full
+    std::size_t evictions{0};
+  };
+
+  namespace detail {
+
+    // constructors of layouts whose data types may be cached
+    enum class cached_layout_kind : int {
+      contiguous,
+      strided_vector,
+      indexed,
+      hindexed,
+      indexed_block,
+      hindexed_block,
+      subarray
+    };
+
+    // identifies a data type by the kind of the layout, the data type of the layout's
+    // elements and the parameters of the layout's constructor
+    struct datatype_cache_key {
+      cached_layout_kind kind;
+      MPI_Datatype base;
+      std::vector<long long> parameters;
+
+      bool operator==(const datatype_cache_key& other) const {
+        return kind == other.kind and base == other.base and parameters == other.parameters;
+      }
+    };
+
+    struct datatype_cache_key_hash {
+      std::size_t operator()(const datatype_cache_key& key) const {
+        std::size_t hash{std::hash<int>{}(static_cast<int>(key.kind))};
+        const auto combine{[&hash](std::size_t value) {
+          hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        }};
+        combine(std::hash<MPI_Datatype>{}(key.base));
+        for (auto parameter : key.parameters)
+          combine(std::hash<long long>{}(parameter));
+        return hash;
+      }
+    };
+
+    template<typename T, typename P, typename B>
+    shared_datatype cached_datatype(cached_layout_kind kind, P&& make_parameters, B&& build);
+
+  }  // namespace detail
+
+  /// Process-wide cache of committed MPI data types of layouts.  When the cache is enabled,
+  /// constructing a layout of one of the classes \c contiguous_layout, \c vector_layout,
+  /// \c strided_vector_layout, \c indexed_layout, \c hindexed_layout,
+  /// \c indexed_block_layout, \c hindexed_block_layout or \c subarray_layout for the
+  /// elements' own data type looks up a previously committed data type with the same
+  /// construction parameters instead of creating and committing a new one.  The least
+  /// recently used data type is evicted when the cache is full.  Layouts share the cached
+  /// data types, thus a cache hit neither creates nor duplicates a data type.
+  /// \note The cache is disabled by default.  Layouts that are built on top of other layouts
+  /// are never cached.  Evicting a data type does not affect existing layouts.
+  class datatype_cache {
+    using key = detail::datatype_cache_key;
+
+    struct entry {
+      detail::shared_datatype type;
+      std::list<const key*>::iterator lru;
+    };
+
+    std::mutex mutex_;
+    std::atomic<bool> enabled_{false};
+    std::size_t capacity_{0};
+    std::unordered_map<key, entry, detail::datatype_cache_key_hash> entries_;
+    // most recently used entries first
+    std::list<const key*> lru_;
+    datatype_cache_statistics statistics_;
+
+    datatype_cache() = default;
+
+    // the cache is never destroyed, cached data types are freed when the environment is
+    // finalized, which may happen after the destruction of static objects
+    static datatype_cache& instance() {
+      static auto* cache{new datatype_cache};
+      return *cache;
+    }
+
+    void free_all() {
+      entries_.clear();
+      lru_.clear();
+    }
+
+    void evict() {
+      while (entries_.size() > capacity_) {
+        const auto i{entries_.find(*lru_.back())};
+        lru_.pop_back();
+        entries_.erase(i);
+        ++statistics_.evictions;
+      }
+    }
+
+    // returns a handle of the cached data type for the given key, build is invoked to create
+    // a committed data type on a cache miss
+    template<typename B>
+    detail::shared_datatype get(key&& k, B&& build) {
+      std::lock_guard lock{mutex_};
+      auto i{entries_.find(k)};
+      if (i != entries_.end()) {
+        ++statistics_.hits;
+        lru_.splice(lru_.begin(), lru_, i->second.lru);
+        return i->second.type;
+      }
+      ++statistics_.misses;
+      detail::shared_datatype type{build()};
+      if (capacity_ == 0)
+        return type;
+      i = entries_.emplace(std::move(k), entry{type, lru_.end()}).first;
+      lru_.push_front(&i->first);
+      i->second.lru = lru_.begin();
+      evict();
+      return type;
+    }
+
+  public:
+    /// Enables the cache.
+    /// \param capacity maximal number of cached data types
+    /// \note Data types that exceed a reduced capacity are evicted.
+    static void enable(std::size_t capacity = 1024) {
+      auto& cache{instance()};
+      std::lock_guard lock{cache.mutex_};
+      cache.capacity_ = capacity;
+      cache.evict();
+      cache.enabled_ = true;
+    }
+
+    /// Disables the cache and releases all cached data types.
+    static void disable() {
+      auto& cache{instance()};
+      std::lock_guard lock{cache.mutex_};
+      cache.enabled_ = false;
+      cache.free_all();
+    }
+
+    /// \return true if the cache is enabled
+    [[nodiscard]] static bool enabled() {
+      return instance().enabled_;
+    }
+
+    /// \return maximal number of cached data types
+    [[nodiscard]] static std::size_t capacity() {
+      auto& cache{instance()};
+      std::lock_guard lock{cache.mutex_};
+      return cache.capacity_;
+    }
+
+    /// \return number of cached data types
+    [[nodiscard]] static std::size_t size() {
+      auto& cache{instance()};
+      std::lock_guard lock{cache.mutex_};
+      return cache.entries_.size();
+    }
+
+    /// \return counters of cache hits, misses and evictions
+    [[nodiscard]] static datatype_cache_statistics statistics() {
+      auto& cache{instance()};
+      std::lock_guard lock{cache.mutex_};
+      return cache.statistics_;
+    }
+
+    /// Resets the counters of cache hits, misses and evictions.
+    static void reset_statistics() {
+      auto& cache{instance()};
+      std::lock_guard lock{cache.mutex_};
+      cache.statistics_ = datatype_cache_statistics{};
+    }
+
+    /// Releases all cached data types, data types that are still used by layouts are freed
+    /// when the last of these layouts is destroyed.
+    /// \note This function is called implicitly when the environment is finalized.
+    static void clear() {
+      auto& cache{instance()};
+      std::lock_guard lock{cache.mutex_};
+      cache.free_all();
+    }
+
+    template<typename T, typename P, typename B>
+    friend detail::shared_datatype detail::cached_datatype(detail::cached_layout_kind kind,
+                                                           P&& make_parameters, B&& build);
+  };
+
+  namespace detail {
+
+    // creates the committed data type of a layout via build if the cache is disabled,
+    // otherwise looks up the data type in the cache, make_parameters is only invoked if the
+    // cache is enabled
+    template<typename T, typename P, typename B>
+    shared_datatype cached_datatype(cached_layout_kind kind, P&& make_parameters, B&& build) {
+      auto& cache{datatype_cache::instance()};
+      if (not cache.enabled_.load(std::memory_order_relaxed))
+        return build();
+      return cache.get(datatype_cache_key{kind, datatype_traits<T>::get_datatype(),
+                                          make_parameters()},
+                       std::forward<B>(build));
+    }
+
+  }  // namespace detail
+
+}  // namespace mplr
+
+#endif
@@ -136,6 +136,7 @@ namespace mplr {
                                      source_weights.data(), destinations.size(),
                                      destinations_vector.data(), destination_weights.data(),
                                      MPI_INFO_NULL, reorder, &comm_);
+      update_descriptor();
     }
 
     distributed_graph_communicator& operator=(const distributed_graph_communicator& other) =
@@ -75,6 +75,7 @@ namespace mplr {
   namespace detail {
 
     inline void finalize() {
+      datatype_cache::clear();
       MPI_Finalize();
     }
 
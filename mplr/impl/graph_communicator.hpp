@@ -159,6 +159,7 @@ namespace mplr {
       }
       std::partial_sum(index.begin(), index.end(), index.begin());
       MPI_Graph_create(other.comm_, nodes, index.data(), edges_list.data(), reorder, &comm_);
+      update_descriptor();
     }
 
     graph_communicator& operator=(const graph_communicator& other) = delete;
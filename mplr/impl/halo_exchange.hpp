@@ -0,0 +1,163 @@
+#if !(defined MPLR_HALO_EXCHANGE_HPP)
+
+#define MPLR_HALO_EXCHANGE_HPP
+
+#include "mplr/impl/cartesian_communicator.hpp"
+#include "mplr/impl/comm_group.hpp"
+#include "mplr/impl/distributed_grid.hpp"
+#include "mplr/impl/layout.hpp"
+#include "mplr/impl/request.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+
+namespace mplr {
+
+  /// Persistent plan for a fixed set of point-to-point exchanges, which are repeated many
+  /// times with the same buffers, e.g., the exchange of overlap data in stencil codes.  Each
+  /// exchange is set up once as a pair of persistent send and receive requests.  Starting and
+  /// completing the plan avoids setting up requests and looking up datatypes in every
+  /// iteration.
+  /// \note The plan refers to the memory of the buffers given when adding exchanges.  These
+  /// buffers must not be reallocated or freed while the plan is in use.
+  class halo_exchange {
+    prequest_pool requests_;
+
+  public:
+    /// Type used for the number of requests.
+    using size_type = prequest_pool::size_type;
+
+    /// Creates an empty plan.
+    halo_exchange() = default;
+
+    /// Creates a plan that updates the overlap data of a distributed grid from the neighboring
+    /// processes in all dimensions.
+    /// \tparam dim number of dimensions of the data grid
+    /// \tparam T data type that is hold at each grid point
+    /// \tparam A memory allocator
+    /// \param comm Cartesian communicator the distributed grid has been created with
+    /// \param grid the distributed grid
+    /// \param t tag associated to all messages of the plan
+    /// \note The plan refers to the underlying storage of the grid.  This storage is passed
+    /// on by \c distributed_grid::swap, i.e., after swapping two grids the plan updates the
+    /// grid it has not been created for.
+    template<std::size_t dim, typename T, typename A>
+    halo_exchange(const cartesian_communicator& comm, distributed_grid<dim, T, A>& grid,
+                  tag_t t = tag_t{0}) {
+      for (std::size_t i{0}; i < dim; ++i) {
+        // send to left
+        auto ranks{comm.shift(i, -1)};
+        add(comm, grid.data(), grid.left_border_layout(i), ranks.destination, grid.data(),
+            grid.right_mirror_layout(i), ranks.source, t);
+        // send to right
+        ranks = comm.shift(i, +1);
+        add(comm, grid.data(), grid.right_border_layout(i), ranks.destination, grid.data(),
+            grid.left_mirror_layout(i), ranks.source, t);
+      }
+    }
+
+    /// Deleted copy constructor.
+    halo_exchange(const halo_exchange&) = delete;
+
+    /// Move constructor.
+    /// \param other the plan to move from
+    halo_exchange(halo_exchange&& other) noexcept = default;
+
+    /// Deleted copy operator.
+    halo_exchange& operator=(const halo_exchange&) = delete;
+
+    /// Move operator.
+    /// \param other the plan to move from
+    /// \return reference to the moved-to plan
+    halo_exchange& operator=(halo_exchange&& other) noexcept = default;
+
+    /// Adds an exchange, i.e., a send and a receive operation with possibly different
+    /// partners, to the plan.
+    /// \tparam T type of the data to send and to receive, must meet the requirements as
+    /// described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param comm communicator used for the exchange
+    /// \param send_data pointer to the data to send
+    /// \param send_l memory layout of the data to send
+    /// \param destination rank of the receiving process, may be <tt>\ref proc_null</tt>
+    /// \param recv_data pointer to the data to receive
+    /// \param recv_l memory layout of the data to receive
+    /// \param source rank of the sending process, may be <tt>\ref proc_null</tt>
+    /// \param t tag associated to both messages
+    /// \note Send and receive buffers must not overlap.
+    template<typename T>
+    void add(const impl::base_communicator& comm, const T* send_data, const layout<T>& send_l,
+             int destination, T* recv_data, const layout<T>& recv_l, int source,
+             tag_t t = tag_t{0}) {
+      requests_.push(comm.recv_init(recv_data, recv_l, source, t));
+      requests_.push(comm.send_init(send_data, send_l, destination, t));
+    }
+
+    /// \return number of persistent requests of the plan, two per exchange
+    [[nodiscard]] size_type size() const {
+      return requests_.size();
+    }
+
+    /// \return true if the plan holds no exchanges
+    [[nodiscard]] bool empty() const {
+      return requests_.empty();
+    }
+
+    /// Starts all exchanges of the plan.
+    void start() {
+      requests_.startall();
+    }
+
+    /// Waits until all exchanges of the plan have finished.
+    void wait() {
+      requests_.waitall();
+    }
+
+    /// Waits via lazy spinning until all exchanges of the plan have finished.
+    /// \param duty_ratio duty ratio of wait
+    void wait(duty_ratio duty_ratio) {
+      requests_.waitall(duty_ratio);
+    }
+
+    /// Waits until all exchanges of the plan have finished, the waiting thread behaves as
+    /// given by a wait policy.
+    /// \tparam P type of the wait policy, see \c prequest::wait
+    /// \param policy the wait policy
+    template<typename P, typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+    void wait(const P& policy) {
+      requests_.waitall(policy);
+    }
+
+    /// Tests if all exchanges of the plan have finished.
+    /// \return true if all exchanges have finished
+    bool test() {
+      return requests_.testall();
+    }
+
+    /// Starts all exchanges of the plan and waits until they have finished.
+    void exchange() {
+      start();
+      wait();
+    }
+
+    /// Starts all exchanges of the plan and waits via lazy spinning until they have finished.
+    /// \param duty_ratio duty ratio of wait
+    void exchange(duty_ratio duty_ratio) {
+      start();
+      wait(duty_ratio);
+    }
+
+    /// Starts all exchanges of the plan and waits until they have finished, the waiting
+    /// thread behaves as given by a wait policy.
+    /// \tparam P type of the wait policy, see \c prequest::wait
+    /// \param policy the wait policy
+    template<typename P, typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+    void exchange(const P& policy) {
+      start();
+      wait(policy);
+    }
+  };
+
+}  // namespace mplr
+
+#endif
@@ -0,0 +1,328 @@
+#if !(defined MPLR_HIERARCHICAL_COMMUNICATOR_HPP)
+
+#define MPLR_HIERARCHICAL_COMMUNICATOR_HPP
+
+#include "mplr/impl/comm_group.hpp"
+#include "mplr/impl/error.hpp"
+#include "mplr/impl/layout.hpp"
+#include "mplr/impl/operator.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace mplr {
+
+  /// Carries out collective operations in two levels, first among the processes of each
+  /// node, i.e., of each group of processes that can create a shared memory region, and then
+  /// among a single leader process per node.  Reductions and gathers combine the data within
+  /// each node before the leaders exchange the combined data, broadcasts send the data once
+  /// to each node, thus only one message per node crosses the network instead of one message
+  /// per process.  The node communicator and the leader communicator are created once at
+  /// construction and are reused by all operations.
+  /// \note The hierarchical communicator communicates via a duplicate of the communicator
+  /// given at construction, thus its messages never interfere with other messages.  A
+  /// reduction with an operation that is not commutative is carried out in two levels only if
+  /// each node holds processes with consecutive ranks, otherwise it falls back to a single
+  /// reduction over all processes.
+  class hierarchical_communicator {
+    communicator comm_;
+    communicator node_;
+    // valid at the leaders only, the leader of a node is its process with node rank 0
+    communicator leaders_;
+    // for each rank of comm_: index of its node, i.e., the rank of the node's leader in
+    // leaders_, and its rank within its node
+    std::vector<int> node_index_;
+    std::vector<int> node_rank_;
+    // for each node: number of processes of all nodes with a smaller node index
+    std::vector<int> node_offset_;
+    // true if the processes of each node have consecutive ranks in comm_
+    bool consecutive_{true};
+
+    void init() {
+      leaders_ =
+          communicator(communicator::split, comm_, node_.rank() == 0 ? 0 : MPI_UNDEFINED);
+      int index{leaders_.is_valid() ? leaders_.rank() : 0};
+      node_.bcast(0, index);
+      node_index_.resize(comm_.size());
+      node_rank_.resize(comm_.size());
+      comm_.allgather(index, node_index_.data());
+      comm_.allgather(node_.rank(), node_rank_.data());
+      node_offset_.assign(*std::max_element(node_index_.begin(), node_index_.end()) + 2, 0);
+      for (const auto i : node_index_)
+        ++node_offset_[i + 1];
+      for (std::size_t i{1}; i < node_offset_.size(); ++i)
+        node_offset_[i] += node_offset_[i - 1];
+      for (int i{0}; i < comm_.size(); ++i)
+        if (node_offset_[node_index_[i]] + node_rank_[i] != i)
+          consecutive_ = false;
+    }
+
+    [[nodiscard]] bool is_leader() const {
+      return node_.rank() == 0;
+    }
+
+    // reductions over two levels combine the data in the order of the nodes, which equals the
+    // order of ranks only if all nodes hold consecutive ranks
+    template<typename T, typename F>
+    [[nodiscard]] bool reduces_in_two_levels() const {
+      return consecutive_ or detail::op<T, std::decay_t<F>>::is_commutative;
+    }
+
+    void check_root([[maybe_unused]] int root_rank) const {
+#if defined MPLR_DEBUG
+      if (root_rank < 0 or root_rank >= size())
+        throw invalid_rank();
+#endif
+    }
+
+    // broadcasts within the root's node and among the leaders and then within all other
+    // nodes, args are the arguments of communicator::bcast following the root's rank
+    template<typename... Args>
+    void bcast_in_two_levels(int root_rank, Args&&... args) const {
+      check_root(root_rank);
+      const int root_node{node_index_[root_rank]};
+      // the root's node starts if the root is not the leader of its node
+      const bool root_node_first{node_index_[rank()] == root_node and
+                                 node_rank_[root_rank] != 0};
+      if (root_node_first)
+        node_.bcast(node_rank_[root_rank], args...);
+      if (is_leader())
+        leaders_.bcast(root_node, args...);
+      if (not root_node_first)
+        node_.bcast(0, args...);
+    }
+
+    // gathers n elements from each process into recv_data at the root
+    template<typename T>
+    void gather_blocks(int root_rank, const T* send_data, int n, T* recv_data) const {
+      check_root(root_rank);
+      const contiguous_layout<T> l(n);
+      if (not is_leader()) {
+        node_.gather(0, send_data, l);
+        if (rank() == root_rank)
+          node_.recv(recv_data, contiguous_layout<T>(static_cast<std::size_t>(size()) * n),
+                     0);
+        return;
+      }
+      std::vector<T> node_data(static_cast<std::size_t>(node_.size()) * n);
+      node_.gather(0, send_data, l, node_data.data(), l);
+      const int root_node{node_index_[root_rank]};
+      const contiguous_layout<T> node_l(node_data.size());
+      if (leaders_.rank() != root_node) {
+        leaders_.gatherv(root_node, node_data.data(), node_l);
+        return;
+      }
+      contiguous_layouts<T> ls;
+      displacements displs;
+      for (std::size_t i{0}; i + 1 < node_offset_.size(); ++i) {
+        ls.push_back(contiguous_layout<T>(
+            static_cast<std::size_t>(node_offset_[i + 1] - node_offset_[i]) * n));
+        displs.push_back(static_cast<MPI_Aint>(node_offset_[i]) * n);
+      }
+      const bool root_is_leader{rank() == root_rank};
+      std::vector<T> gathered;
+      if (not(root_is_leader and consecutive_))
+        gathered.resize(static_cast<std::size_t>(size()) * n);
+      T* const leaders_data{root_is_leader and consecutive_ ? recv_data : gathered.data()};
+      leaders_.gatherv(root_node, node_data.data(), node_l, leaders_data, ls, displs);
+      if (not consecutive_) {
+        // reorder blocks from the order of nodes to the order of ranks
+        std::vector<T> ordered(gathered.size());
+        for (int i{0}; i < size(); ++i) {
+          const std::ptrdiff_t j{node_offset_[node_index_[i]] + node_rank_[i]};
+          std::copy_n(gathered.begin() + j * n, n, ordered.begin() + std::ptrdiff_t{i} * n);
+        }
+        gathered = std::move(ordered);
+      }
+      if (root_is_leader) {
+        if (not consecutive_)
+          std::copy(gathered.begin(), gathered.end(), recv_data);
+      } else
+        node_.send(gathered.data(), contiguous_layout<T>(gathered.size()),
+                   node_rank_[root_rank]);
+    }
+
+  public:
+    /// Creates a hierarchical communicator whose nodes are the groups of processes that can
+    /// create a shared memory region.
+    /// \param comm communicator whose processes take part in the collective operations
+    /// \note This is a collective operation that needs to be carried out by all processes of
+    /// the communicator \c comm.
+    explicit hierarchical_communicator(const communicator& comm)
+        : comm_{comm, info{}}, node_{communicator::split_shared_memory, comm_} {
+      init();
+    }
+
+    /// Creates a hierarchical communicator whose nodes are given by the processes' colors,
+    /// e.g., to group the processes by sockets or to emulate several nodes on a single node.
+    /// \tparam color_type color type, must be integral type
+    /// \param split tag to indicate the mode of construction
+    /// \param comm communicator whose processes take part in the collective operations
+    /// \param color processes with the same color belong to the same node
+    /// \note This is a collective operation that needs to be carried out by all processes of
+    /// the communicator \c comm.
+    template<typename color_type>
+    hierarchical_communicator([[maybe_unused]] communicator::split_tag split,
+                              const communicator& comm, color_type color)
+        : comm_{comm, info{}}, node_{communicator::split, comm_, color} {
+      init();
+    }
+
+    hierarchical_communicator(const hierarchical_communicator&) = delete;
+    hierarchical_communicator& operator=(const hierarchical_communicator&) = delete;
+
+    /// Move constructor.
+    /// \param other the hierarchical communicator to move from
+    hierarchical_communicator(hierarchical_communicator&& other) noexcept = default;
+
+    /// Move operator.
+    /// \param other the hierarchical communicator to move from
+    /// \return reference to the moved-to hierarchical communicator
+    hierarchical_communicator& operator=(hierarchical_communicator&& other) noexcept = default;
+
+    /// \return number of processes
+    [[nodiscard]] int size() const {
+      return comm_.size();
+    }
+
+    /// \return rank of the calling process, equals its rank in the communicator given at
+    /// construction
+    [[nodiscard]] int rank() const {
+      return comm_.rank();
+    }
+
+    /// \return number of nodes
+    [[nodiscard]] int node_count() const {
+      return static_cast<int>(node_offset_.size()) - 1;
+    }
+
+    /// \return communicator of the processes of the calling process's node
+    [[nodiscard]] const communicator& node_communicator() const {
+      return node_;
+    }
+
+    /// \return communicator of the node leaders, an invalid communicator at processes that
+    /// are not the leader of their node
+    [[nodiscard]] const communicator& leader_communicator() const {
+      return leaders_;
+    }
+
+    // === broadcast ===
+    /// Broadcasts a message from a process to all other processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param root_rank rank of the sending process
+    /// \param data buffer for sending/receiving data
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.
+    template<typename T>
+    void bcast(int root_rank, T& data) const {
+      bcast_in_two_levels(root_rank, data);
+    }
+
+    /// Broadcasts a message from a process to all other processes.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param root_rank rank of the sending process
+    /// \param data buffer for sending/receiving data
+    /// \param l memory layout of the data to send/receive
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.
+    template<typename T>
+    void bcast(int root_rank, T* data, const layout<T>& l) const {
+      bcast_in_two_levels(root_rank, data, l);
+    }
+
+    // === gather ===
+    /// Gather messages from all processes at a single root process.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param root_rank rank of the receiving process
+    /// \param send_data data to send
+    /// \param recv_data pointer to continuous storage for incoming messages, may be a null
+    /// pointer at non-root processes
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.
+    template<typename T>
+    void gather(int root_rank, const T& send_data, T* recv_data) const {
+      gather_blocks(root_rank, &send_data, 1, recv_data);
+    }
+
+    /// Gather messages from all processes at a single root process.
+    /// \tparam T type of the data to send, must meet the requirements as described in the
+    /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+    /// \param root_rank rank of the receiving process
+    /// \param send_data data buffer for sending data
+    /// \param l memory layout of the data to send, all processes must send the same number of
+    /// elements
+    /// \param recv_data pointer to continuous storage for incoming messages, may be a null
+    /// pointer at non-root processes
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.
+    template<typename T>
+    void gather(int root_rank, const T* send_data, const contiguous_layout<T>& l,
+                T* recv_data) const {
+      gather_blocks(root_rank, send_data, static_cast<int>(l.size()), recv_data);
+    }
+
+    // === all-reduce ===
+    /// Performs a reduction operation over all processes and broadcasts the result.
+    /// \tparam F type representing the reduction operation, reduction operation is performed
+    /// on data of type \c T
+    /// \tparam T type of input and output data of the reduction operation, must meet the
+    /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+    /// section
+    /// \param f reduction operation
+    /// \param send_data input data for the reduction operation
+    /// \param recv_data will hold the result of the reduction operation
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.
+    template<typename T, typename F>
+    void allreduce(F&& f, const T& send_data, T& recv_data) const {
+      if (not reduces_in_two_levels<T, F>()) {
+        comm_.allreduce(std::forward<F>(f), send_data, recv_data);
+        return;
+      }
+      if (is_leader()) {
+        node_.reduce(f, 0, send_data, recv_data);
+        leaders_.allreduce(f, recv_data);
+      } else
+        node_.reduce(f, 0, send_data);
+      node_.bcast(0, recv_data);
+    }
+
+    /// Performs a reduction operation over all processes and broadcasts the result.
+    /// \tparam F type representing the element-wise reduction operation, reduction operation is
+    /// performed on data of type \c T
+    /// \tparam T type of input and output data of the reduction operation, must meet the
+    /// requirements as described in the \verbatim embed:rst:inline :doc:`data_types` \endverbatim
+    /// section
+    /// \param f reduction operation
+    /// \param send_data input buffer for the reduction operation
+    /// \param recv_data will hold the results of the reduction operation
+    /// \param l memory layouts of the data to send and to receive
+    /// \note This is a collective operation and must be called by all processes in the
+    /// communicator.
+    template<typename T, typename F>
+    void allreduce(F&& f, const T* send_data, T* recv_data,
+                   const contiguous_layout<T>& l) const {
+      if (not reduces_in_two_levels<T, F>()) {
+        comm_.allreduce(std::forward<F>(f), send_data, recv_data, l);
+        return;
+      }
+      if (is_leader()) {
+        node_.reduce(f, 0, send_data, recv_data, l);
+        leaders_.allreduce(f, recv_data, l);
+      } else
+        node_.reduce(f, 0, send_data, l);
+      node_.bcast(0, recv_data, l);
+    }
+  };
+
+}  // namespace mplr
+
+#endif
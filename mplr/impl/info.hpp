@@ -12,6 +12,9 @@ namespace mplr {
     class base_communicator;
   }
 
+  template<typename T>
+  class window;
+
   /// Stores key-value pairs to affect specific as well as implementation defined MPI
   /// functionalities.
   class info {
@@ -143,6 +146,8 @@ namespace mplr {
     friend class impl::base_communicator;
     friend class communicator;
     friend class file;
+    template<typename T>
+    friend class window;
   };
 
 
@@ -0,0 +1,38 @@
+#if !(defined MPLR_LARGE_COUNT_HPP)
+
+#define MPLR_LARGE_COUNT_HPP
+
+#include <limits>
+
+
+// counts and displacements that exceed this limit are not passed to MPI functions as values of
+// type int, may be reduced to exercise the large-count code paths with small messages
+#if !(defined MPLR_LARGE_COUNT_LIMIT)
+#define MPLR_LARGE_COUNT_LIMIT 2147483647
+#endif
+
+
+namespace mplr {
+
+  namespace detail {
+
+    inline constexpr MPI_Aint large_count_limit{MPLR_LARGE_COUNT_LIMIT};
+
+    static_assert(large_count_limit > 0 and
+                      large_count_limit <= std::numeric_limits<int>::max(),
+                  "MPLR_LARGE_COUNT_LIMIT must be a positive value of type int");
+
+    // true if the count or displacement can be passed to MPI functions as an int value
+    template<typename I>
+    constexpr bool fits_int_count(I value) {
+      if constexpr (std::numeric_limits<I>::is_signed)
+        return value >= -large_count_limit and value <= large_count_limit;
+      else
+        return value <= static_cast<unsigned long long>(large_count_limit);
+    }
+
+  }  // namespace detail
+
+}  // namespace mplr
+
+#endif
@@ -7,6 +7,7 @@
 #include <initializer_list>
 #include <iterator>
 #include <limits>
+#include <optional>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -71,6 +72,47 @@ namespace mplr {
 
   }  // namespace impl
 
+  namespace detail {
+
+    // accumulates the blocks of a layout in the order of the layout's type map and determines
+    // whether the blocks form a single sequence of consecutive elements
+    class contiguous_span_builder {
+      MPI_Aint extent_{0};
+      MPI_Aint end_{0};
+      contiguous_span span_;
+      bool contiguous_{true};
+
+    public:
+      explicit contiguous_span_builder(MPI_Datatype element_type) {
+        MPI_Aint lb;
+        MPI_Type_get_extent(element_type, &lb, &extent_);
+      }
+
+      [[nodiscard]] MPI_Aint extent() const {
+        return extent_;
+      }
+
+      // appends a block of elements, the displacement is given in bytes
+      void add(MPI_Aint blocklength, MPI_Aint byte_displacement) {
+        if (blocklength <= 0)
+          return;
+        if (span_.count == 0)
+          span_.byte_offset = byte_displacement;
+        else if (byte_displacement != end_)
+          contiguous_ = false;
+        span_.count += blocklength;
+        end_ = byte_displacement + blocklength * extent_;
+      }
+
+      [[nodiscard]] std::optional<contiguous_span> span() const {
+        if (not contiguous_)
+          return {};
+        return span_;
+      }
+    };
+
+  }  // namespace detail
+
   //--------------------------------------------------------------------
 
   /// Base class for a family of classes that describe where objects are located in
@@ -79,12 +121,15 @@ namespace mplr {
   template<typename T>
   class layout {
   private:
-    MPI_Datatype type_{MPI_DATATYPE_NULL};
+    detail::shared_datatype type_;
 
   protected:
-    explicit layout(MPI_Datatype new_type) : type_{new_type} {
-      if (type_ != MPI_DATATYPE_NULL)
-        MPI_Type_commit(&type_);
+    explicit layout(MPI_Datatype new_type,
+                    const std::optional<detail::contiguous_span>& span = {})
+        : type_{detail::shared_datatype::commit(new_type, span)} {
+    }
+
+    explicit layout(detail::shared_datatype type) noexcept : type_{std::move(type)} {
     }
 
   public:
@@ -94,43 +139,26 @@ namespace mplr {
     /// Copy constructor creates a new layout that describes the same memory layout as
     /// the other one.
     /// \param l the layout to copy from
-    layout(const layout& l) {
-      if (l.type_ != MPI_DATATYPE_NULL)
-        MPI_Type_dup(l.type_, &type_);
-    }
+    /// \note Copies of a layout share the underlying MPI data type, which is freed when the
+    /// last layout that refers to it is destroyed.  Copying a layout neither allocates memory
+    /// nor calls MPI.
+    layout(const layout& l) noexcept = default;
 
     /// Move constructor creates a new layout that describes the same memory layout as
     /// the other one.
     /// \param l the layout to move from
-    layout(layout&& l) noexcept : type_{l.type_} {
-      l.type_ = MPI_DATATYPE_NULL;
-    }
+    layout(layout&& l) noexcept = default;
 
     /// Copy assignment operator creates a new layout that describes the same memory
     /// layout as the other one.
     /// \param l the layout to copy from
-    layout& operator=(const layout& l) {
-      if (this != &l) {
-        if (type_ != MPI_DATATYPE_NULL)
-          MPI_Type_free(&type_);
-        if (l.type_ != MPI_DATATYPE_NULL)
-          MPI_Type_dup(l.type_, &type_);
-        else
-          type_ = MPI_DATATYPE_NULL;
-      }
-      return *this;
-    }
+    /// \note Copies of a layout share the underlying MPI data type.
+    layout& operator=(const layout& l) noexcept = default;
 
     /// Move assignment operator creates a new layout that describes the same memory
     /// layout as the other one.
     /// \param l the layout to move from
-    layout& operator=(layout&& l) noexcept {
-      if (type_ != MPI_DATATYPE_NULL)
-        MPI_Type_free(&type_);
-      type_ = l.type_;
-      l.type_ = MPI_DATATYPE_NULL;
-      return *this;
-    }
+    layout& operator=(layout&& l) noexcept = default;
 
     /// Get the underlying MPI handle of the data type.
     /// \return MPI handle of the data type
@@ -139,7 +167,19 @@ namespace mplr {
     /// \warning The handle must not be used to modify the MPI data type that the handle points
     /// to.
     [[nodiscard]] MPI_Datatype native_handle() const {
-      return type_;
+      return type_.get();
+    }
+
+    /// Determine whether the layout refers to consecutive objects.
+    /// \return true if the layout describes a single sequence of consecutive objects in
+    /// increasing order, which may start at an offset
+    /// \note Contiguity is determined from the parameters when the layout is constructed.
+    /// Layouts that are built on top of other layouts and heterogeneous layouts are
+    /// conservatively considered as non-contiguous.  Data with a contiguous layout is
+    /// transferred by point-to-point operations and broadcasts as a plain sequence of
+    /// elements, bypassing the layout's derived data type.
+    [[nodiscard]] bool is_contiguous() const {
+      return type_.span() != nullptr;
     }
 
     /// Get the byte extent of the layout.
@@ -149,7 +189,7 @@ namespace mplr {
     /// \see \c extent
     [[nodiscard]] ssize_t byte_extent() const {
       MPI_Aint lb_, extent_;
-      MPI_Type_get_extent(type_, &lb_, &extent_);
+      MPI_Type_get_extent(type_.get(), &lb_, &extent_);
       if (lb_ == MPI_UNDEFINED or extent_ == MPI_UNDEFINED)
         throw invalid_datatype_bound();
       return extent_;
@@ -162,7 +202,7 @@ namespace mplr {
     /// \see \c byte_upper_bound, \c lower_bound
     [[nodiscard]] ssize_t byte_lower_bound() const {
       MPI_Aint lb_, extent_;
-      MPI_Type_get_extent(type_, &lb_, &extent_);
+      MPI_Type_get_extent(type_.get(), &lb_, &extent_);
       if (lb_ == MPI_UNDEFINED or extent_ == MPI_UNDEFINED)
         throw invalid_datatype_bound();
       return lb_;
@@ -175,7 +215,7 @@ namespace mplr {
     /// \see \c byte_lower_bound, \c upper_bound
     [[nodiscard]] ssize_t byte_upper_bound() const {
       MPI_Aint lb_, extent_;
-      MPI_Type_get_extent(type_, &lb_, &extent_);
+      MPI_Type_get_extent(type_.get(), &lb_, &extent_);
       if (lb_ == MPI_UNDEFINED or extent_ == MPI_UNDEFINED)
         throw invalid_datatype_bound();
       return extent_ - lb_;
@@ -227,7 +267,7 @@ namespace mplr {
     /// \see \c true_extent
     [[nodiscard]] ssize_t true_byte_extent() const {
       MPI_Aint lb_, extent_;
-      MPI_Type_get_true_extent(type_, &lb_, &extent_);
+      MPI_Type_get_true_extent(type_.get(), &lb_, &extent_);
       if (lb_ == MPI_UNDEFINED or extent_ == MPI_UNDEFINED)
         throw invalid_datatype_bound();
       return extent_;
@@ -240,7 +280,7 @@ namespace mplr {
     /// \see \c true_byte_upper_bound, \c true_lower_bound
     [[nodiscard]] ssize_t true_byte_lower_bound() const {
       MPI_Aint lb_, extent_;
-      MPI_Type_get_true_extent(type_, &lb_, &extent_);
+      MPI_Type_get_true_extent(type_.get(), &lb_, &extent_);
       if (lb_ == MPI_UNDEFINED or extent_ == MPI_UNDEFINED)
         throw invalid_datatype_bound();
       return lb_;
@@ -253,7 +293,7 @@ namespace mplr {
     /// \see \c true_byte_lower_bound, \c true_upper_bound
     [[nodiscard]] ssize_t true_byte_upper_bound() const {
       MPI_Aint lb_, extent_;
-      MPI_Type_get_true_extent(type_, &lb_, &extent_);
+      MPI_Type_get_true_extent(type_.get(), &lb_, &extent_);
       if (lb_ == MPI_UNDEFINED or extent_ == MPI_UNDEFINED)
         throw invalid_datatype_bound();
       return extent_ - lb_;
@@ -302,12 +342,15 @@ namespace mplr {
     /// \param lb the layout's new true byte lower bound
     /// \param extent the layout's new true byte extent
     void byte_resize(ssize_t lb, ssize_t extent) {
-      if (type_ != MPI_DATATYPE_NULL) {
+      if (type_.get() != MPI_DATATYPE_NULL) {
         MPI_Datatype newtype;
-        MPI_Type_create_resized(type_, lb, extent, &newtype);
-        MPI_Type_commit(&newtype);
-        MPI_Type_free(&type_);
-        type_ = newtype;
+        MPI_Type_create_resized(type_.get(), lb, extent, &newtype);
+        // resizing does not affect where the elements of a single layout are located, other
+        // layouts that share the old data type are not affected
+        std::optional<detail::contiguous_span> span;
+        if (type_.span() != nullptr)
+          span = *type_.span();
+        type_ = detail::shared_datatype::commit(newtype, span);
       }
     }
 
@@ -323,13 +366,7 @@ namespace mplr {
     /// Swap with other layout.
     /// \param l other layout
     void swap(layout& l) noexcept {
-      std::swap(type_, l.type_);
-    }
-
-    /// Destroy layout.
-    ~layout() {
-      if (type_ != MPI_DATATYPE_NULL)
-        MPI_Type_free(&type_);
+      type_.swap(l.type_);
     }
 
     friend class detail::datatype_traits<layout>;
@@ -418,7 +455,7 @@ namespace mplr {
 
   public:
     /// default constructor
-    empty_layout() : layout<T>(build()) {
+    empty_layout() : layout<T>(build(), detail::contiguous_span{}) {
     }
 
     /// copy constructor
@@ -444,7 +481,7 @@ namespace mplr {
     /// exchanges two empty layouts
     /// \param other the layout to swap with
     void swap(empty_layout& other) noexcept {
-      std::swap(type_, other.type_);
+      type_.swap(other.type_);
     }
 
     using layout<T>::byte_extent;
@@ -501,10 +538,21 @@ namespace mplr {
       return count_;
     }
 
+    static detail::shared_datatype build_cached(std::size_t count) {
+      return detail::cached_datatype<T>(
+          detail::cached_layout_kind::contiguous,
+          [count]() { return std::vector<long long>{static_cast<long long>(count)}; },
+          [count]() {
+            return detail::shared_datatype::commit(
+                build(count), detail::contiguous_span{0, static_cast<MPI_Aint>(count)});
+          });
+    }
+
   public:
     /// constructs layout for contiguous storage several objects of type T
     /// \param count number of objects
-    explicit contiguous_layout(std::size_t count = 0) : layout<T>(build(count)), count_(count) {
+    explicit contiguous_layout(std::size_t count = 0)
+        : layout<T>(build_cached(count)), count_(count) {
     }
 
     /// constructs layout for data with memory layout that is a homogenous sequence of
@@ -512,7 +560,7 @@ namespace mplr {
     /// \param count number of layouts in sequence
     /// \param l the layout of a single element
     explicit contiguous_layout(std::size_t count, const contiguous_layout& l)
-        : layout<T>(build(count, l.type_)), count_(l.count_ * count) {
+        : layout<T>(build(count, l.type_.get())), count_(l.count_ * count) {
     }
 
     /// copy constructor
@@ -553,7 +601,7 @@ namespace mplr {
     /// exchanges two contiguous layouts
     /// \param other the layout to swap with
     void swap(contiguous_layout& other) noexcept {
-      std::swap(type_, other.type_);
+      type_.swap(other.type_);
       std::swap(count_, other.count_);
     }
 
@@ -567,6 +615,7 @@ namespace mplr {
     friend class impl::base_communicator;
     friend class communicator;
     friend class inter_communicator;
+    friend class hierarchical_communicator;
     friend class contiguous_layouts<T>;
   };
 
@@ -610,10 +659,20 @@ namespace mplr {
       return new_type;
     }
 
+    static detail::shared_datatype build_cached(std::size_t count) {
+      return detail::cached_datatype<T>(
+          detail::cached_layout_kind::contiguous,
+          [count]() { return std::vector<long long>{static_cast<long long>(count)}; },
+          [count]() {
+            return detail::shared_datatype::commit(
+                build(count), detail::contiguous_span{0, static_cast<MPI_Aint>(count)});
+          });
+    }
+
   public:
     /// constructs layout for contiguous storage several objects of type T
     /// \param count number of objects
-    explicit vector_layout(std::size_t count = 0) : layout<T>(build(count)) {
+    explicit vector_layout(std::size_t count = 0) : layout<T>(build_cached(count)) {
     }
 
     /// constructs layout for data with memory layout that is a homogenous sequence of some
@@ -621,7 +680,7 @@ namespace mplr {
     /// \param count number of layouts in sequence
     /// \param l the layout of a single element
     explicit vector_layout(std::size_t count, const layout<T>& l)
-        : layout<T>(build(count, l.type_)) {
+        : layout<T>(build(count, l.type_.get())) {
     }
 
     /// copy constructor
@@ -647,7 +706,7 @@ namespace mplr {
     /// exchanges two contiguous layouts
     /// \param other the layout to swap with
     void swap(vector_layout& other) noexcept {
-      std::swap(type_, other.type_);
+      type_.swap(other.type_);
     }
 
     using layout<T>::byte_extent;
@@ -684,9 +743,28 @@ namespace mplr {
       return new_type;
     }
 
+    static detail::shared_datatype build_cached(int count, int blocklength, int stride) {
+      return detail::cached_datatype<T>(
+          detail::cached_layout_kind::strided_vector,
+          [=]() { return std::vector<long long>{count, blocklength, stride}; },
+          [=]() {
+            return detail::shared_datatype::commit(build(count, blocklength, stride),
+                                                   span(count, blocklength, stride));
+          });
+    }
+
+    static std::optional<detail::contiguous_span> span(int count, int blocklength,
+                                                       int stride) {
+      if (count <= 0 or blocklength <= 0)
+        return detail::contiguous_span{};
+      if (count > 1 and blocklength != stride)
+        return {};
+      return detail::contiguous_span{0, static_cast<MPI_Aint>(count) * blocklength};
+    }
+
   public:
     /// constructs a layout with no data
-    strided_vector_layout() : layout<T>(build()) {
+    strided_vector_layout() : layout<T>(build(), detail::contiguous_span{}) {
     }
 
     /// constructs a layout with several strided objects of type T
@@ -694,7 +772,7 @@ namespace mplr {
     /// \param blocklength number of data elements in each block (non-negative)
     /// \param stride number or elements between start of each block
     explicit strided_vector_layout(int count, int blocklength, int stride)
-        : layout<T>(build(count, blocklength, stride)) {
+        : layout<T>(build_cached(count, blocklength, stride)) {
     }
 
     /// constructs a layout with several strided objects of some other layout
@@ -704,7 +782,7 @@ namespace mplr {
     /// size given by the extend of the layout given by parameter \c l
     /// \param l the layout of a single element in each block
     explicit strided_vector_layout(int count, int blocklength, int stride, const layout<T>& l)
-        : layout<T>(build(count, blocklength, stride, l.type_)) {
+        : layout<T>(build(count, blocklength, stride, l.type_.get())) {
     }
 
     /// copy constructor
@@ -730,7 +808,7 @@ namespace mplr {
     /// exchanges two contiguous layouts
     /// \param other the layout to swap with
     void swap(strided_vector_layout& other) noexcept {
-      std::swap(type_, other.type_);
+      type_.swap(other.type_);
     }
 
     using layout<T>::byte_extent;
@@ -809,21 +887,42 @@ namespace mplr {
       return new_type;
     }
 
+    static detail::shared_datatype build_cached(const parameter& par) {
+      return detail::cached_datatype<T>(
+          detail::cached_layout_kind::indexed,
+          [&par]() {
+            std::vector<long long> parameters;
+            parameters.insert(parameters.end(), par.blocklengths.begin(),
+                              par.blocklengths.end());
+            parameters.insert(parameters.end(), par.displacements.begin(),
+                              par.displacements.end());
+            return parameters;
+          },
+          [&par]() { return detail::shared_datatype::commit(build(par), span(par)); });
+    }
+
+    static std::optional<detail::contiguous_span> span(const parameter& par) {
+      detail::contiguous_span_builder builder{detail::datatype_traits<T>::get_datatype()};
+      for (std::size_t i{0}; i < par.displacements.size(); ++i)
+        builder.add(par.blocklengths[i], par.displacements[i] * builder.extent());
+      return builder.span();
+    }
+
   public:
     /// constructs a layout with no data
-    indexed_layout() : layout<T>(build()) {
+    indexed_layout() : layout<T>(build(), detail::contiguous_span{}) {
     }
 
     /// constructs indexed layout for data of type \c T
     /// \param par parameter containing information about the layout
-    explicit indexed_layout(const parameter& par) : layout<T>(build(par)) {
+    explicit indexed_layout(const parameter& par) : layout<T>(build_cached(par)) {
     }
 
     /// constructs indexed layout for data with some other layout
     /// \param par parameter containing information about the layout
     /// \param l the layout of a single element
     explicit indexed_layout(const parameter& par, const layout<T>& l)
-        : layout<T>(build(par, l.type_)) {
+        : layout<T>(build(par, l.type_.get())) {
     }
 
     /// copy constructor
@@ -849,7 +948,7 @@ namespace mplr {
     /// exchanges two indexed layouts
     /// \param other the layout to swap with
     void swap(indexed_layout& other) noexcept {
-      std::swap(type_, other.type_);
+      type_.swap(other.type_);
     }
 
     using layout<T>::byte_extent;
@@ -934,15 +1033,36 @@ namespace mplr {
       return new_type;
     }
 
+    static detail::shared_datatype build_cached(const parameter& par) {
+      return detail::cached_datatype<T>(
+          detail::cached_layout_kind::hindexed,
+          [&par]() {
+            std::vector<long long> parameters;
+            parameters.insert(parameters.end(), par.blocklengths.begin(),
+                              par.blocklengths.end());
+            parameters.insert(parameters.end(), par.displacements.begin(),
+                              par.displacements.end());
+            return parameters;
+          },
+          [&par]() { return detail::shared_datatype::commit(build(par), span(par)); });
+    }
+
+    static std::optional<detail::contiguous_span> span(const parameter& par) {
+      detail::contiguous_span_builder builder{detail::datatype_traits<T>::get_datatype()};
+      for (std::size_t i{0}; i < par.displacements.size(); ++i)
+        builder.add(par.blocklengths[i], par.displacements[i]);
+      return builder.span();
+    }
+
   public:
     /// constructs a layout with no data
-    hindexed_layout() : layout<T>(build()) {
+    hindexed_layout() : layout<T>(build(), detail::contiguous_span{}) {
     }
 
     /// constructs heterogeneously indexed layout for data of type \c T
     /// \param par parameter containing information about the layout
     /// \note displacements are given in bytes
-    explicit hindexed_layout(const parameter& par) : layout<T>(build(par)) {
+    explicit hindexed_layout(const parameter& par) : layout<T>(build_cached(par)) {
     }
 
     /// constructs heterogeneously indexed layout for data with some other layout
@@ -950,7 +1070,7 @@ namespace mplr {
     /// \param l the layout of a single element
     /// \note displacements are given bytes
     explicit hindexed_layout(const parameter& par, const layout<T>& l)
-        : layout<T>(build(par, l.type_)) {
+        : layout<T>(build(par, l.type_.get())) {
     }
 
     /// copy constructor
@@ -976,7 +1096,7 @@ namespace mplr {
     /// exchanges two indexed layouts
     /// \param other the layout to swap with
     void swap(hindexed_layout& other) noexcept {
-      std::swap(type_, other.type_);
+      type_.swap(other.type_);
     }
 
     using layout<T>::byte_extent;
@@ -1050,9 +1170,31 @@ namespace mplr {
       return new_type;
     }
 
+    static detail::shared_datatype build_cached(int blocklength, const parameter& par) {
+      return detail::cached_datatype<T>(
+          detail::cached_layout_kind::indexed_block,
+          [blocklength, &par]() {
+            std::vector<long long> parameters{blocklength};
+            parameters.insert(parameters.end(), par.displacements.begin(),
+                              par.displacements.end());
+            return parameters;
+          },
+          [blocklength, &par]() {
+            return detail::shared_datatype::commit(build(blocklength, par),
+                                                   span(blocklength, par));
+          });
+    }
+
+    static std::optional<detail::contiguous_span> span(int blocklength, const parameter& par) {
+      detail::contiguous_span_builder builder{detail::datatype_traits<T>::get_datatype()};
+      for (const auto displacement : par.displacements)
+        builder.add(blocklength, displacement * builder.extent());
+      return builder.span();
+    }
+
   public:
     /// constructs a layout with no data
-    indexed_block_layout() : layout<T>(build()) {
+    indexed_block_layout() : layout<T>(build(), detail::contiguous_span{}) {
     }
 
     /// constructs indexed layout for data of type T
@@ -1060,7 +1202,7 @@ namespace mplr {
     /// \param par parameter containing information about the layout
     /// \note displacements are given in multiples of the extent of \c T
     explicit indexed_block_layout(int blocklength, const parameter& par)
-        : layout<T>(build(blocklength, par)) {
+        : layout<T>(build_cached(blocklength, par)) {
     }
 
     /// constructs indexed layout for data with some other layout
@@ -1069,7 +1211,7 @@ namespace mplr {
     /// \param l the layout of a single element
     /// \note displacements are given in multiples of the extent of \c l
     explicit indexed_block_layout(int blocklength, const parameter& par, const layout<T>& l)
-        : layout<T>(build(blocklength, par, l.type_)) {
+        : layout<T>(build(blocklength, par, l.type_.get())) {
     }
 
     /// copy constructor
@@ -1095,7 +1237,7 @@ namespace mplr {
     /// exchanges two indexed layouts
     /// \param other the layout to swap with
     void swap(indexed_block_layout& other) noexcept {
-      std::swap(type_, other.type_);
+      type_.swap(other.type_);
     }
 
     using layout<T>::byte_extent;
@@ -1174,9 +1316,31 @@ namespace mplr {
       return new_type;
     }
 
+    static detail::shared_datatype build_cached(int blocklength, const parameter& par) {
+      return detail::cached_datatype<T>(
+          detail::cached_layout_kind::hindexed_block,
+          [blocklength, &par]() {
+            std::vector<long long> parameters{blocklength};
+            parameters.insert(parameters.end(), par.displacements.begin(),
+                              par.displacements.end());
+            return parameters;
+          },
+          [blocklength, &par]() {
+            return detail::shared_datatype::commit(build(blocklength, par),
+                                                   span(blocklength, par));
+          });
+    }
+
+    static std::optional<detail::contiguous_span> span(int blocklength, const parameter& par) {
+      detail::contiguous_span_builder builder{detail::datatype_traits<T>::get_datatype()};
+      for (const auto displacement : par.displacements)
+        builder.add(blocklength, displacement);
+      return builder.span();
+    }
+
   public:
     /// constructs a layout with no data
-    hindexed_block_layout() : layout<T>(build()) {
+    hindexed_block_layout() : layout<T>(build(), detail::contiguous_span{}) {
     }
 
     /// constructs heterogeneously indexed layout for data of type T
@@ -1184,7 +1348,7 @@ namespace mplr {
     /// \param par parameter containing information about the layout
     /// \note displacements are given in bytes
     explicit hindexed_block_layout(int blocklength, const parameter& par)
-        : layout<T>(build(blocklength, par)) {
+        : layout<T>(build_cached(blocklength, par)) {
     }
 
     /// constructs heterogeneously indexed layout for data with some other layout
@@ -1193,7 +1357,7 @@ namespace mplr {
     /// \param l the layout of a single element
     /// \note displacements are given bytes
     explicit hindexed_block_layout(int blocklength, const parameter& par, const layout<T>& l)
-        : layout<T>(build(blocklength, par, l.type_)) {
+        : layout<T>(build(blocklength, par, l.type_.get())) {
     }
 
     /// copy constructor
@@ -1219,7 +1383,7 @@ namespace mplr {
     /// exchanges two indexed layouts
     /// \param other the layout to swap with
     void swap(hindexed_block_layout& other) noexcept {
-      std::swap(type_, other.type_);
+      type_.swap(other.type_);
     }
 
     using layout<T>::byte_extent;
@@ -1250,27 +1414,6 @@ namespace mplr {
       std::vector<MPI_Aint> displacements;
       std::vector<int> blocklengths;
 
-      template<typename value_T>
-      void add(value_T& base, value_T*& i, MPI_Aint extent_) {
-        add(reinterpret_cast<char*>(&i) - reinterpret_cast<char*>(&base), extent_);
-      }
-
-      template<typename value_T>
-      void add(const value_T& base, const value_T& i, MPI_Aint extent_) {
-        add(reinterpret_cast<const char*>(&i) - reinterpret_cast<const char*>(&base), extent_);
-      }
-
-      void add(MPI_Aint displacement, MPI_Aint extent_) {
-        if ((not displacements.empty()) and
-            displacements.back() + blocklengths.back() * extent_ == displacement and
-            blocklengths.back() < std::numeric_limits<int>::max())
-          blocklengths.back()++;
-        else {
-          displacements.push_back(displacement);
-          blocklengths.push_back(1);
-        }
-      }
-
     public:
       /// creates parameters for an iterator layout representing an empty sequence
       parameter() = default;
@@ -1285,8 +1428,32 @@ namespace mplr {
         MPI_Type_get_extent(detail::datatype_traits<T>::get_datatype(), &lb_, &extent_);
         if (lb_ == MPI_UNDEFINED or extent_ == MPI_UNDEFINED)
           throw invalid_datatype_bound();
-        for (iter_T i = first; i != last; ++i)
-          add(*first, *i, extent_);
+        if (first == last)
+          return;
+        // elements at adjacent addresses are merged into a single block, the current block
+        // is kept in local variables as this loop is executed once per element
+        const char* base{reinterpret_cast<const char*>(&*first)};
+        MPI_Aint block_begin{0};
+        MPI_Aint block_end{0};
+        int block_length{0};
+        for (iter_T i = first; i != last; ++i) {
+          const MPI_Aint displacement{reinterpret_cast<const char*>(&*i) - base};
+          if (displacement == block_end and block_length > 0 and
+              block_length < std::numeric_limits<int>::max()) {
+            ++block_length;
+            block_end += extent_;
+          } else {
+            if (block_length > 0) {
+              displacements.push_back(block_begin);
+              blocklengths.push_back(block_length);
+            }
+            block_begin = displacement;
+            block_end = displacement + extent_;
+            block_length = 1;
+          }
+        }
+        displacements.push_back(block_begin);
+        blocklengths.push_back(block_length);
       }
 
       friend class iterator_layout;
@@ -1313,9 +1480,16 @@ namespace mplr {
       return new_type;
     }
 
+    static std::optional<detail::contiguous_span> span(const parameter& par) {
+      detail::contiguous_span_builder builder{detail::datatype_traits<T>::get_datatype()};
+      for (std::size_t i{0}; i < par.displacements.size(); ++i)
+        builder.add(par.blocklengths[i], par.displacements[i]);
+      return builder.span();
+    }
+
   public:
     /// constructs a layout with no data
-    iterator_layout() : layout<T>(build()) {
+    iterator_layout() : layout<T>(build(), detail::contiguous_span{}) {
     }
 
     /// constructs iterator layout for data of type T
@@ -1324,12 +1498,12 @@ namespace mplr {
     /// \param last iterator pointing after the last element
     template<typename iter_T>
     explicit iterator_layout(iter_T first, iter_T last)
-        : layout<T>(build(parameter(first, last))) {
+        : iterator_layout(parameter(first, last)) {
     }
 
     /// constructs iterator layout for data of type T
     /// \param par parameter containing information about the layout
-    explicit iterator_layout(const parameter& par) : layout<T>(build(par)) {
+    explicit iterator_layout(const parameter& par) : layout<T>(build(par), span(par)) {
     }
 
     /// constructs iterator layout for data with some other layout
@@ -1339,14 +1513,14 @@ namespace mplr {
     /// \param l the layout of a single element
     template<typename iter_T>
     explicit iterator_layout(iter_T first, iter_T last, const layout<T>& l)
-        : layout<T>(build(parameter(first, last), l.type_)) {
+        : layout<T>(build(parameter(first, last), l.type_.get())) {
     }
 
     /// constructs iterator layout for data with some other layout
     /// \param par parameter containing information about the layout
     /// \param l the layout of a single element
     explicit iterator_layout(const parameter& par, const layout<T>& l)
-        : layout<T>(build(par, l.type_)) {
+        : layout<T>(build(par, l.type_.get())) {
     }
 
     /// copy constructor
@@ -1372,7 +1546,7 @@ namespace mplr {
     /// exchanges two iterator layouts
     /// \param other the layout to swap with
     void swap(iterator_layout& other) noexcept {
-      std::swap(type_, other.type_);
+      type_.swap(other.type_);
     }
 
     using layout<T>::byte_extent;
@@ -1487,21 +1661,60 @@ namespace mplr {
       return new_type;
     }
 
+    static detail::shared_datatype build_cached(const parameter& par) {
+      return detail::cached_datatype<T>(
+          detail::cached_layout_kind::subarray,
+          [&par]() {
+            std::vector<long long> parameters{static_cast<long long>(par.order())};
+            parameters.insert(parameters.end(), par.sizes.begin(), par.sizes.end());
+            parameters.insert(parameters.end(), par.subsizes.begin(), par.subsizes.end());
+            parameters.insert(parameters.end(), par.starts.begin(), par.starts.end());
+            return parameters;
+          },
+          [&par]() { return detail::shared_datatype::commit(build(par), span(par)); });
+    }
+
+    // a subarray is contiguous if it covers complete rows along all dimensions that vary
+    // faster than the first partially covered dimension and a single row along all slower
+    // dimensions
+    static std::optional<detail::contiguous_span> span(const parameter& par) {
+      const std::size_t dims{par.sizes.size()};
+      if (dims == 0)
+        return {};
+      for (const int subsize : par.subsizes)
+        if (subsize <= 0)
+          return detail::contiguous_span{};
+      MPI_Aint count{1}, offset{0}, stride{1};
+      bool partial{false};
+      for (std::size_t j{0}; j < dims; ++j) {
+        const std::size_t i{par.order() == array_orders::C_order ? dims - 1 - j : j};
+        if (partial and par.subsizes[i] != 1)
+          return {};
+        partial = partial or par.subsizes[i] != par.sizes[i];
+        count *= par.subsizes[i];
+        offset += par.starts[i] * stride;
+        stride *= par.sizes[i];
+      }
+      detail::contiguous_span_builder builder{detail::datatype_traits<T>::get_datatype()};
+      builder.add(count, offset * builder.extent());
+      return builder.span();
+    }
+
   public:
     /// constructs a layout with no data
-    subarray_layout() : layout<T>(build()) {
+    subarray_layout() : layout<T>(build(), detail::contiguous_span{}) {
     }
 
     /// constructs subarray layout for data of type T
     /// \param par parameter containing information about the layout
-    explicit subarray_layout(const parameter& par) : layout<T>(build(par)) {
+    explicit subarray_layout(const parameter& par) : layout<T>(build_cached(par)) {
     }
 
     /// constructs subarray layout for data with some other layout
     /// \param par parameter containing information about the layout
     /// \param l the layout of a single element
     explicit subarray_layout(const parameter& par, const layout<T>& l)
-        : layout<T>(build(par, l.type_)) {
+        : layout<T>(build(par, l.type_.get())) {
     }
 
     /// copy constructor
@@ -1527,7 +1740,7 @@ namespace mplr {
     /// exchanges two subarray layouts
     /// \param other the layout to swap with
     void swap(subarray_layout& other) noexcept {
-      std::swap(type_, other.type_);
+      type_.swap(other.type_);
     }
 
     using layout<T>::byte_extent;
@@ -1703,7 +1916,7 @@ namespace mplr {
     /// exchanges two heterogeneous layouts
     /// \param other the layout to swap with
     void swap(heterogeneous_layout& other) noexcept {
-      std::swap(type_, other.type_);
+      type_.swap(other.type_);
     }
 
     using layout<void>::byte_extent;
@@ -1725,7 +1938,7 @@ namespace mplr {
   /// \c heterogeneous_layout class
   template<typename T>
   absolute_data<T*> make_absolute(T* x, const layout<T>& l) {
-    return absolute_data<T*>{x, l.type_};
+    return absolute_data<T*>{x, l.type_.get()};
   }
 
   /// Helper function for the class heterogeneous_layout.
@@ -1736,7 +1949,7 @@ namespace mplr {
   /// \c heterogeneous_layout class
   template<typename T>
   absolute_data<const T*> make_absolute(const T* x, const layout<T>& l) {
-    return absolute_data<const T*>{x, l.type_};
+    return absolute_data<const T*>{x, l.type_.get()};
   }
 
   //--------------------------------------------------------------------
@@ -1746,10 +1959,42 @@ namespace mplr {
     template<typename T>
     struct datatype_traits<layout<T>> {
       static MPI_Datatype get_datatype(const layout<T>& l) {
-        return l.type_;
+        return l.type_.get();
+      }
+
+      static const contiguous_span* get_contiguous_span(const layout<T>& l) {
+        return l.type_.span();
       }
     };
 
+    // buffer, count and data type arguments of an MPI communication function
+    template<typename V>
+    struct layout_buffer {
+      V* data;
+      int count;
+      MPI_Datatype type;
+    };
+
+    // describes data with a given layout as arguments of an MPI communication function, data
+    // with a contiguous layout is described by a count of elements of the layout's base type
+    // such that the MPI library does not need to process the layout's derived data type,
+    // the type signature is the same in both cases
+    template<typename T>
+    auto make_layout_buffer(T* data, const layout<std::remove_const_t<T>>& l) {
+      using value_type = std::remove_const_t<T>;
+      using void_type = std::conditional_t<std::is_const_v<T>, const void, void>;
+      using byte_type = std::conditional_t<std::is_const_v<T>, const char, char>;
+      const MPI_Datatype type{datatype_traits<layout<value_type>>::get_datatype(l)};
+      if constexpr (not std::is_void_v<value_type>) {
+        const auto* span{datatype_traits<layout<value_type>>::get_contiguous_span(l)};
+        if (span != nullptr and fits_int_count(span->count))
+          return layout_buffer<void_type>{
+              reinterpret_cast<byte_type*>(data) + span->byte_offset,
+              static_cast<int>(span->count), datatype_traits<value_type>::get_datatype()};
+      }
+      return layout_buffer<void_type>{data, 1, type};
+    }
+
   }  // namespace detail
 
   //--------------------------------------------------------------------
@@ -1844,6 +2089,86 @@ namespace mplr {
     }
   };
 
+  //--------------------------------------------------------------------
+
+  /// container for storing the layouts of a sparse all-to-all exchange, stores one entry for
+  /// each process that data is exchanged with, no data is exchanged with processes without an
+  /// entry
+  /// \tparam T base element type of the layouts
+  template<typename T>
+  class sparse_layouts {
+  public:
+    /// the layout of the data exchanged with a single process
+    struct entry {
+      /// rank of the process
+      int rank;
+      /// memory layout of the data
+      layout<T> l;
+      /// displacement of the data in units of \c T
+      MPI_Aint displacement;
+    };
+
+  private:
+    std::vector<entry> entries_;
+
+  public:
+    /// type for index access
+    using size_type = typename std::vector<entry>::size_type;
+    /// iterator type for constant access
+    using const_iterator = typename std::vector<entry>::const_iterator;
+
+    /// constructs a layout container with no entries
+    sparse_layouts() = default;
+
+    /// adds an entry
+    /// \param rank rank of the process that data is exchanged with, each rank must not be
+    /// added more than once
+    /// \param l memory layout of the data
+    /// \param displacement displacement of the data in units of \c T relative to the address of
+    /// the buffer that is passed to the all-to-all operation, as for the displacements of the
+    /// all-to-all operations for \c layouts
+    void push_back(int rank, const layout<T>& l, MPI_Aint displacement = 0) {
+      entries_.push_back(entry{rank, l, displacement});
+    }
+
+    /// reserves storage for entries
+    /// \param n number of entries
+    void reserve(size_type n) {
+      entries_.reserve(n);
+    }
+
+    /// removes all entries
+    void clear() {
+      entries_.clear();
+    }
+
+    /// \return number of entries
+    [[nodiscard]] size_type size() const {
+      return entries_.size();
+    }
+
+    /// \return true if the container has no entries
+    [[nodiscard]] bool empty() const {
+      return entries_.empty();
+    }
+
+    /// \param i index of the entry
+    /// \return the i-th entry
+    const entry& operator[](size_type i) const {
+      return entries_[i];
+    }
+
+    /// \return iterator to the first entry
+    [[nodiscard]] const_iterator begin() const {
+      return entries_.begin();
+    }
+
+    /// \return iterator past the last entry
+    [[nodiscard]] const_iterator end() const {
+      return entries_.end();
+    }
+  };
+
 }  // namespace mplr
 
 #endif
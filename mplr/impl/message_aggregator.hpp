@@ -0,0 +1,268 @@
+#if !(defined MPLR_MESSAGE_AGGREGATOR_HPP)
+
+#define MPLR_MESSAGE_AGGREGATOR_HPP
+
+#include "mplr/impl/comm_group.hpp"
+#include "mplr/impl/environment.hpp"
+#include "mplr/impl/layout.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+
+namespace mplr {
+
+  /// Aggregates many small messages, which are sent to the same destination with the same
+  /// tag, into few large messages to amortize the per-message overhead of the MPI library.
+  /// Records are buffered per destination and tag.  A buffer is sent via a non-blocking
+  /// standard send operation when its size exceeds a threshold, when its oldest record
+  /// exceeds an age threshold or on an explicit call to \c flush.  Aggregated messages are
+  /// received as \c batch objects whose iterators refer to the receive buffer.
+  /// \tparam T type of the records, must meet the requirements as described in the
+  /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+  /// \note The aggregator communicates via a duplicate of the communicator given at
+  /// construction, thus its messages never interfere with other messages.  Records that are
+  /// sent by the same process to the same destination with the same tag are received in the
+  /// order in which they were pushed.
+  template<typename T>
+  class message_aggregator {
+    struct outbox {
+      tag_t tag;
+      std::vector<T> records;
+      double oldest{0};
+    };
+
+    struct pending_send {
+      std::vector<T> records;
+      irequest request;
+    };
+
+    communicator comm_;
+    std::size_t max_records_;
+    double max_delay_;
+    std::vector<std::vector<outbox>> outboxes_;
+    std::vector<pending_send> pending_;
+    std::vector<std::vector<T>> spare_buffers_;
+
+    outbox& get_outbox(int destination, tag_t t) {
+#if defined MPLR_DEBUG
+      if (destination < 0 or destination >= comm_.size())
+        throw invalid_rank();
+#endif
+      auto& boxes{outboxes_[destination]};
+      for (auto& box : boxes)
+        if (box.tag == t)
+          return box;
+      std::vector<T> records;
+      if (not spare_buffers_.empty()) {
+        records = std::move(spare_buffers_.back());
+        spare_buffers_.pop_back();
+      }
+      records.reserve(max_records_);
+      boxes.push_back({t, std::move(records), 0});
+      return boxes.back();
+    }
+
+    // sends the buffered records, the buffer is replaced by a recycled one
+    void send(outbox& box, int destination) {
+      pending_send send;
+      send.records.swap(box.records);
+      if (not spare_buffers_.empty()) {
+        box.records = std::move(spare_buffers_.back());
+        spare_buffers_.pop_back();
+      } else
+        box.records.reserve(max_records_);
+      const vector_layout<T> l(send.records.size());
+      send.request = comm_.isend(send.records.data(), l, destination, box.tag);
+      pending_.push_back(std::move(send));
+    }
+
+    // recycles the buffers of completed sends
+    void reclaim() {
+      auto completed{std::partition(pending_.begin(), pending_.end(), [](pending_send& send) {
+        return not send.request.test().has_value();
+      })};
+      for (auto i{completed}; i != pending_.end(); ++i) {
+        i->records.clear();
+        spare_buffers_.push_back(std::move(i->records));
+      }
+      pending_.erase(completed, pending_.end());
+    }
+
+  public:
+    /// Records received in a single aggregated message.
+    class batch {
+      std::vector<T> records_;
+      status_t status_;
+
+    public:
+      /// type of the received records
+      using value_type = T;
+      /// iterator type referring to the receive buffer
+      using const_iterator = const T*;
+      /// unsigned integer type for the number of records
+      using size_type = std::size_t;
+
+      /// \return iterator to the first record
+      [[nodiscard]] const_iterator begin() const {
+        return records_.data();
+      }
+
+      /// \return iterator pointing after the last record
+      [[nodiscard]] const_iterator end() const {
+        return records_.data() + records_.size();
+      }
+
+      /// \return number of records in the batch
+      [[nodiscard]] size_type size() const {
+        return records_.size();
+      }
+
+      /// \return true if the batch holds no records
+      [[nodiscard]] bool empty() const {
+        return records_.empty();
+      }
+
+      /// \param i index of the record
+      /// \return record with index i
+      const T& operator[](size_type i) const {
+        return records_[i];
+      }
+
+      /// \return status of the receive operation, which provides source and tag of the batch
+      [[nodiscard]] const status_t& status() const {
+        return status_;
+      }
+
+      friend class message_aggregator;
+    };
+
+    /// Creates a message aggregator.
+    /// \param comm communicator that is used to send and to receive aggregated messages
+    /// \param max_bytes buffers are sent as soon as they hold at least this number of bytes
+    /// \param max_delay buffers are sent as soon as their oldest record has been pushed at
+    /// least this number of seconds ago, by default there is no age threshold
+    /// \note The age threshold is checked when pushing records to a buffer and by \c poll.
+    /// This is a collective operation that needs to be carried out by all processes of the
+    /// communicator \c comm.
+    explicit message_aggregator(const communicator& comm, std::size_t max_bytes = 1 << 16,
+                                double max_delay = std::numeric_limits<double>::infinity())
+        : comm_{comm, info{}},
+          max_records_{std::max<std::size_t>(max_bytes / sizeof(T), 1)},
+          max_delay_{max_delay},
+          outboxes_(comm.size()) {
+    }
+
+    message_aggregator(const message_aggregator&) = delete;
+    message_aggregator& operator=(const message_aggregator&) = delete;
+
+    /// Sends all buffered records and waits until all sends have finished.
+    ~message_aggregator() {
+      flush();
+      for (auto& send : pending_)
+        send.request.wait();
+    }
+
+    /// Buffers a record for sending.  The buffer is sent when the size or the age threshold
+    /// has been reached.
+    /// \param record the record to send
+    /// \param destination rank of the receiving process
+    /// \param t tag associated to the aggregated message
+    void push(const T& record, int destination, tag_t t = tag_t{0}) {
+      outbox& box{get_outbox(destination, t)};
+      box.records.push_back(record);
+      bool expired{false};
+      if (max_delay_ != std::numeric_limits<double>::infinity()) {
+        const double now{wtime()};
+        if (box.records.size() == 1)
+          box.oldest = now;
+        else
+          expired = now - box.oldest >= max_delay_;
+      }
+      if (expired or box.records.size() >= max_records_) {
+        send(box, destination);
+        reclaim();
+      }
+    }
+
+    /// Sends all buffers that have exceeded the age threshold and recycles the buffers of
+    /// sends that have finished.
+    void poll() {
+      if (max_delay_ != std::numeric_limits<double>::infinity()) {
+        const double now{wtime()};
+        for (int destination{0}; destination < static_cast<int>(outboxes_.size());
+             ++destination)
+          for (auto& box : outboxes_[destination])
+            if (not box.records.empty() and now - box.oldest >= max_delay_)
+              send(box, destination);
+      }
+      reclaim();
+    }
+
+    /// Sends all buffered records to the given destination.
+    /// \param destination rank of the receiving process
+    void flush(int destination) {
+      for (auto& box : outboxes_[destination])
+        if (not box.records.empty())
+          send(box, destination);
+      reclaim();
+    }
+
+    /// Sends all buffered records.
+    void flush() {
+      for (int destination{0}; destination < static_cast<int>(outboxes_.size());
+           ++destination)
+        for (auto& box : outboxes_[destination])
+          if (not box.records.empty())
+            send(box, destination);
+      reclaim();
+    }
+
+    /// Receives an aggregated message.
+    /// \param source rank of the sending process, may be <tt>\ref any_source</tt>
+    /// \param t tag associated to the aggregated message, may be \c tag_t::any
+    /// \return the received records
+    /// \throw invalid_count if the size of the message is not a multiple of the size of \c T
+    [[nodiscard]] batch receive(int source = any_source, tag_t t = tag_t::any()) const {
+      auto [message, status]{comm_.mprobe(source, t)};
+      return receive(message, status);
+    }
+
+    /// Receives an aggregated message if there is a pending one.
+    /// \param source rank of the sending process, may be <tt>\ref any_source</tt>
+    /// \param t tag associated to the aggregated message, may be \c tag_t::any
+    /// \return the received records if there was a pending message
+    /// \throw invalid_count if the size of the message is not a multiple of the size of \c T
+    [[nodiscard]] std::optional<batch> try_receive(int source = any_source,
+                                                   tag_t t = tag_t::any()) const {
+      auto probed{comm_.improbe(source, t)};
+      if (not probed)
+        return {};
+      return receive(probed->message, probed->status);
+    }
+
+  private:
+    batch receive(message_t& message, const status_t& status) const {
+      const int count{status.template get_count<T>()};
+      if (count == MPI_UNDEFINED) {
+        // the message is received and discarded, such that its send operation completes
+        std::vector<char> bytes(status.template get_count<char>());
+        const vector_layout<char> l(bytes.size());
+        comm_.mrecv(bytes.data(), l, message);
+        throw invalid_count();
+      }
+      batch b;
+      b.records_.resize(count);
+      const vector_layout<T> l(b.records_.size());
+      b.status_ = comm_.mrecv(b.records_.data(), l, message);
+      return b;
+    }
+  };
+
+}  // namespace mplr
+
+#endif
@@ -2,6 +2,8 @@
 
 #define MPLR_OPERATOR_HPP
 
+#include <complex>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <type_traits>
@@ -233,6 +235,83 @@ namespace mplr {
 
   namespace detail {
 
+    template<typename T, typename... Ts>
+    inline constexpr bool is_one_of_v = std::disjunction_v<std::is_same<T, Ts>...>;
+
+    // C integer types according to the MPI standard, MPI_CHAR and MPI_WCHAR are excluded
+    template<typename T>
+    inline constexpr bool is_mpi_integer_v =
+        is_one_of_v<T, signed char, unsigned char, signed short int, unsigned short int,
+                    signed int, unsigned int, signed long, unsigned long, signed long long,
+                    unsigned long long>;
+
+    template<typename T>
+    inline constexpr bool is_mpi_floating_point_v = is_one_of_v<T, float, double, long double>;
+
+    template<typename T>
+    inline constexpr bool is_mpi_complex_v =
+        is_one_of_v<T, std::complex<float>, std::complex<double>, std::complex<long double>>;
+
+    /// Maps a reduction operation on a builtin type to an equivalent predefined MPI reduction
+    /// operation, which the MPI library may implement more efficiently than a user-defined
+    /// operation.
+    /// \tparam T data type of the reduction operation's arguments and its result
+    /// \tparam F function object type
+    template<typename T, typename F>
+    struct predefined_op {
+      /// Is true if there is an equivalent predefined MPI reduction operation.
+      static constexpr bool value = false;
+    };
+
+#define MPLR_PREDEFINED_OP(functor, condition, mpi_op) \
+  template<typename T>                                  \
+  struct predefined_op<T, functor<T>> {                 \
+    static constexpr bool value = condition;            \
+    static MPI_Op get() {                               \
+      return mpi_op;                                    \
+    }                                                   \
+  }
+
+    MPLR_PREDEFINED_OP(max, (is_mpi_integer_v<T> or is_mpi_floating_point_v<T>), MPI_MAX);
+
+    MPLR_PREDEFINED_OP(min, (is_mpi_integer_v<T> or is_mpi_floating_point_v<T>), MPI_MIN);
+
+    MPLR_PREDEFINED_OP(plus,
+                       (is_mpi_integer_v<T> or is_mpi_floating_point_v<T> or
+                        is_mpi_complex_v<T>),
+                       MPI_SUM);
+
+    MPLR_PREDEFINED_OP(multiplies,
+                       (is_mpi_integer_v<T> or is_mpi_floating_point_v<T> or
+                        is_mpi_complex_v<T>),
+                       MPI_PROD);
+
+    MPLR_PREDEFINED_OP(logical_and, (is_mpi_integer_v<T> or std::is_same_v<T, bool>),
+                       MPI_LAND);
+
+    MPLR_PREDEFINED_OP(logical_or, (is_mpi_integer_v<T> or std::is_same_v<T, bool>),
+                       MPI_LOR);
+
+    // logical_xor computes the bitwise exclusive disjunction for integers, thus, only the
+    // logical type is mapped to MPI_LXOR
+    MPLR_PREDEFINED_OP(logical_xor, (std::is_same_v<T, bool>), MPI_LXOR);
+
+    MPLR_PREDEFINED_OP(bit_and, (is_mpi_integer_v<T> or std::is_same_v<T, std::byte>),
+                       MPI_BAND);
+
+    MPLR_PREDEFINED_OP(bit_or, (is_mpi_integer_v<T> or std::is_same_v<T, std::byte>),
+                       MPI_BOR);
+
+    MPLR_PREDEFINED_OP(bit_xor, (is_mpi_integer_v<T> or std::is_same_v<T, std::byte>),
+                       MPI_BXOR);
+
+#undef MPLR_PREDEFINED_OP
+
+    template<typename T, typename F>
+    inline constexpr bool is_predefined_op_v = predefined_op<T, F>::value;
+
+    //------------------------------------------------------------------
+
     template<typename T, typename F>
     class op;
 
@@ -248,37 +327,57 @@ namespace mplr {
     public:
       using functor = F;
 
-      static_assert(is_binary_functor<T, F>::value,
+      static_assert(is_binary_functor<T, F>::value or is_batched_binary_functor_v<T, F>,
                     "reduction operator must be a binary function");
       static_assert(not std::is_pointer_v<F>, "functor must not be function pointer");
 
       static constexpr bool is_commutative = op_traits<functor>::is_commutative;
+      static constexpr bool is_predefined = is_predefined_op_v<T, functor>;
+      static constexpr bool is_batched = is_batched_binary_functor_v<T, functor>;
       static inline std::unique_ptr<functor> f;
 
+      // reduces a whole block, the MPI standard guarantees that both blocks do not overlap,
+      // functors may provide operator()(const T*, T*, int) to reduce a block at once
+      static void apply_block(functor& f_, const T* __restrict in, T* __restrict in_out,
+                              int len) {
+        if constexpr (is_batched) {
+          f_(in, in_out, len);
+        } else {
+          for (int i{0}; i < len; ++i)
+            in_out[i] = f_(in[i], in_out[i]);
+        }
+      }
+
       static void apply(void* in_vector, void* in_out_vector, int* len, MPI_Datatype*) {
-        auto* i_1{static_cast<T*>(in_vector)};
-        auto* i_2{static_cast<T*>(in_out_vector)};
-        for (int i{0}, i_end{*len}; i < i_end; ++i, ++i_1, ++i_2)
-          *i_2 = (*f)(*i_1, *i_2);
+        apply_block(*f, static_cast<const T*>(in_vector), static_cast<T*>(in_out_vector), *len);
       }
 
       MPI_Op mpi_op{MPI_OP_NULL};
 
     private:
       explicit op(const F& f_) {
-        f = std::make_unique<F>(f_);
-        MPI_Op_create(op::apply, is_commutative, &mpi_op);
+        if constexpr (is_predefined) {
+          mpi_op = predefined_op<T, F>::get();
+        } else {
+          f = std::make_unique<F>(f_);
+          MPI_Op_create(op::apply, is_commutative, &mpi_op);
+        }
       }
 
       explicit op(F&& f_) {
-        f = std::make_unique<F>(std::move(f_));
-        MPI_Op_create(op::apply, is_commutative, &mpi_op);
+        if constexpr (is_predefined) {
+          mpi_op = predefined_op<T, F>::get();
+        } else {
+          f = std::make_unique<F>(std::move(f_));
+          MPI_Op_create(op::apply, is_commutative, &mpi_op);
+        }
       }
 
       op(op const&) = delete;
 
       ~op() {
-        MPI_Op_free(&mpi_op);
+        if constexpr (not is_predefined)
+          MPI_Op_free(&mpi_op);
       }
 
       auto& operator=(op const&) = delete;
@@ -0,0 +1,186 @@
+#if !(defined MPLR_PROGRESS_ENGINE_HPP)
+
+#define MPLR_PROGRESS_ENGINE_HPP
+
+#include "mplr/impl/wait_policy.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace mplr::detail {
+
+  class progress_engine;
+
+  /// State shared by all tasks during a single sweep of the \c progress_engine over its active
+  /// tasks.
+  class progress_sweep {
+    struct envelope {
+      MPI_Comm comm;
+      int source;
+      int tag;
+    };
+
+    std::vector<envelope> unmatched_;
+
+  public:
+    /// Determines whether a receive must not try to match a message because a receive, which
+    /// has been submitted earlier, has failed to match a message with a possibly overlapping
+    /// envelope during the current sweep.  Honoring this rule preserves MPI's non-overtaking
+    /// order for receives that match messages via probing.
+    /// \param comm communicator of the receive
+    /// \param source source rank of the receive, may be \c MPI_ANY_SOURCE
+    /// \param tag tag of the receive, may be \c MPI_ANY_TAG
+    /// \return true if matching must be deferred to a later sweep
+    [[nodiscard]] bool is_blocked(MPI_Comm comm, int source, int tag) const {
+      return std::any_of(unmatched_.begin(), unmatched_.end(), [&](const envelope& e) {
+        return e.comm == comm and
+               (e.source == source or e.source == MPI_ANY_SOURCE or
+                source == MPI_ANY_SOURCE) and
+               (e.tag == tag or e.tag == MPI_ANY_TAG or tag == MPI_ANY_TAG);
+      });
+    }
+
+    /// Records a receive that has not matched a message during the current sweep.
+    /// \param comm communicator of the receive
+    /// \param source source rank of the receive
+    /// \param tag tag of the receive
+    void add_unmatched(MPI_Comm comm, int source, int tag) {
+      unmatched_.push_back({comm, source, tag});
+    }
+
+    friend class progress_engine;
+  };
+
+  //--------------------------------------------------------------------
+
+  /// Unit of work that is driven to completion by the \c progress_engine.
+  class progress_task {
+    progress_task* next_{nullptr};
+
+  public:
+    progress_task() = default;
+    progress_task(const progress_task&) = delete;
+    progress_task& operator=(const progress_task&) = delete;
+    virtual ~progress_task() = default;
+
+    /// Advances the task without blocking.
+    /// \param sweep state of the current sweep over all active tasks
+    /// \return true if the task has finished and can be destroyed
+    virtual bool progress(progress_sweep& sweep) = 0;
+
+    friend class progress_engine;
+  };
+
+  //--------------------------------------------------------------------
+
+  /// Long-lived progress engine that drives asynchronous operations, which cannot be
+  /// expressed by a single MPI request, e.g., non-blocking communication of non-contiguous
+  /// STL containers.  A single worker thread per process polls all active tasks.  Tasks are
+  /// handed over via a lock-free submission stack.  The worker sleeps while there is no active
+  /// task and backs off while its sweeps over the active tasks make no progress.
+  class progress_engine {
+    // the worker yields after each sweep that finishes or adopts a task, otherwise it yields
+    // and then sleeps for growing times, which are bounded to pick up new tasks promptly
+    static constexpr backoff_wait idle_policy{0, 100, std::chrono::microseconds{1},
+                                              std::chrono::microseconds{100}};
+
+    std::atomic<progress_task*> submitted_{nullptr};
+    std::atomic<bool> sleeping_{false};
+    std::atomic<bool> stop_{false};
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::thread worker_;
+
+    progress_engine() : worker_{[this]() { run(); }} {
+    }
+
+    // moves all submitted tasks into the list of active tasks preserving submission order
+    void adopt(std::vector<std::unique_ptr<progress_task>>& active) {
+      progress_task* head{submitted_.exchange(nullptr, std::memory_order_acquire)};
+      const auto first{active.size()};
+      while (head != nullptr) {
+        progress_task* next{head->next_};
+        active.emplace_back(head);
+        head = next;
+      }
+      std::reverse(active.begin() + first, active.end());
+    }
+
+    void run() {
+      std::vector<std::unique_ptr<progress_task>> active;
+      progress_sweep sweep;
+      auto waiter{idle_policy.make_waiter()};
+      while (true) {
+        if (active.empty()) {
+          std::unique_lock<std::mutex> lock{mutex_};
+          sleeping_ = true;
+          wakeup_.wait(lock, [this]() { return submitted_ != nullptr or stop_; });
+          sleeping_ = false;
+        }
+        if (stop_)
+          break;
+        const auto previously_active{active.size()};
+        adopt(active);
+        const auto adopted{active.size()};
+        // tasks are progressed in submission order, see progress_sweep::is_blocked
+        sweep.unmatched_.clear();
+        active.erase(
+            std::remove_if(active.begin(), active.end(),
+                           [&sweep](const auto& task) { return task->progress(sweep); }),
+            active.end());
+        if (active.empty())
+          continue;
+        if (adopted != previously_active or active.size() != adopted) {
+          waiter = idle_policy.make_waiter();
+          std::this_thread::yield();
+        } else
+          waiter.polling_loop_end();
+      }
+    }
+
+  public:
+    progress_engine(const progress_engine&) = delete;
+    progress_engine& operator=(const progress_engine&) = delete;
+
+    /// Stops the worker thread. Tasks that have not finished yet are abandoned.
+    ~progress_engine() {
+      stop_ = true;
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        wakeup_.notify_one();
+      }
+      worker_.join();
+      std::vector<std::unique_ptr<progress_task>> abandoned;
+      adopt(abandoned);
+    }
+
+    /// \return the process-wide progress engine, the worker thread is started on first use
+    static progress_engine& instance() {
+      static progress_engine engine;
+      return engine;
+    }
+
+    /// Hands a task over to the progress engine, which takes ownership of it.
+    /// \param task task to progress until it has finished
+    void submit(std::unique_ptr<progress_task> task) {
+      progress_task* node{task.release()};
+      node->next_ = submitted_.load(std::memory_order_relaxed);
+      while (not submitted_.compare_exchange_weak(node->next_, node)) {
+      }
+      if (sleeping_) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        wakeup_.notify_one();
+      }
+    }
+  };
+
+}  // namespace mplr::detail
+
+#endif
@@ -2,106 +2,63 @@
 
 #define MPLR_REQUEST_HPP
 
-#include "mplr/impl/stopwatch.hpp"
-#include "mplr/impl/thread_stopwatch.hpp"
+#include "mplr/impl/wait_policy.hpp"
 
-#include <limits>
+#include <cstddef>
+#include <deque>
+#include <memory>
 #include <optional>
-#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 
 namespace mplr {
 
-  class duty_ratio {
-  public:
-    enum struct preset : char {
-      active = 'a',    // 0.1
-      moderate = 'm',  // 0.01
-      relaxed = 'r'    // 0.001
-    };
-
-  public:
-    constexpr duty_ratio(preset p)
-        : duty_ratio{[p]() {
-            switch (p) {
-              case preset::active:
-                return 0.1;
-              case preset::moderate:
-                return 0.01;
-              case preset::relaxed:
-                return 0.001;
-            }
-#if defined MPLR_DEBUG
-            throw invalid_argument{};
-#else
-            return std::numeric_limits<double>::min();
-#endif
-          }()} {
-    }
-
-    constexpr explicit duty_ratio(double duty_ratio) : duty_ratio_{duty_ratio} {
-#if defined MPLR_DEBUG
-      if (duty_ratio_ <= 0 or duty_ratio_ > 1) {
-        throw invalid_argument{};
-      }
-#endif
-    }
+  namespace detail {
 
-    constexpr operator double() const {
-      return duty_ratio_;
-    }
+    struct request_access;
 
-    constexpr double sleep_ratio() const {
-      return 1 - duty_ratio_;
-    }
+    /// Persistent operation that is not provided by the MPI library and is emulated by
+    /// starting the corresponding non-blocking operation with cached arguments.
+    class persistent_schedule {
+    public:
+      virtual ~persistent_schedule() = default;
 
-    constexpr double duty_to_sleep_ratio() const {
-      return duty_ratio_ / sleep_ratio();
-    }
+      /// Starts the non-blocking operation.
+      /// \return request handle of the started operation
+      virtual MPI_Request start() = 0;
 
-    constexpr double sleep_to_duty_ratio() const {
-      return sleep_ratio() / duty_ratio_;
-    }
+      /// Marks a partition of an emulated partitioned send operation as ready for transfer.
+      /// \param partition index of the partition
+      virtual void pready([[maybe_unused]] int partition) {
+      }
 
-  private:
-    double duty_ratio_;
-  };
+      /// Tests if a partition of an emulated partitioned receive operation has arrived.
+      /// \param partition index of the partition
+      /// \return true if the partition has arrived
+      virtual bool parrived([[maybe_unused]] int partition) {
+        return false;
+      }
+    };
 
-  namespace detail {
+    template<typename F>
+    class persistent_schedule_impl final : public persistent_schedule {
+      F start_;
 
-    class lazy_spin_wait_helper {
     public:
-      lazy_spin_wait_helper(duty_ratio duty_ratio)
-          : sleep_to_duty_ratio_{duty_ratio.sleep_to_duty_ratio()},
-            stopwatch_{},
-            thread_stopwatch_{} {
+      explicit persistent_schedule_impl(F start) : start_{std::move(start)} {
       }
 
-      void polling_loop_begin() {
-        stopwatch_.reset();
-        thread_stopwatch_.reset();
+      MPI_Request start() override {
+        return start_();
       }
-
-      void polling_loop_end() {
-        const auto wall_time{stopwatch_.read()};
-        const auto duty_time{thread_stopwatch_.read()};
-        const auto slept_time{wall_time - duty_time};
-        const auto sleep_time{sleep_to_duty_ratio_ * duty_time - slept_time};
-        if (sleep_time > detail::stopwatch::duration::zero()) {
-          std::this_thread::sleep_for(sleep_time);
-        }
-      }
-
-    private:
-      double sleep_to_duty_ratio_;
-      detail::stopwatch stopwatch_;
-      detail::thread_stopwatch thread_stopwatch_;
     };
 
   }  // namespace detail
 
+  class prequest;
+
   /// Indicates kind of outcome of test for request completion.
   enum class test_result {
     completed,          ///< some request has been completed
@@ -119,11 +76,19 @@ namespace mplr {
 
     class base_irequest {
       MPI_Request request_{MPI_REQUEST_NULL};
+      std::shared_ptr<void> resources_;
 
     public:
       explicit base_irequest(MPI_Request request) : request_{request} {
       }
 
+      /// \param request MPI request handle
+      /// \param resources objects that must outlive the pending operation, e.g., argument
+      /// arrays of non-blocking collective operations
+      base_irequest(MPI_Request request, std::shared_ptr<void> resources)
+          : request_{request}, resources_{std::move(resources)} {
+      }
+
       friend class base_request<base_irequest>;
 
       friend class request_pool<base_irequest>;
@@ -131,22 +96,77 @@ namespace mplr {
 
     class base_prequest {
       MPI_Request request_{MPI_REQUEST_NULL};
+      std::shared_ptr<void> resources_;
+      detail::persistent_schedule* schedule_{nullptr};
 
     public:
       explicit base_prequest(MPI_Request request) : request_{request} {
       }
 
+      /// \param request MPI request handle
+      /// \param resources objects that must outlive the pending operation, e.g., argument
+      /// arrays of non-blocking collective operations
+      base_prequest(MPI_Request request, std::shared_ptr<void> resources)
+          : request_{request}, resources_{std::move(resources)} {
+      }
+
+      /// \param schedule emulation of a persistent operation, which is not provided by the MPI
+      /// library
+      explicit base_prequest(std::shared_ptr<detail::persistent_schedule> schedule)
+          : resources_{schedule}, schedule_{schedule.get()} {
+      }
+
       friend class base_request<base_prequest>;
 
       friend class request_pool<base_prequest>;
+
+      friend class mplr::prequest;
     };
 
+    /// Creates a persistent request that emulates a persistent operation.
+    /// \param start function object that starts the corresponding non-blocking operation and
+    /// returns its request handle, it must hold all arguments of the operation
+    /// \return persistent request, which is inactive
+    template<typename F>
+    base_prequest make_persistent_schedule(F start) {
+      return base_prequest{
+          std::make_shared<detail::persistent_schedule_impl<F>>(std::move(start))};
+    }
+
     //------------------------------------------------------------------
 
     template<typename T>
     class base_request {
     protected:
       MPI_Request request_;
+      // objects the pending operation depends on, released as soon as the request handle has
+      // been deallocated by a completing test or wait, persistent requests keep them until
+      // they are destroyed
+      std::shared_ptr<void> resources_;
+
+      friend struct detail::request_access;
+
+      void release_resources() {
+        if constexpr (not std::is_same_v<T, base_prequest>)
+          if (request_ == MPI_REQUEST_NULL)
+            resources_.reset();
+      }
+
+      template<typename W>
+      status_t wait_with(W waiter) {
+        int flag;
+        status_t status;
+        while (true) {
+          waiter.polling_loop_begin();
+          MPI_Test(&request_, &flag, static_cast<MPI_Status*>(&status));
+          if (flag) {
+            waiter.completed();
+            release_resources();
+            return status;
+          }
+          waiter.polling_loop_end();
+        }
+      }
 
     public:
       base_request() : request_{MPI_REQUEST_NULL} {
@@ -154,12 +174,15 @@ namespace mplr {
 
       base_request(const base_request&) = delete;
 
-      explicit base_request(const base_irequest& req) : request_{req.request_} {
+      explicit base_request(const base_irequest& req)
+          : request_{req.request_}, resources_{req.resources_} {
       }
-      explicit base_request(const base_prequest& req) : request_{req.request_} {
+      explicit base_request(const base_prequest& req)
+          : request_{req.request_}, resources_{req.resources_} {
       }
 
-      base_request(base_request&& other) noexcept : request_(other.request_) {
+      base_request(base_request&& other) noexcept
+          : request_(other.request_), resources_{std::move(other.resources_)} {
         other.request_ = MPI_REQUEST_NULL;
       }
 
@@ -175,6 +198,7 @@ namespace mplr {
           if (is_valid())
             MPI_Request_free(&request_);
           request_ = other.request_;
+          resources_ = std::move(other.resources_);
           other.request_ = MPI_REQUEST_NULL;
         }
         return *this;
@@ -199,8 +223,10 @@ namespace mplr {
         int result{true};
         status_t s;
         MPI_Test(&request_, &result, static_cast<MPI_Status*>(&s));
-        if (result != 0)
+        if (result != 0) {
+          release_resources();
           return s;
+        }
         return {};
       }
 
@@ -209,6 +235,7 @@ namespace mplr {
       status_t wait() {
         status_t s;
         MPI_Wait(&request_, static_cast<MPI_Status*>(&s));
+        release_resources();
         return s;
       }
 
@@ -216,17 +243,18 @@ namespace mplr {
       /// @param duty_ratio duty ratio of wait
       /// @return operation's status after completion
       status_t wait(duty_ratio duty_ratio) {
-        int flag;
-        status_t status;
-        detail::lazy_spin_wait_helper lazy_wait{duty_ratio};
-        while (true) {
-          lazy_wait.polling_loop_begin();
-          MPI_Test(&request_, &flag, static_cast<MPI_Status*>(&status));
-          if (flag) {
-            return status;
-          }
-          lazy_wait.polling_loop_end();
-        }
+        return wait_with(duty_ratio.make_waiter());
+      }
+
+      /// Waits for a pending communication operation, the waiting thread behaves as given
+      /// by a wait policy between the tests for completion.
+      /// \tparam P type of the wait policy, e.g., \ref busy_wait, \ref backoff_wait,
+      /// \ref deadline_wait or \ref adaptive_wait
+      /// \param policy the wait policy
+      /// \return operation's status after completion
+      template<typename P, typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+      status_t wait(const P& policy) {
+        return wait_with(policy.make_waiter());
       }
 
       /// Access information associated with a request without freeing the request.
@@ -247,16 +275,134 @@ namespace mplr {
     class request_pool {
     protected:
       std::vector<MPI_Request> requests_;
+      // objects the pending operations depend on, see base_request
+      std::vector<std::shared_ptr<void>> resources_;
+      // scratch buffers for the indices and statuses of completed requests, reused by all
+      // calls such that they only allocate memory when the pool has grown
+      std::vector<int> indices_;
+      std::vector<status_t> statuses_;
+
+      friend struct detail::request_access;
 
     public:
       /// Type used in all index-based operations.
       using size_type = std::vector<MPI_Request>::size_type;
 
+    protected:
+      int* indices_buffer() {
+        indices_.resize(requests_.size());
+        return indices_.data();
+      }
+
+      MPI_Status* statuses_buffer() {
+        statuses_.resize(requests_.size());
+        return static_cast<MPI_Status*>(statuses_.data());
+      }
+
+      // releases the resources of the completed requests and copies their indices
+      std::pair<test_result, size_type> completed(int count, size_type* indices) {
+        if (count == MPI_UNDEFINED)
+          return {test_result::no_active_requests, 0};
+        for (int i{0}; i < count; ++i) {
+          release_resources(indices_[i]);
+          indices[i] = static_cast<size_type>(indices_[i]);
+        }
+        return {count == 0 ? test_result::no_completed : test_result::completed,
+                static_cast<size_type>(count)};
+      }
+
+      void release_resources(size_type i) {
+        if constexpr (not std::is_same_v<T, prequest>)
+          if (requests_[i] == MPI_REQUEST_NULL)
+            resources_[i].reset();
+      }
+
+      void release_resources() {
+        for (size_type i{0}; i < requests_.size(); ++i)
+          release_resources(i);
+      }
+
+      template<typename W>
+      status_t wait_with(size_type i, W waiter) {
+        int flag;
+        status_t status;
+        while (true) {
+          waiter.polling_loop_begin();
+          MPI_Test(&requests_[i], &flag, static_cast<MPI_Status*>(&status));
+          if (flag) {
+            waiter.completed();
+            release_resources(i);
+            return status;
+          }
+          waiter.polling_loop_end();
+        }
+      }
+
+      template<typename W>
+      std::pair<test_result, size_type> waitany_with(W waiter) {
+        int index;
+        int flag;
+        while (true) {
+          waiter.polling_loop_begin();
+          MPI_Testany(size(), requests_.data(), &index, &flag, MPI_STATUS_IGNORE);
+          if (flag) {
+            if (index == MPI_UNDEFINED) {
+              return {test_result::no_active_requests, size()};
+            }
+            waiter.completed();
+            release_resources(index);
+            return {test_result::completed, static_cast<size_type>(index)};
+          }
+          waiter.polling_loop_end();
+        }
+      }
+
+      template<typename W>
+      void waitall_with(W waiter) {
+        int flag;
+        while (true) {
+          waiter.polling_loop_begin();
+          MPI_Testall(size(), requests_.data(), &flag, MPI_STATUSES_IGNORE);
+          if (flag) {
+            waiter.completed();
+            release_resources();
+            return;
+          }
+          waiter.polling_loop_end();
+        }
+      }
+
+      template<typename W>
+      std::pair<test_result, std::vector<size_type>> waitsome_with(W waiter) {
+        int* out_indices{indices_buffer()};
+        int count;
+        while (true) {
+          waiter.polling_loop_begin();
+          MPI_Testsome(size(), requests_.data(), &count, out_indices, MPI_STATUSES_IGNORE);
+          if (count == MPI_UNDEFINED) {
+            return {test_result::no_active_requests, {}};
+          }
+          if (count != 0) {
+            waiter.completed();
+            for (int i{0}; i < count; ++i)
+              release_resources(out_indices[i]);
+            return {test_result::completed,
+                    std::vector<std::size_t>(out_indices, out_indices + count)};
+          }
+          waiter.polling_loop_end();
+        }
+      }
+
+    public:
       request_pool() = default;
 
       request_pool(const request_pool&) = delete;
 
-      request_pool(request_pool&& other) noexcept : requests_(std::move(other.requests_)) {
+      request_pool(request_pool&& other) noexcept
+          : requests_(std::move(other.requests_)),
+            resources_(std::move(other.resources_)),
+            indices_(std::move(other.indices_)),
+            statuses_(std::move(other.statuses_)) {
       }
 
       ~request_pool() {
@@ -273,6 +419,9 @@ namespace mplr {
             if (request != MPI_REQUEST_NULL)
               MPI_Request_free(&request);
           requests_ = std::move(other.requests_);
+          resources_ = std::move(other.resources_);
+          indices_ = std::move(other.indices_);
+          statuses_ = std::move(other.statuses_);
         }
         return *this;
       }
@@ -296,8 +445,10 @@ namespace mplr {
         int result{true};
         status_t s;
         MPI_Test(&requests_[i], &result, static_cast<MPI_Status*>(&s));
-        if (result != 0)
+        if (result != 0) {
+          release_resources(i);
           return s;
+        }
         return {};
       }
 
@@ -307,6 +458,7 @@ namespace mplr {
       status_t wait(size_type i) {
         status_t s;
         MPI_Wait(&requests_[i], static_cast<MPI_Status*>(&s));
+        release_resources(i);
         return s;
       }
 
@@ -315,17 +467,18 @@ namespace mplr {
       /// @param duty_ratio duty ratio of wait
       /// @return operation's status after completion
       status_t wait(size_type i, duty_ratio duty_ratio) {
-        int flag;
-        status_t status;
-        detail::lazy_spin_wait_helper lazy_wait{duty_ratio};
-        while (true) {
-          lazy_wait.polling_loop_begin();
-          MPI_Test(&requests_[i], &flag, static_cast<MPI_Status*>(&status));
-          if (flag) {
-            return status;
-          }
-          lazy_wait.polling_loop_end();
-        }
+        return wait_with(i, duty_ratio.make_waiter());
+      }
+
+      /// Wait for a pending request in the pool, the waiting thread behaves as given by a
+      /// wait policy between the tests for completion.
+      /// \tparam P type of the wait policy, see \c base_request::wait
+      /// \param i index of the request for which shall be waited
+      /// \param policy the wait policy
+      /// \return operation's status after completion
+      template<typename P, typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+      status_t wait(size_type i, const P& policy) {
+        return wait_with(i, policy.make_waiter());
       }
 
       /// Access information associated with a request in the pool without freeing the request.
@@ -357,6 +510,7 @@ namespace mplr {
       /// \param request request to move into the pool
       void push(T&& request) {
         requests_.push_back(request.request_);
+        resources_.push_back(std::move(request.resources_));
         request.request_ = MPI_REQUEST_NULL;
       }
 
@@ -367,6 +521,7 @@ namespace mplr {
         int index;
         MPI_Waitany(size(), requests_.data(), &index, MPI_STATUS_IGNORE);
         if (index != MPI_UNDEFINED) {
+          release_resources(index);
           return std::make_pair(test_result::completed, static_cast<size_type>(index));
         }
         return std::make_pair(test_result::no_active_requests, size());
@@ -376,20 +531,18 @@ namespace mplr {
       /// @param duty_ratio duty ratio of wait
       /// @return operation's status after completion
       std::pair<test_result, size_type> waitany(duty_ratio duty_ratio) {
-        int index;
-        int flag;
-        detail::lazy_spin_wait_helper lazy_wait{duty_ratio};
-        while (true) {
-          lazy_wait.polling_loop_begin();
-          MPI_Testany(size(), requests_.data(), &index, &flag, MPI_STATUS_IGNORE);
-          if (flag) {
-            if (index == MPI_UNDEFINED) {
-              return {test_result::no_active_requests, size()};
-            }
-            return {test_result::completed, static_cast<size_type>(index)};
-          }
-          lazy_wait.polling_loop_end();
-        }
+        return waitany_with(duty_ratio.make_waiter());
+      }
+
+      /// Wait for completion of any pending communication operation, the waiting thread
+      /// behaves as given by a wait policy between the tests for completion.
+      /// \tparam P type of the wait policy, see \c base_request::wait
+      /// \param policy the wait policy
+      /// \return pair containing the outcome of the wait operation and an index to the
+      /// completed request if there was any pending request
+      template<typename P, typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+      std::pair<test_result, size_type> waitany(const P& policy) {
+        return waitany_with(policy.make_waiter());
       }
 
       /// Test for completion of any pending communication operation.
@@ -399,6 +552,7 @@ namespace mplr {
         int index, flag;
         MPI_Testany(size(), requests_.data(), &index, &flag, MPI_STATUS_IGNORE);
         if (flag != 0 and index != MPI_UNDEFINED) {
+          release_resources(index);
           return std::make_pair(test_result::completed, static_cast<size_type>(index));
         }
         if (flag != 0 and index == MPI_UNDEFINED)
@@ -409,21 +563,22 @@ namespace mplr {
       /// Waits for completion of all pending requests.
       void waitall() {
         MPI_Waitall(size(), requests_.data(), MPI_STATUSES_IGNORE);
+        release_resources();
       }
 
       /// A lazy-spin waitall.
       /// @param duty_ratio duty ratio of wait
       void waitall(duty_ratio duty_ratio) {
-        int flag;
-        detail::lazy_spin_wait_helper lazy_wait{duty_ratio};
-        while (true) {
-          lazy_wait.polling_loop_begin();
-          MPI_Testall(size(), requests_.data(), &flag, MPI_STATUSES_IGNORE);
-          if (flag) {
-            return;
-          }
-          lazy_wait.polling_loop_end();
-        }
+        waitall_with(duty_ratio.make_waiter());
+      }
+
+      /// Waits for completion of all pending requests, the waiting thread behaves as given by
+      /// a wait policy between the tests for completion.
+      /// \tparam P type of the wait policy, see \c base_request::wait
+      /// \param policy the wait policy
+      template<typename P, typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+      void waitall(const P& policy) {
+        waitall_with(policy.make_waiter());
       }
 
       /// Tests for completion of all pending requests.
@@ -431,69 +586,181 @@ namespace mplr {
       bool testall() {
         int flag;
         MPI_Testall(size(), requests_.data(), &flag, MPI_STATUSES_IGNORE);
+        if (flag)
+          release_resources();
         return static_cast<bool>(flag);
       }
 
       /// Waits until one or more pending requests have finished.
       /// \return pair containing the outcome of the wait operation and a list of indices to
       /// the completed requests if there was any pending request
+      /// \note The indices are collected in a buffer that is owned by the pool, but the
+      /// returned list is allocated by each call.  Only the overload that writes the indices to
+      /// given storage and \c for_each_completed do not allocate memory.
       std::pair<test_result, std::vector<size_type>> waitsome() {
-        std::vector<int> out_indices(size());
+        int* out_indices{indices_buffer()};
         int count;
-        MPI_Waitsome(size(), requests_.data(), &count, out_indices.data(), MPI_STATUSES_IGNORE);
+        MPI_Waitsome(size(), requests_.data(), &count, out_indices, MPI_STATUSES_IGNORE);
         if (count != MPI_UNDEFINED) {
-          return std::make_pair(
-              test_result::completed,
-              std::vector<std::size_t>(out_indices.begin(), out_indices.begin() + count));
+          for (int i{0}; i < count; ++i)
+            release_resources(out_indices[i]);
+          return std::make_pair(test_result::completed,
+                                std::vector<std::size_t>(out_indices, out_indices + count));
         }
         return std::make_pair(test_result::no_active_requests, std::vector<std::size_t>{});
       }
 
+      /// Waits until one or more pending requests have finished without allocating memory
+      /// for the results.
+      /// \param indices storage for at least \c size() indices, the indices of the completed
+      /// requests are written to its beginning
+      /// \param statuses storage for at least \c size() statuses, the statuses of the
+      /// completed requests are written to its beginning in the order of the indices, may be
+      /// nullptr if the statuses are not needed
+      /// \return pair containing the outcome of the wait operation and the number of completed
+      /// requests
+      std::pair<test_result, size_type> waitsome(size_type* indices,
+                                                 status_t* statuses = nullptr) {
+        int count;
+        MPI_Waitsome(size(), requests_.data(), &count, indices_buffer(),
+                     statuses != nullptr ? static_cast<MPI_Status*>(statuses)
+                                         : MPI_STATUSES_IGNORE);
+        return completed(count, indices);
+      }
+
       /// A lazy-spin waitsome.
       /// @param duty_ratio duty ratio of wait
       std::pair<test_result, std::vector<size_type>> waitsome(duty_ratio duty_ratio) {
-        std::vector<int> out_indices(size());
-        int count;
-        detail::lazy_spin_wait_helper lazy_wait{duty_ratio};
-        while (true) {
-          lazy_wait.polling_loop_begin();
-          MPI_Testsome(size(), requests_.data(), &count, out_indices.data(),
-                       MPI_STATUSES_IGNORE);
-          if (count == MPI_UNDEFINED) {
-            return {test_result::no_active_requests, {}};
-          }
-          if (count != 0) {
-            return {test_result::completed,
-                    std::vector<std::size_t>(out_indices.begin(), out_indices.begin() + count)};
-          }
-          lazy_wait.polling_loop_end();
-        }
+        return waitsome_with(duty_ratio.make_waiter());
+      }
+
+      /// Waits until one or more pending requests have finished, the waiting thread behaves as
+      /// given by a wait policy between the tests for completion.
+      /// \tparam P type of the wait policy, see \c base_request::wait
+      /// \param policy the wait policy
+      /// \return pair containing the outcome of the wait operation and a list of indices to
+      /// the completed requests if there was any pending request
+      /// \note As for \c waitsome without wait policy, the returned list is allocated by each
+      /// call.
+      template<typename P, typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+      std::pair<test_result, std::vector<size_type>> waitsome(const P& policy) {
+        return waitsome_with(policy.make_waiter());
       }
 
       /// Tests if one or more pending requests have finished.
       /// \return pair containing the outcome of the test and a list of indices to the completed
       /// requests if there was any pending request
+      /// \note As for \c waitsome, the returned list is allocated by each call.
       std::pair<test_result, std::vector<size_type>> testsome() {
-        std::vector<int> out_indices(size());
+        int* out_indices{indices_buffer()};
         int count;
-        MPI_Testsome(size(), requests_.data(), &count, out_indices.data(), MPI_STATUSES_IGNORE);
+        MPI_Testsome(size(), requests_.data(), &count, out_indices, MPI_STATUSES_IGNORE);
         if (count != MPI_UNDEFINED) {
-          return std::make_pair(
-              count == 0 ? test_result::no_completed : test_result::completed,
-              std::vector<std::size_t>(out_indices.begin(), out_indices.begin() + count));
+          for (int i{0}; i < count; ++i)
+            release_resources(out_indices[i]);
+          return std::make_pair(count == 0 ? test_result::no_completed : test_result::completed,
+                                std::vector<std::size_t>(out_indices, out_indices + count));
         }
         return std::make_pair(test_result::no_active_requests, std::vector<std::size_t>{});
       }
+
+      /// Tests if one or more pending requests have finished without allocating memory for the
+      /// results.
+      /// \param indices storage for at least \c size() indices, the indices of the completed
+      /// requests are written to its beginning
+      /// \param statuses storage for at least \c size() statuses, the statuses of the
+      /// completed requests are written to its beginning in the order of the indices, may be
+      /// nullptr if the statuses are not needed
+      /// \return pair containing the outcome of the test and the number of completed requests
+      std::pair<test_result, size_type> testsome(size_type* indices,
+                                                 status_t* statuses = nullptr) {
+        int count;
+        MPI_Testsome(size(), requests_.data(), &count, indices_buffer(),
+                     statuses != nullptr ? static_cast<MPI_Status*>(statuses)
+                                         : MPI_STATUSES_IGNORE);
+        return completed(count, indices);
+      }
+
+      /// Tests if one or more pending requests have finished and invokes a function for each
+      /// completed request.  Indices and statuses are kept in buffers that are owned by the
+      /// pool and reused by subsequent calls.
+      /// \tparam F type of the function, invocable with the index of a completed request or
+      /// with the index and the status of a completed request
+      /// \param f the function
+      /// \return outcome of the test
+      template<typename F>
+      test_result for_each_completed(F&& f) {
+        constexpr bool with_status{std::is_invocable_v<F&, size_type, const status_t&>};
+        int count;
+        MPI_Testsome(size(), requests_.data(), &count, indices_buffer(),
+                     with_status ? statuses_buffer() : MPI_STATUSES_IGNORE);
+        if (count == MPI_UNDEFINED)
+          return test_result::no_active_requests;
+        for (int i{0}; i < count; ++i) {
+          const auto index{static_cast<size_type>(indices_[i])};
+          if constexpr (with_status)
+            f(index, statuses_[i]);
+          else
+            f(index);
+          release_resources(index);
+        }
+        return count == 0 ? test_result::no_completed : test_result::completed;
+      }
     };
 
   }  // namespace impl
 
+  namespace detail {
+
+    // access to the request handles for extensions that drive requests by their own means,
+    // e.g., the coroutine scheduler
+    struct request_access {
+      template<typename T>
+      static MPI_Request& handle(mplr::impl::base_request<T>& request) {
+        return request.request_;
+      }
+
+      template<typename T>
+      static std::shared_ptr<void>& resources(mplr::impl::base_request<T>& request) {
+        return request.resources_;
+      }
+
+      template<typename T>
+      static void release_resources(mplr::impl::base_request<T>& request) {
+        request.release_resources();
+      }
+
+      template<typename T>
+      static std::vector<MPI_Request>& handles(mplr::impl::request_pool<T>& pool) {
+        return pool.requests_;
+      }
+
+      template<typename T>
+      static void release_resources(mplr::impl::request_pool<T>& pool, std::size_t i) {
+        pool.release_resources(i);
+      }
+
+      template<typename T>
+      static void release_resources(mplr::impl::request_pool<T>& pool) {
+        pool.release_resources();
+      }
+
+      static MPI_Status* native(status_t* status) {
+        return static_cast<MPI_Status*>(status);
+      }
+    };
+
+  }  // namespace detail
+
   //--------------------------------------------------------------------
 
+  class completion_queue;
+
   /// Represents a non-blocking communication request.
   class irequest : public impl::base_request<impl::base_irequest> {
     using base = impl::base_request<impl::base_irequest>;
     using base::request_;
+    using base::resources_;
 
   public:
     /// Default null request.
@@ -519,6 +786,26 @@ namespace mplr {
     /// \return reference to the moved-to request
     irequest& operator=(irequest&& other) noexcept = default;
 
+    /// Attaches a callback that is invoked when the request has completed.  The request is
+    /// moved into the completion queue of the calling thread, see
+    /// \c completion_queue::this_thread, and the callback is invoked by this queue.
+    /// \tparam F type of the callback, invocable with an argument of type \c status_t or
+    /// without argument
+    /// \param f the callback
+    /// \note The request is not valid anymore after attaching the callback.
+    template<typename F>
+    void then(F&& f);
+
+    /// Attaches a callback that is invoked when the request has completed.  The request is
+    /// moved into the given completion queue, which invokes the callback.
+    /// \tparam F type of the callback, invocable with an argument of type \c status_t or
+    /// without argument
+    /// \param queue the completion queue
+    /// \param f the callback
+    /// \note The request is not valid anymore after attaching the callback.
+    template<typename F>
+    void then(completion_queue& queue, F&& f);
+
     friend class impl::request_pool<irequest>;
   };
 
@@ -550,17 +837,201 @@ namespace mplr {
 
   //--------------------------------------------------------------------
 
+  /// Queue of non-blocking requests with attached callbacks.  Progressing the queue tests all
+  /// requests by a single call to \c MPI_Testsome and invokes the callbacks of the completed
+  /// requests, which may attach further callbacks to new requests.
+  /// \note A queue must not be used by several threads concurrently.
+  class completion_queue {
+    class callback {
+    public:
+      virtual ~callback() = default;
+
+      virtual void operator()(const status_t& s) = 0;
+    };
+
+    template<typename F>
+    class callback_impl final : public callback {
+      F f_;
+
+    public:
+      explicit callback_impl(F f) : f_{std::move(f)} {
+      }
+
+      void operator()(const status_t& s) override {
+        if constexpr (std::is_invocable_v<F&, const status_t&>)
+          f_(s);
+        else
+          f_();
+      }
+    };
+
+    struct completed_request {
+      std::unique_ptr<callback> f;
+      status_t status;
+      std::shared_ptr<void> resources;
+    };
+
+    std::vector<MPI_Request> requests_;
+    std::vector<std::unique_ptr<callback>> callbacks_;
+    std::vector<std::shared_ptr<void>> resources_;
+    std::vector<int> indices_;
+    std::vector<status_t> statuses_;
+    std::deque<completed_request> completed_;
+
+  public:
+    /// Type used for the number of requests.
+    using size_type = std::vector<MPI_Request>::size_type;
+
+    /// Creates an empty completion queue.
+    completion_queue() = default;
+
+    /// Deleted copy constructor.
+    completion_queue(const completion_queue&) = delete;
+
+    /// Deleted copy operator.
+    completion_queue& operator=(const completion_queue&) = delete;
+
+    /// Frees all pending requests without invoking their callbacks.
+    ~completion_queue() {
+      int finalized;
+      MPI_Finalized(&finalized);
+      if (not finalized)
+        for (auto& request : requests_)
+          MPI_Request_free(&request);
+    }
+
+    /// \return the completion queue of the calling thread, which is used by
+    /// \c irequest::then
+    static completion_queue& this_thread() {
+      thread_local completion_queue queue;
+      return queue;
+    }
+
+    /// \return number of requests whose callbacks have not been invoked yet
+    [[nodiscard]] size_type size() const {
+      return requests_.size() + completed_.size();
+    }
+
+    /// \return true if the callbacks of all requests have been invoked
+    [[nodiscard]] bool empty() const {
+      return requests_.empty() and completed_.empty();
+    }
+
+    /// Moves a request into the queue and attaches a callback to it.
+    /// \tparam F type of the callback, invocable with an argument of type \c status_t or
+    /// without argument
+    /// \param request the request
+    /// \param f the callback that is invoked when the request has completed
+    template<typename F>
+    void push(irequest&& request, F&& f) {
+      auto& handle{detail::request_access::handle(request)};
+      auto f_ptr{std::make_unique<callback_impl<std::decay_t<F>>>(std::forward<F>(f))};
+      auto resources{std::move(detail::request_access::resources(request))};
+      if (handle == MPI_REQUEST_NULL)
+        completed_.push_back({std::move(f_ptr), status_t{}, std::move(resources)});
+      else {
+        requests_.push_back(handle);
+        callbacks_.push_back(std::move(f_ptr));
+        resources_.push_back(std::move(resources));
+        handle = MPI_REQUEST_NULL;
+      }
+    }
+
+    /// Tests all requests for completion and invokes the callbacks of the completed
+    /// requests.
+    /// \return number of invoked callbacks
+    /// \note If a callback throws an exception, the exception is propagated and the
+    /// callbacks of the remaining completed requests are invoked by the next call.
+    size_type progress() {
+      if (not requests_.empty()) {
+        const int n{static_cast<int>(requests_.size())};
+        indices_.resize(n);
+        statuses_.resize(n);
+        int count;
+        MPI_Testsome(n, requests_.data(), &count, indices_.data(),
+                     detail::request_access::native(statuses_.data()));
+        if (count != MPI_UNDEFINED and count > 0) {
+          for (int i{0}; i < count; ++i)
+            completed_.push_back({std::move(callbacks_[indices_[i]]), statuses_[i],
+                                  std::move(resources_[indices_[i]])});
+          size_type j{0};
+          for (size_type i{0}; i < requests_.size(); ++i)
+            if (requests_[i] != MPI_REQUEST_NULL) {
+              if (i != j) {
+                requests_[j] = requests_[i];
+                callbacks_[j] = std::move(callbacks_[i]);
+                resources_[j] = std::move(resources_[i]);
+              }
+              ++j;
+            }
+          requests_.resize(j);
+          callbacks_.resize(j);
+          resources_.resize(j);
+        }
+      }
+      size_type invoked{0};
+      while (not completed_.empty()) {
+        auto c{std::move(completed_.front())};
+        completed_.pop_front();
+        (*c.f)(c.status);
+        ++invoked;
+      }
+      return invoked;
+    }
+
+    /// Progresses the queue until the callbacks of all requests, including requests that
+    /// have been added by callbacks, have been invoked.
+    void run() {
+      run(busy_wait{});
+    }
+
+    /// Progresses the queue until the callbacks of all requests, including requests that
+    /// have been added by callbacks, have been invoked.  The thread behaves as given by a
+    /// wait policy while no request completes.
+    /// \tparam P type of the wait policy, see \c irequest::wait
+    /// \param policy the wait policy
+    template<typename P, typename = std::enable_if_t<detail::is_wait_policy_v<P>>>
+    void run(const P& policy) {
+      while (not empty()) {
+        auto waiter{policy.make_waiter()};
+        while (true) {
+          waiter.polling_loop_begin();
+          if (progress() > 0 or empty())
+            break;
+          waiter.polling_loop_end();
+        }
+        waiter.completed();
+      }
+    }
+  };
+
+  template<typename F>
+  void irequest::then(F&& f) {
+    completion_queue::this_thread().push(std::move(*this), std::forward<F>(f));
+  }
+
+  template<typename F>
+  void irequest::then(completion_queue& queue, F&& f) {
+    queue.push(std::move(*this), std::forward<F>(f));
+  }
+
+  //--------------------------------------------------------------------
+
   /// Represents a persistent communication request.
   class prequest : public impl::base_request<impl::base_prequest> {
     using base = impl::base_request<impl::base_prequest>;
     using base::request_;
+    using base::resources_;
+
+    // emulated persistent operation, owned by resources_
+    detail::persistent_schedule* schedule_{nullptr};
 
   public:
     /// Default null request.
     prequest() = default;
 
 #if (!defined MPLR_DOXYGEN_SHOULD_SKIP_THIS)
-    prequest(const impl::base_prequest& r) : base{r} {
+    prequest(const impl::base_prequest& r) : base{r}, schedule_{r.schedule_} {
     }
 #endif
 
@@ -569,7 +1040,9 @@ namespace mplr {
 
     /// Move constructor.
     /// \param other the request to move from
-    prequest(prequest&& other) noexcept = default;
+    prequest(prequest&& other) noexcept
+        : base{std::move(other)}, schedule_{std::exchange(other.schedule_, nullptr)} {
+    }
 
     /// Deleted copy operator.
     auto& operator=(const prequest&) = delete;
@@ -577,14 +1050,77 @@ namespace mplr {
     /// Move operator.
     /// \param other the request to move from
     /// \return reference to the moved-to request
-    prequest& operator=(prequest&& other) noexcept = default;
+    prequest& operator=(prequest&& other) noexcept {
+      if (this != &other) {
+        base::operator=(std::move(other));
+        schedule_ = std::exchange(other.schedule_, nullptr);
+      }
+      return *this;
+    }
+
+    /// Checks if a request is not null.
+    /// \return true if request is valid
+    /// \note A default constructed request is a non-valid request.  A persistent request
+    /// remains valid when its operation has completed, it becomes inactive and can be started
+    /// again.  This also holds if the persistent operation is emulated.
+    bool is_valid() {
+      return schedule_ != nullptr or base::is_valid();
+    }
 
     /// Start communication operation.
     void start() {
-      MPI_Start(&request_);
+      if (schedule_ != nullptr)
+        request_ = schedule_->start();
+      else
+        MPI_Start(&request_);
+    }
+
+    /// Marks a partition of a partitioned send operation as ready for transfer.
+    /// \param partition index of the partition
+    /// \note This method may be called concurrently by several threads for different
+    /// partitions.
+    void pready(int partition) {
+      if (schedule_ != nullptr)
+        schedule_->pready(partition);
+#if defined MPLR_HAS_PARTITIONED_COMMUNICATION
+      else
+        MPI_Pready(partition, request_);
+#endif
+    }
+
+    /// Marks a range of partitions of a partitioned send operation as ready for transfer.
+    /// \param low index of the first partition
+    /// \param high index of the last partition
+    void pready_range(int low, int high) {
+      if (schedule_ != nullptr) {
+        for (int partition{low}; partition <= high; ++partition)
+          schedule_->pready(partition);
+      }
+#if defined MPLR_HAS_PARTITIONED_COMMUNICATION
+      else
+        MPI_Pready_range(low, high, request_);
+#endif
+    }
+
+    /// Tests if a partition of a partitioned receive operation has arrived.
+    /// \param partition index of the partition
+    /// \return true if the partition has arrived
+    /// \note This method may be called concurrently by several threads.
+    [[nodiscard]] bool parrived(int partition) {
+      if (schedule_ != nullptr)
+        return schedule_->parrived(partition);
+#if defined MPLR_HAS_PARTITIONED_COMMUNICATION
+      int flag;
+      MPI_Parrived(request_, partition, &flag);
+      return flag != 0;
+#else
+      return false;
+#endif
     }
 
     friend class impl::request_pool<prequest>;
+
+    friend class prequest_pool;
   };
 
   //--------------------------------------------------------------------
@@ -594,6 +1130,10 @@ namespace mplr {
     using base = impl::request_pool<prequest>;
     using base::requests_;
 
+    // emulated persistent operations, null for requests provided by the MPI library
+    std::vector<detail::persistent_schedule*> schedules_;
+    size_type emulated_{0};
+
   public:
     /// Constructs an empty pool of persistent communication requests.
     prequest_pool() = default;
@@ -612,15 +1152,32 @@ namespace mplr {
     /// \param other the request pool to move from
     prequest_pool& operator=(prequest_pool&& other) noexcept = default;
 
+    /// Move a request into the request pool.
+    /// \param request request to move into the pool
+    void push(prequest&& request) {
+      if (request.schedule_ != nullptr)
+        ++emulated_;
+      schedules_.push_back(std::exchange(request.schedule_, nullptr));
+      base::push(std::move(request));
+    }
+
     /// Start a persistent requests in the pool.
     /// \param i index of the request for which shall be started
     void start(size_type i) {
-      MPI_Start(&requests_[i]);
+      if (schedules_[i] != nullptr)
+        requests_[i] = schedules_[i]->start();
+      else
+        MPI_Start(&requests_[i]);
     }
 
     /// Start all persistent requests in the pool.
+    /// \note Requests are started in the order in which they have been added to the pool.
     void startall() {
-      MPI_Startall(size(), requests_.data());
+      if (emulated_ == 0)
+        MPI_Startall(size(), requests_.data());
+      else
+        for (size_type i{0}; i < size(); ++i)
+          start(i);
     }
   };
 
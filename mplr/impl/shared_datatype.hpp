@@ -0,0 +1,106 @@
+#if !(defined MPLR_SHARED_DATATYPE_HPP)
+
+#define MPLR_SHARED_DATATYPE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+
+namespace mplr {
+
+  namespace detail {
+
+    // sequence of consecutive elements that a layout refers to, given by the byte offset of
+    // the first element relative to the layout's origin and the number of elements
+    struct contiguous_span {
+      MPI_Aint byte_offset{0};
+      MPI_Aint count{0};
+    };
+
+    // reference-counted handle of a committed MPI data type, copies of a handle refer to the
+    // same data type, which is freed when the last handle is destroyed, the data type and its
+    // properties must not be modified once the handle has been copied
+    class shared_datatype {
+      struct control_block {
+        MPI_Datatype type;
+        std::optional<contiguous_span> span;
+        std::atomic<std::size_t> references{1};
+      };
+
+      control_block* block_{nullptr};
+
+      explicit shared_datatype(control_block* block) noexcept : block_{block} {
+      }
+
+      void release() noexcept {
+        if (block_ != nullptr and
+            block_->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          MPI_Type_free(&block_->type);
+          delete block_;
+        }
+        block_ = nullptr;
+      }
+
+    public:
+      // creates a handle that refers to MPI_DATATYPE_NULL
+      shared_datatype() = default;
+
+      shared_datatype(const shared_datatype& other) noexcept : block_{other.block_} {
+        if (block_ != nullptr)
+          block_->references.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      shared_datatype(shared_datatype&& other) noexcept
+          : block_{std::exchange(other.block_, nullptr)} {
+      }
+
+      shared_datatype& operator=(const shared_datatype& other) noexcept {
+        if (block_ != other.block_) {
+          shared_datatype copy{other};
+          swap(copy);
+        }
+        return *this;
+      }
+
+      shared_datatype& operator=(shared_datatype&& other) noexcept {
+        if (this != &other) {
+          release();
+          block_ = std::exchange(other.block_, nullptr);
+        }
+        return *this;
+      }
+
+      ~shared_datatype() {
+        release();
+      }
+
+      // commits a new data type and takes ownership of it
+      static shared_datatype commit(MPI_Datatype type,
+                                    const std::optional<contiguous_span>& span = {}) {
+        if (type == MPI_DATATYPE_NULL)
+          return shared_datatype{};
+        MPI_Type_commit(&type);
+        return shared_datatype{new control_block{type, span}};
+      }
+
+      void swap(shared_datatype& other) noexcept {
+        std::swap(block_, other.block_);
+      }
+
+      [[nodiscard]] MPI_Datatype get() const noexcept {
+        return block_ != nullptr ? block_->type : MPI_DATATYPE_NULL;
+      }
+
+      // returns a null pointer if the data type is not known to be contiguous
+      [[nodiscard]] const contiguous_span* span() const noexcept {
+        return block_ != nullptr and block_->span ? &*block_->span : nullptr;
+      }
+    };
+
+  }  // namespace detail
+
+}  // namespace mplr
+
+#endif
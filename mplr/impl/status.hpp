@@ -17,6 +17,12 @@ namespace mplr {
 
   }  // namespace impl
 
+  namespace detail {
+
+    struct request_access;
+
+  }  // namespace detail
+
   //--------------------------------------------------------------------------------------------
 
   /// Class that represents the status of a received message.
@@ -84,6 +90,7 @@ namespace mplr {
     template<typename T>
     friend class impl::request_pool;
     friend class file;
+    friend struct detail::request_access;
   };
 
   static_assert(sizeof(MPI_Status) == sizeof(status_t));
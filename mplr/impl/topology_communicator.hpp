@@ -2,6 +2,7 @@
 
 #define MPLR_TOPOLOGY_COMMUNICATOR_HPP
 
+#include <memory>
 #include <vector>
 
 
@@ -314,13 +315,10 @@ namespace mplr::impl {
                             const displacements& senddispls, T* recvdata,
                             const layouts<T>& recvls, const displacements& recvdispls) const {
       const std::vector<int> counts(recvls.size(), 1);
-      static_assert(
-          sizeof(decltype(*sendls())) == sizeof(MPI_Datatype),
-          "compiler adds some unexpected padding, reinterpret cast will yield wrong results");
-      MPI_Neighbor_alltoallw(senddata, counts.data(), senddispls(),
-                             reinterpret_cast<const MPI_Datatype*>(sendls()), recvdata,
-                             counts.data(), recvdispls(),
-                             reinterpret_cast<const MPI_Datatype*>(recvls()), comm_);
+      const auto sendtypes{datatypes_as_vector(sendls)};
+      const auto recvtypes{datatypes_as_vector(recvls)};
+      MPI_Neighbor_alltoallw(senddata, counts.data(), senddispls(), sendtypes.data(), recvdata,
+                             counts.data(), recvdispls(), recvtypes.data(), comm_);
     }
 
     /// Sends messages with a variable amount of data to all neighbouring processes and
@@ -380,16 +378,16 @@ namespace mplr::impl {
                                        const displacements& senddispls, T* recvdata,
                                        const layouts<T>& recvls,
                                        const displacements& recvdispls) const {
-      std::vector<int> counts(recvls.size(), 1);
+      auto resources{std::make_shared<ialltoallv_resources>()};
+      resources->recvcounts.assign(recvls.size(), 1);
+      resources->sendtypes = datatypes_as_vector(sendls);
+      resources->recvtypes = datatypes_as_vector(recvls);
       MPI_Request req;
-      static_assert(
-          sizeof(decltype(*sendls())) == sizeof(MPI_Datatype),
-          "compiler adds some unexpected padding, reinterpret cast will yield wrong results");
-      MPI_Ineighbor_alltoallw(senddata, counts.data(), senddispls(),
-                              reinterpret_cast<const MPI_Datatype*>(sendls()), recvdata,
-                              counts.data(), recvdispls(),
-                              reinterpret_cast<const MPI_Datatype*>(recvls()), comm_, &req);
-      return impl::base_irequest{req};
+      MPI_Ineighbor_alltoallw(senddata, resources->recvcounts.data(), senddispls(),
+                              resources->sendtypes.data(), recvdata,
+                              resources->recvcounts.data(), recvdispls(),
+                              resources->recvtypes.data(), comm_, &req);
+      return impl::base_irequest{req, std::move(resources)};
     }
 
     /// Sends messages with a variable amount of data to all neighbouring processes and
@@ -147,6 +147,22 @@ namespace mplr::detail {
 
   // -----------------------------------------------------------------
 
+  // function objects of type F that reduce a whole block of values at once via
+  // f(const T* in, T* in_out, int n)
+  template<typename, typename, typename = void>
+  struct is_batched_binary_functor : std::false_type {};
+
+  template<typename T, typename F>
+  struct is_batched_binary_functor<T, F,
+                                   std::void_t<decltype(get_object<F&>()(
+                                       get_object<const T*>(), get_object<T*>(), 0))>>
+      : std::true_type {};
+
+  template<typename T, typename F>
+  inline constexpr bool is_batched_binary_functor_v = is_batched_binary_functor<T, F>::value;
+
+  // -----------------------------------------------------------------
+
   template<typename, typename = void>
   struct has_resize : std::false_type {};
 
@@ -158,6 +174,40 @@ namespace mplr::detail {
 
   // -----------------------------------------------------------------
 
+  template<typename, typename = void>
+  struct has_reserve : std::false_type {};
+
+  template<typename T>
+  struct has_reserve<T, std::void_t<decltype(T().reserve(1))>> : std::true_type {};
+
+  template<typename T>
+  inline constexpr bool has_reserve_v = has_reserve<T>::value;
+
+  // -----------------------------------------------------------------
+
+  // node-based associative containers, whose nodes can be extracted and re-inserted
+  template<typename, typename = void>
+  struct has_extract : std::false_type {};
+
+  template<typename T>
+  struct has_extract<T, std::void_t<decltype(T().extract(T().begin()))>> : std::true_type {};
+
+  template<typename T>
+  inline constexpr bool has_extract_v = has_extract<T>::value;
+
+  // -----------------------------------------------------------------
+
+  template<typename, typename = void>
+  struct has_mapped_type : std::false_type {};
+
+  template<typename T>
+  struct has_mapped_type<T, std::void_t<typename T::mapped_type>> : std::true_type {};
+
+  template<typename T>
+  inline constexpr bool has_mapped_type_v = has_mapped_type<T>::value;
+
+  // -----------------------------------------------------------------
+
 }  // namespace mplr::detail
 
 #endif
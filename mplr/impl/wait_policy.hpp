@@ -0,0 +1,497 @@
+#if !(defined MPLR_WAIT_POLICY_HPP)
+
+#define MPLR_WAIT_POLICY_HPP
+
+#include "mplr/impl/error.hpp"
+#include "mplr/impl/stopwatch.hpp"
+#include "mplr/impl/thread_stopwatch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+
+// A wait policy determines what a thread does between two tests for completion while it
+// waits for pending requests.  Any type with a const member function make_waiter() is a
+// wait policy.  The waiter returned by make_waiter() lives for the duration of one wait
+// operation and provides the member functions polling_loop_begin(), which is called before
+// each test, polling_loop_end(), which is called after each unsuccessful test, and
+// completed(), which is called once when the wait operation finishes.
+
+
+namespace mplr {
+
+  namespace detail {
+
+    class lazy_spin_wait_helper;
+
+    template<typename P, typename = void>
+    struct is_wait_policy : public std::false_type {};
+
+    template<typename P>
+    struct is_wait_policy<P, std::void_t<decltype(std::declval<const P&>().make_waiter())>>
+        : public std::true_type {};
+
+    template<typename P>
+    inline constexpr bool is_wait_policy_v = is_wait_policy<std::decay_t<P>>::value;
+
+  }  // namespace detail
+
+  //--------------------------------------------------------------------
+
+  class duty_ratio {
+  public:
+    enum struct preset : char {
+      active = 'a',    // 0.1
+      moderate = 'm',  // 0.01
+      relaxed = 'r'    // 0.001
+    };
+
+  public:
+    constexpr duty_ratio(preset p)
+        : duty_ratio{[p]() {
+            switch (p) {
+              case preset::active:
+                return 0.1;
+              case preset::moderate:
+                return 0.01;
+              case preset::relaxed:
+                return 0.001;
+            }
+#if defined MPLR_DEBUG
+            throw invalid_argument{};
+#else
+            return std::numeric_limits<double>::min();
+#endif
+          }()} {
+    }
+
+    constexpr explicit duty_ratio(double duty_ratio) : duty_ratio_{duty_ratio} {
+#if defined MPLR_DEBUG
+      if (duty_ratio_ <= 0 or duty_ratio_ > 1) {
+        throw invalid_argument{};
+      }
+#endif
+    }
+
+    constexpr operator double() const {
+      return duty_ratio_;
+    }
+
+    constexpr double sleep_ratio() const {
+      return 1 - duty_ratio_;
+    }
+
+    constexpr double duty_to_sleep_ratio() const {
+      return duty_ratio_ / sleep_ratio();
+    }
+
+    constexpr double sleep_to_duty_ratio() const {
+      return sleep_ratio() / duty_ratio_;
+    }
+
+    /// \return waiter that sleeps after each test such that the thread consumes CPU time
+    /// for the given fraction of the wall time only
+    detail::lazy_spin_wait_helper make_waiter() const;
+
+  private:
+    double duty_ratio_;
+  };
+
+  namespace detail {
+
+    class lazy_spin_wait_helper {
+    public:
+      lazy_spin_wait_helper(duty_ratio duty_ratio)
+          : sleep_to_duty_ratio_{duty_ratio.sleep_to_duty_ratio()},
+            stopwatch_{},
+            thread_stopwatch_{} {
+      }
+
+      void polling_loop_begin() {
+        stopwatch_.reset();
+        thread_stopwatch_.reset();
+      }
+
+      void polling_loop_end() {
+        const auto wall_time{stopwatch_.read()};
+        const auto duty_time{thread_stopwatch_.read()};
+        const auto slept_time{wall_time - duty_time};
+        const auto sleep_time{sleep_to_duty_ratio_ * duty_time - slept_time};
+        if (sleep_time > detail::stopwatch::duration::zero()) {
+          std::this_thread::sleep_for(sleep_time);
+        }
+      }
+
+      void completed() {
+      }
+
+    private:
+      double sleep_to_duty_ratio_;
+      detail::stopwatch stopwatch_;
+      detail::thread_stopwatch thread_stopwatch_;
+    };
+
+    class busy_waiter {
+    public:
+      void polling_loop_begin() {
+      }
+
+      void polling_loop_end() {
+      }
+
+      void completed() {
+      }
+    };
+
+    class backoff_waiter {
+    public:
+      using duration = std::chrono::nanoseconds;
+
+      backoff_waiter(int spins, int yields, duration min_sleep, duration max_sleep)
+          : spins_{spins}, yields_{yields}, sleep_{min_sleep}, max_sleep_{max_sleep} {
+      }
+
+      void polling_loop_begin() {
+      }
+
+      void polling_loop_end() {
+        pause(duration::max());
+      }
+
+      void completed() {
+      }
+
+      // busy polls for the first tests, yields for the next tests, and then sleeps for
+      // exponentially growing times, but never longer than limit
+      void pause(duration limit) {
+        if (polls_ < spins_) {
+          ++polls_;
+        } else if (polls_ - spins_ < yields_) {
+          ++polls_;
+          std::this_thread::yield();
+        } else {
+          std::this_thread::sleep_for(std::min(sleep_, limit));
+          sleep_ = std::min(2 * sleep_, max_sleep_);
+        }
+      }
+
+    private:
+      int spins_;
+      int yields_;
+      duration sleep_;
+      duration max_sleep_;
+      int polls_{0};
+    };
+
+    class deadline_waiter {
+    public:
+      using clock = std::chrono::steady_clock;
+
+      deadline_waiter(clock::time_point deadline, backoff_waiter backoff)
+          : deadline_{deadline}, backoff_{backoff} {
+      }
+
+      void polling_loop_begin() {
+      }
+
+      void polling_loop_end() {
+        const auto now{clock::now()};
+        if (now < deadline_)
+          backoff_.pause(std::chrono::duration_cast<backoff_waiter::duration>(deadline_ - now));
+      }
+
+      void completed() {
+      }
+
+    private:
+      clock::time_point deadline_;
+      backoff_waiter backoff_;
+    };
+
+    // running estimates of the duration of wait operations and of the time a thread sleeps
+    // longer than requested, updated via exponential moving averages, concurrent updates
+    // may get lost, which merely slows down the adaption
+    class wait_statistics {
+    public:
+      using duration = std::chrono::nanoseconds;
+
+      explicit wait_statistics(double weight) : weight_{weight} {
+      }
+
+      [[nodiscard]] bool empty() const {
+        return mean_.load(std::memory_order_relaxed) < 0;
+      }
+
+      [[nodiscard]] duration mean() const {
+        return duration{std::max<std::int64_t>(mean_.load(std::memory_order_relaxed), 0)};
+      }
+
+      [[nodiscard]] duration deviation() const {
+        return duration{deviation_.load(std::memory_order_relaxed)};
+      }
+
+      [[nodiscard]] duration oversleep() const {
+        return duration{oversleep_.load(std::memory_order_relaxed)};
+      }
+
+      void add_wait(duration d) {
+        const auto mean{mean_.load(std::memory_order_relaxed)};
+        if (mean < 0) {
+          mean_.store(d.count(), std::memory_order_relaxed);
+          deviation_.store(d.count() / 2, std::memory_order_relaxed);
+          return;
+        }
+        const auto error{d.count() - mean};
+        const auto deviation{deviation_.load(std::memory_order_relaxed)};
+        mean_.store(update(mean, d.count()), std::memory_order_relaxed);
+        deviation_.store(update(deviation, error < 0 ? -error : error),
+                         std::memory_order_relaxed);
+      }
+
+      void add_oversleep(duration d) {
+        const auto oversleep{oversleep_.load(std::memory_order_relaxed)};
+        oversleep_.store(update(oversleep, std::max<std::int64_t>(d.count(), 0)),
+                         std::memory_order_relaxed);
+      }
+
+      void reset() {
+        mean_.store(-1, std::memory_order_relaxed);
+        deviation_.store(0, std::memory_order_relaxed);
+        oversleep_.store(0, std::memory_order_relaxed);
+      }
+
+    private:
+      [[nodiscard]] std::int64_t update(std::int64_t average, std::int64_t sample) const {
+        return average +
+               static_cast<std::int64_t>(weight_ * static_cast<double>(sample - average));
+      }
+
+      double weight_;
+      std::atomic<std::int64_t> mean_{-1};
+      std::atomic<std::int64_t> deviation_{0};
+      std::atomic<std::int64_t> oversleep_{0};
+    };
+
+    class adaptive_waiter {
+    public:
+      using clock = std::chrono::steady_clock;
+      using duration = std::chrono::nanoseconds;
+
+      adaptive_waiter(wait_statistics& statistics, backoff_waiter backoff)
+          : statistics_{statistics}, backoff_{backoff}, start_{clock::now()} {
+        if (not statistics_.empty()) {
+          const auto mean{statistics_.mean()};
+          const auto deviation{statistics_.deviation()};
+          // sleep until shortly before the expected completion, spin around it
+          wake_up_ = mean - 2 * deviation - statistics_.oversleep();
+          spin_until_ = mean + 2 * deviation;
+        }
+      }
+
+      void polling_loop_begin() {
+      }
+
+      void polling_loop_end() {
+        const auto elapsed{clock::now() - start_};
+        if (not slept_ and elapsed < wake_up_) {
+          slept_ = true;
+          const auto sleep_time{std::chrono::duration_cast<duration>(wake_up_ - elapsed)};
+          const auto t_0{clock::now()};
+          std::this_thread::sleep_for(sleep_time);
+          statistics_.add_oversleep(
+              std::chrono::duration_cast<duration>(clock::now() - t_0) - sleep_time);
+        } else if (elapsed >= spin_until_)
+          backoff_.pause(duration::max());
+      }
+
+      void completed() {
+        statistics_.add_wait(std::chrono::duration_cast<duration>(clock::now() - start_));
+      }
+
+    private:
+      wait_statistics& statistics_;
+      backoff_waiter backoff_;
+      clock::time_point start_;
+      duration wake_up_{duration::zero()};
+      duration spin_until_{duration::zero()};
+      bool slept_{false};
+    };
+
+  }  // namespace detail
+
+  inline detail::lazy_spin_wait_helper duty_ratio::make_waiter() const {
+    return detail::lazy_spin_wait_helper{*this};
+  }
+
+  //--------------------------------------------------------------------
+
+  /// Wait policy that tests for completion continuously.  It provides the lowest latency,
+  /// but the waiting thread occupies a CPU core for the whole wait.
+  class busy_wait {
+  public:
+    /// \return waiter for one wait operation
+    [[nodiscard]] detail::busy_waiter make_waiter() const {
+      return {};
+    }
+  };
+
+  //--------------------------------------------------------------------
+
+  /// Wait policy that tests for completion continuously first, then yields the processor
+  /// between tests, and finally sleeps between tests for exponentially growing times.  Short
+  /// waits complete with busy-wait latency, long waits consume little CPU time.
+  class backoff_wait {
+  public:
+    /// Type used for sleep times.
+    using duration = std::chrono::nanoseconds;
+
+    /// Creates a backoff wait policy.
+    /// \param spins number of tests before the waiting thread starts to yield
+    /// \param yields number of tests with yielding before the waiting thread starts to sleep
+    /// \param min_sleep duration of the first sleep
+    /// \param max_sleep upper bound for the duration of a single sleep
+    constexpr explicit backoff_wait(int spins = 1000, int yields = 100,
+                                    duration min_sleep = std::chrono::microseconds{1},
+                                    duration max_sleep = std::chrono::milliseconds{1})
+        : spins_{spins}, yields_{yields}, min_sleep_{min_sleep}, max_sleep_{max_sleep} {
+#if defined MPLR_DEBUG
+      if (spins_ < 0 or yields_ < 0 or min_sleep_ <= duration::zero() or
+          max_sleep_ < min_sleep_)
+        throw invalid_argument{};
+#endif
+    }
+
+    /// \return number of tests before the waiting thread starts to yield
+    [[nodiscard]] constexpr int spins() const {
+      return spins_;
+    }
+
+    /// \return number of tests with yielding before the waiting thread starts to sleep
+    [[nodiscard]] constexpr int yields() const {
+      return yields_;
+    }
+
+    /// \return duration of the first sleep
+    [[nodiscard]] constexpr duration min_sleep() const {
+      return min_sleep_;
+    }
+
+    /// \return upper bound for the duration of a single sleep
+    [[nodiscard]] constexpr duration max_sleep() const {
+      return max_sleep_;
+    }
+
+    /// \return waiter for one wait operation
+    [[nodiscard]] detail::backoff_waiter make_waiter() const {
+      return {spins_, yields_, min_sleep_, max_sleep_};
+    }
+
+  private:
+    int spins_;
+    int yields_;
+    duration min_sleep_;
+    duration max_sleep_;
+  };
+
+  //--------------------------------------------------------------------
+
+  /// Wait policy for operations that are expected to complete around a known point in time.
+  /// Before the deadline the waiting thread backs off as with \ref backoff_wait, but no sleep
+  /// extends beyond the deadline.  After the deadline the waiting thread tests for
+  /// completion continuously.
+  class deadline_wait {
+  public:
+    /// Clock the deadline refers to.
+    using clock = std::chrono::steady_clock;
+
+    /// Creates a deadline wait policy.
+    /// \param deadline point in time after which the waiting thread stops sleeping
+    /// \param backoff backoff parameters applied before the deadline
+    explicit deadline_wait(clock::time_point deadline,
+                           const backoff_wait& backoff = backoff_wait{})
+        : deadline_{deadline}, backoff_{backoff} {
+    }
+
+    /// Creates a deadline wait policy with a deadline relative to the current time.
+    /// \param timeout time from now after which the waiting thread stops sleeping
+    /// \param backoff backoff parameters applied before the deadline
+    template<typename Rep, typename Period>
+    explicit deadline_wait(std::chrono::duration<Rep, Period> timeout,
+                           const backoff_wait& backoff = backoff_wait{})
+        : deadline_wait{clock::now() + std::chrono::duration_cast<clock::duration>(timeout),
+                        backoff} {
+    }
+
+    /// \return point in time after which the waiting thread stops sleeping
+    [[nodiscard]] clock::time_point deadline() const {
+      return deadline_;
+    }
+
+    /// \return waiter for one wait operation
+    [[nodiscard]] detail::deadline_waiter make_waiter() const {
+      return {deadline_, backoff_.make_waiter()};
+    }
+
+  private:
+    clock::time_point deadline_;
+    backoff_wait backoff_;
+  };
+
+  //--------------------------------------------------------------------
+
+  /// Self-tuning wait policy for operations that take similar times when repeated, e.g., the
+  /// exchanges of an iterative solver.  The policy records the duration of each wait
+  /// operation it is used for.  Based on these statistics, the waiting thread sleeps until
+  /// shortly before the expected completion, tests continuously around the expected
+  /// completion, and backs off as with \ref backoff_wait if the operation takes unexpectedly
+  /// long.  Without statistics it behaves as \ref backoff_wait.
+  /// \note Copies of a policy share their statistics.  A policy may be used by several
+  /// threads concurrently.
+  class adaptive_wait {
+  public:
+    /// Type used for durations.
+    using duration = std::chrono::nanoseconds;
+
+    /// Creates an adaptive wait policy without statistics.
+    /// \param weight weight of the most recent wait in the running averages of the wait
+    /// durations, must be in the interval (0, 1]
+    /// \param backoff backoff parameters applied when waits take longer than expected
+    explicit adaptive_wait(double weight = 0.125, const backoff_wait& backoff = backoff_wait{})
+        : statistics_{std::make_shared<detail::wait_statistics>(weight)}, backoff_{backoff} {
+#if defined MPLR_DEBUG
+      if (weight <= 0 or weight > 1)
+        throw invalid_argument{};
+#endif
+    }
+
+    /// \return running average of the durations of the waits this policy has been used for,
+    /// zero if it has not been used yet
+    [[nodiscard]] duration expected_duration() const {
+      return statistics_->mean();
+    }
+
+    /// Discards the recorded statistics.
+    void reset() {
+      statistics_->reset();
+    }
+
+    /// \return waiter for one wait operation
+    [[nodiscard]] detail::adaptive_waiter make_waiter() const {
+      return {*statistics_, backoff_.make_waiter()};
+    }
+
+  private:
+    std::shared_ptr<detail::wait_statistics> statistics_;
+    backoff_wait backoff_;
+  };
+
+}  // namespace mplr
+
+#endif
@@ -0,0 +1,528 @@
+#if !(defined MPLR_WINDOW_HPP)
+
+#define MPLR_WINDOW_HPP
+
+#include "mplr/impl/comm_group.hpp"
+#include "mplr/impl/error.hpp"
+#include "mplr/impl/info.hpp"
+#include "mplr/impl/layout.hpp"
+#include "mplr/impl/operator.hpp"
+#include "mplr/impl/request.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+
+namespace mplr {
+
+  /// Kind of a lock of a window in a passive-target access epoch.
+  enum class lock_type : int {
+    /// no other process may access the locked window concurrently
+    exclusive = MPI_LOCK_EXCLUSIVE,
+    /// other processes may hold shared locks of the window concurrently
+    shared = MPI_LOCK_SHARED
+  };
+
+  /// Window for one-sided communication, i.e., memory of a process that other processes of a
+  /// communicator may access remotely.  The window's memory holds elements of type \c T, a
+  /// target displacement in remote memory access operations is given in units of elements.
+  /// Data is transferred within access epochs, which are delimited either by fences of all
+  /// processes (active target synchronization) or by locks of the target windows (passive
+  /// target synchronization).
+  /// \tparam T type of the window's elements, must meet the requirements as described in the
+  /// \verbatim embed:rst:inline :doc:`data_types` \endverbatim section
+  /// \note Creating and freeing a window, including destruction and move-assignment, are
+  /// collective operations that need to be carried out by all processes of the communicator
+  /// the window has been created with.  Accumulate operations support predefined reduction
+  /// operations only.
+  template<typename T>
+  class window {
+    MPI_Win win_{MPI_WIN_NULL};
+    T* data_{nullptr};
+    std::size_t size_{0};
+
+    void free() {
+      if (win_ != MPI_WIN_NULL)
+        MPI_Win_free(&win_);
+      data_ = nullptr;
+      size_ = 0;
+    }
+
+    void check_target([[maybe_unused]] int target_rank) const {
+#if defined MPLR_DEBUG
+      int size;
+      MPI_Group group;
+      MPI_Win_get_group(win_, &group);
+      MPI_Group_size(group, &size);
+      MPI_Group_free(&group);
+      if ((target_rank < 0 or target_rank >= size) and target_rank != proc_null)
+        throw invalid_rank();
+#endif
+    }
+
+    template<typename F>
+    static MPI_Op get_op() {
+      static_assert(detail::is_predefined_op_v<T, std::decay_t<F>>,
+                    "remote memory access supports predefined reduction operations only");
+      return detail::predefined_op<T, std::decay_t<F>>::get();
+    }
+
+    static MPI_Datatype datatype() {
+      return detail::datatype_traits<T>::get_datatype();
+    }
+
+    // displacement, count and data type arguments of a remote memory access function that
+    // describe data with a given layout in the target's window
+    struct target_buffer {
+      MPI_Aint displacement;
+      int count;
+      MPI_Datatype type;
+    };
+
+    // data with a contiguous layout is described by a count of elements, such that the MPI
+    // library does not need to process the layout's derived data type at the target
+    static target_buffer make_target_buffer(MPI_Aint target_displacement, const layout<T>& l) {
+      const auto* span{detail::datatype_traits<layout<T>>::get_contiguous_span(l)};
+      const auto element_size{static_cast<MPI_Aint>(sizeof(T))};
+      if (span != nullptr and span->byte_offset % element_size == 0 and
+          detail::fits_int_count(span->count))
+        return {target_displacement + span->byte_offset / element_size,
+                static_cast<int>(span->count), datatype()};
+      return {target_displacement, 1, detail::datatype_traits<layout<T>>::get_datatype(l)};
+    }
+
+  public:
+    /// Creates an empty window.
+    window() = default;
+
+    /// Creates a window whose memory is allocated by the MPI library.
+    /// \param comm communicator whose processes may access the window
+    /// \param size number of elements of the calling process's window memory
+    /// \param i hints
+    /// \note This is a collective operation that needs to be carried out by all processes of
+    /// the communicator \c comm.
+    window(const communicator& comm, std::size_t size, const info& i = info{}) : size_{size} {
+      MPI_Win_allocate(static_cast<MPI_Aint>(size * sizeof(T)), sizeof(T), i.info_,
+                       comm.native_handle(), &data_, &win_);
+    }
+
+    /// Creates a window that exposes existing memory.
+    /// \param comm communicator whose processes may access the window
+    /// \param data pointer to the calling process's window memory, must remain valid until the
+    /// window has been freed
+    /// \param size number of elements of the calling process's window memory
+    /// \param i hints
+    /// \note This is a collective operation that needs to be carried out by all processes of
+    /// the communicator \c comm.
+    window(const communicator& comm, T* data, std::size_t size, const info& i = info{})
+        : data_{data}, size_{size} {
+      MPI_Win_create(data, static_cast<MPI_Aint>(size * sizeof(T)), sizeof(T), i.info_,
+                     comm.native_handle(), &win_);
+    }
+
+    /// Deleted copy constructor.
+    window(const window&) = delete;
+
+    /// Move constructor.
+    /// \param other the window to move from
+    window(window&& other) noexcept
+        : win_{std::exchange(other.win_, MPI_WIN_NULL)},
+          data_{std::exchange(other.data_, nullptr)},
+          size_{std::exchange(other.size_, 0)} {
+    }
+
+    /// Frees the window.
+    ~window() {
+      free();
+    }
+
+    /// Deleted copy operator.
+    window& operator=(const window&) = delete;
+
+    /// Move operator, frees the window that is assigned to.
+    /// \param other the window to move from
+    /// \return reference to the moved-to window
+    window& operator=(window&& other) noexcept {
+      if (this != &other) {
+        free();
+        win_ = std::exchange(other.win_, MPI_WIN_NULL);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+      }
+      return *this;
+    }
+
+    /// Get the underlying MPI handle of the window.
+    /// \return MPI handle of the window
+    /// \note This function returns a non-owning handle to the underlying MPI window.
+    [[nodiscard]] MPI_Win native_handle() const {
+      return win_;
+    }
+
+    /// \return pointer to the calling process's window memory
+    [[nodiscard]] T* data() const {
+      return data_;
+    }
+
+    /// \return number of elements of the calling process's window memory
+    [[nodiscard]] std::size_t size() const {
+      return size_;
+    }
+
+    // === synchronization ===
+    /// Ends the current and starts a new access epoch of all processes.
+    /// \note This is a collective operation that needs to be carried out by all processes of
+    /// the communicator the window has been created with.
+    void fence() const {
+      MPI_Win_fence(0, win_);
+    }
+
+    /// Starts a passive-target access epoch of a target's window.
+    /// \param target_rank rank of the target process
+    /// \param type kind of the lock
+    void lock(int target_rank, lock_type type = lock_type::exclusive) const {
+      check_target(target_rank);
+      MPI_Win_lock(static_cast<int>(type), target_rank, 0, win_);
+    }
+
+    /// Ends a passive-target access epoch of a target's window, all operations that have
+    /// been started within the epoch are completed at the origin and at the target.
+    /// \param target_rank rank of the target process
+    void unlock(int target_rank) const {
+      check_target(target_rank);
+      MPI_Win_unlock(target_rank, win_);
+    }
+
+    /// Starts a passive-target access epoch of the windows of all processes with a shared
+    /// lock.
+    void lock_all() const {
+      MPI_Win_lock_all(0, win_);
+    }
+
+    /// Ends a passive-target access epoch that has been started by \c lock_all.
+    void unlock_all() const {
+      MPI_Win_unlock_all(win_);
+    }
+
+    /// Completes all operations to a target that have been started within the current
+    /// passive-target access epoch at the origin and at the target.
+    /// \param target_rank rank of the target process
+    void flush(int target_rank) const {
+      check_target(target_rank);
+      MPI_Win_flush(target_rank, win_);
+    }
+
+    /// Completes all operations that have been started within the current passive-target
+    /// access epoch at the origin and at the targets.
+    void flush_all() const {
+      MPI_Win_flush_all(win_);
+    }
+
+    /// Completes all operations to a target that have been started within the current
+    /// passive-target access epoch at the origin, i.e., origin buffers may be reused.
+    /// \param target_rank rank of the target process
+    void flush_local(int target_rank) const {
+      check_target(target_rank);
+      MPI_Win_flush_local(target_rank, win_);
+    }
+
+    /// Completes all operations that have been started within the current passive-target
+    /// access epoch at the origin, i.e., origin buffers may be reused.
+    void flush_local_all() const {
+      MPI_Win_flush_local_all(win_);
+    }
+
+    /// Synchronizes the public and the private copy of the calling process's window memory.
+    void sync() const {
+      MPI_Win_sync(win_);
+    }
+
+    // === put ===
+    /// Writes a single element into a target's window.
+    /// \param data element to write
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    void put(const T& data, int target_rank, MPI_Aint target_displacement) const {
+      check_target(target_rank);
+      MPI_Put(&data, 1, datatype(), target_rank, target_displacement, 1, datatype(), win_);
+    }
+
+    /// Writes data into a target's window.
+    /// \param data data to write
+    /// \param l memory layout of the data to write and of the data in the target's window
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    void put(const T* data, const layout<T>& l, int target_rank,
+             MPI_Aint target_displacement) const {
+      put(data, l, target_rank, target_displacement, l);
+    }
+
+    /// Writes data into a target's window.
+    /// \param data data to write
+    /// \param l memory layout of the data to write
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    /// \param target_l memory layout of the data in the target's window
+    void put(const T* data, const layout<T>& l, int target_rank, MPI_Aint target_displacement,
+             const layout<T>& target_l) const {
+      check_target(target_rank);
+      const auto buffer{detail::make_layout_buffer(data, l)};
+      const auto target{make_target_buffer(target_displacement, target_l)};
+      MPI_Put(buffer.data, buffer.count, buffer.type, target_rank, target.displacement,
+              target.count, target.type, win_);
+    }
+
+    /// Writes a single element into a target's window in a non-blocking manner.
+    /// \param data element to write
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    /// \return request representing the ongoing operation, its completion implies local
+    /// completion only
+    /// \note Request-based operations may be started in passive-target access epochs only.
+    irequest rput(const T& data, int target_rank, MPI_Aint target_displacement) const {
+      check_target(target_rank);
+      MPI_Request req;
+      MPI_Rput(&data, 1, datatype(), target_rank, target_displacement, 1, datatype(), win_,
+               &req);
+      return impl::base_irequest{req};
+    }
+
+    /// Writes data into a target's window in a non-blocking manner.
+    /// \param data data to write
+    /// \param l memory layout of the data to write and of the data in the target's window
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    /// \return request representing the ongoing operation, its completion implies local
+    /// completion only
+    /// \note Request-based operations may be started in passive-target access epochs only.
+    irequest rput(const T* data, const layout<T>& l, int target_rank,
+                  MPI_Aint target_displacement) const {
+      return rput(data, l, target_rank, target_displacement, l);
+    }
+
+    /// Writes data into a target's window in a non-blocking manner.
+    /// \param data data to write
+    /// \param l memory layout of the data to write
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    /// \param target_l memory layout of the data in the target's window
+    /// \return request representing the ongoing operation, its completion implies local
+    /// completion only
+    /// \note Request-based operations may be started in passive-target access epochs only.
+    irequest rput(const T* data, const layout<T>& l, int target_rank,
+                  MPI_Aint target_displacement, const layout<T>& target_l) const {
+      check_target(target_rank);
+      const auto buffer{detail::make_layout_buffer(data, l)};
+      MPI_Request req;
+      const auto target{make_target_buffer(target_displacement, target_l)};
+      MPI_Rput(buffer.data, buffer.count, buffer.type, target_rank, target.displacement,
+               target.count, target.type, win_, &req);
+      return impl::base_irequest{req};
+    }
+
+    // === get ===
+    /// Reads a single element from a target's window.
+    /// \param data will hold the element read
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    void get(T& data, int target_rank, MPI_Aint target_displacement) const {
+      check_target(target_rank);
+      MPI_Get(&data, 1, datatype(), target_rank, target_displacement, 1, datatype(), win_);
+    }
+
+    /// Reads data from a target's window.
+    /// \param data will hold the data read
+    /// \param l memory layout of the data read and of the data in the target's window
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    void get(T* data, const layout<T>& l, int target_rank, MPI_Aint target_displacement) const {
+      get(data, l, target_rank, target_displacement, l);
+    }
+
+    /// Reads data from a target's window.
+    /// \param data will hold the data read
+    /// \param l memory layout of the data read
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    /// \param target_l memory layout of the data in the target's window
+    void get(T* data, const layout<T>& l, int target_rank, MPI_Aint target_displacement,
+             const layout<T>& target_l) const {
+      check_target(target_rank);
+      const auto buffer{detail::make_layout_buffer(data, l)};
+      const auto target{make_target_buffer(target_displacement, target_l)};
+      MPI_Get(buffer.data, buffer.count, buffer.type, target_rank, target.displacement,
+              target.count, target.type, win_);
+    }
+
+    /// Reads a single element from a target's window in a non-blocking manner.
+    /// \param data will hold the element read
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    /// \return request representing the ongoing operation
+    /// \note Request-based operations may be started in passive-target access epochs only.
+    irequest rget(T& data, int target_rank, MPI_Aint target_displacement) const {
+      check_target(target_rank);
+      MPI_Request req;
+      MPI_Rget(&data, 1, datatype(), target_rank, target_displacement, 1, datatype(), win_,
+               &req);
+      return impl::base_irequest{req};
+    }
+
+    /// Reads data from a target's window in a non-blocking manner.
+    /// \param data will hold the data read
+    /// \param l memory layout of the data read and of the data in the target's window
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    /// \return request representing the ongoing operation
+    /// \note Request-based operations may be started in passive-target access epochs only.
+    irequest rget(T* data, const layout<T>& l, int target_rank,
+                  MPI_Aint target_displacement) const {
+      return rget(data, l, target_rank, target_displacement, l);
+    }
+
+    /// Reads data from a target's window in a non-blocking manner.
+    /// \param data will hold the data read
+    /// \param l memory layout of the data read
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    /// \param target_l memory layout of the data in the target's window
+    /// \return request representing the ongoing operation
+    /// \note Request-based operations may be started in passive-target access epochs only.
+    irequest rget(T* data, const layout<T>& l, int target_rank, MPI_Aint target_displacement,
+                  const layout<T>& target_l) const {
+      check_target(target_rank);
+      const auto buffer{detail::make_layout_buffer(data, l)};
+      MPI_Request req;
+      const auto target{make_target_buffer(target_displacement, target_l)};
+      MPI_Rget(buffer.data, buffer.count, buffer.type, target_rank, target.displacement,
+               target.count, target.type, win_, &req);
+      return impl::base_irequest{req};
+    }
+
+    // === accumulate ===
+    /// Combines a single element with an element of a target's window atomically.
+    /// \tparam F type representing the reduction operation, must be a predefined reduction
+    /// operation for elements of type \c T
+    /// \param f reduction operation
+    /// \param data element to combine with the target's element
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    template<typename F>
+    void accumulate([[maybe_unused]] F&& f, const T& data, int target_rank,
+                    MPI_Aint target_displacement) const {
+      check_target(target_rank);
+      MPI_Accumulate(&data, 1, datatype(), target_rank, target_displacement, 1, datatype(),
+                     get_op<F>(), win_);
+    }
+
+    /// Combines data element-wise with data of a target's window atomically.
+    /// \tparam F type representing the reduction operation, must be a predefined reduction
+    /// operation for elements of type \c T
+    /// \param f reduction operation
+    /// \param data data to combine with the target's data
+    /// \param l memory layout of the data and of the data in the target's window
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    template<typename F>
+    void accumulate(F&& f, const T* data, const layout<T>& l, int target_rank,
+                    MPI_Aint target_displacement) const {
+      accumulate(std::forward<F>(f), data, l, target_rank, target_displacement, l);
+    }
+
+    /// Combines data element-wise with data of a target's window atomically.
+    /// \tparam F type representing the reduction operation, must be a predefined reduction
+    /// operation for elements of type \c T
+    /// \param f reduction operation
+    /// \param data data to combine with the target's data
+    /// \param l memory layout of the data
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    /// \param target_l memory layout of the data in the target's window
+    template<typename F>
+    void accumulate([[maybe_unused]] F&& f, const T* data, const layout<T>& l,
+                    int target_rank, MPI_Aint target_displacement,
+                    const layout<T>& target_l) const {
+      check_target(target_rank);
+      const auto buffer{detail::make_layout_buffer(data, l)};
+      const auto target{make_target_buffer(target_displacement, target_l)};
+      MPI_Accumulate(buffer.data, buffer.count, buffer.type, target_rank, target.displacement,
+                     target.count, target.type, get_op<F>(), win_);
+    }
+
+    /// Combines a single element with an element of a target's window atomically and returns
+    /// the target's element before the operation.
+    /// \tparam F type representing the reduction operation, must be a predefined reduction
+    /// operation for elements of type \c T
+    /// \param f reduction operation
+    /// \param data element to combine with the target's element
+    /// \param result will hold the target's element before the operation
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    template<typename F>
+    void get_accumulate([[maybe_unused]] F&& f, const T& data, T& result, int target_rank,
+                        MPI_Aint target_displacement) const {
+      check_target(target_rank);
+      MPI_Get_accumulate(&data, 1, datatype(), &result, 1, datatype(), target_rank,
+                         target_displacement, 1, datatype(), get_op<F>(), win_);
+    }
+
+    /// Combines data element-wise with data of a target's window atomically and returns the
+    /// target's data before the operation.
+    /// \tparam F type representing the reduction operation, must be a predefined reduction
+    /// operation for elements of type \c T
+    /// \param f reduction operation
+    /// \param data data to combine with the target's data
+    /// \param result will hold the target's data before the operation
+    /// \param l memory layout of the data, of the result and of the data in the target's
+    /// window
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    template<typename F>
+    void get_accumulate([[maybe_unused]] F&& f, const T* data, T* result, const layout<T>& l,
+                        int target_rank, MPI_Aint target_displacement) const {
+      check_target(target_rank);
+      const auto buffer{detail::make_layout_buffer(data, l)};
+      const auto result_buffer{detail::make_layout_buffer(result, l)};
+      const auto target{make_target_buffer(target_displacement, l)};
+      MPI_Get_accumulate(buffer.data, buffer.count, buffer.type, result_buffer.data,
+                         result_buffer.count, result_buffer.type, target_rank,
+                         target.displacement, target.count, target.type, get_op<F>(), win_);
+    }
+
+    /// Combines a single element with an element of a target's window atomically and returns
+    /// the target's element before the operation, a faster variant of \c get_accumulate for
+    /// single elements.
+    /// \tparam F type representing the reduction operation, must be a predefined reduction
+    /// operation for elements of type \c T
+    /// \param f reduction operation
+    /// \param data element to combine with the target's element
+    /// \param result will hold the target's element before the operation
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    template<typename F>
+    void fetch_and_op([[maybe_unused]] F&& f, const T& data, T& result, int target_rank,
+                      MPI_Aint target_displacement) const {
+      check_target(target_rank);
+      MPI_Fetch_and_op(&data, &result, datatype(), target_rank, target_displacement,
+                       get_op<F>(), win_);
+    }
+
+    /// Replaces an element of a target's window by a given element atomically if the
+    /// target's element equals a given element.
+    /// \param data element that replaces the target's element
+    /// \param compare element to compare the target's element with
+    /// \param result will hold the target's element before the operation
+    /// \param target_rank rank of the target process
+    /// \param target_displacement position in the target's window in elements
+    void compare_and_swap(const T& data, const T& compare, T& result, int target_rank,
+                          MPI_Aint target_displacement) const {
+      check_target(target_rank);
+      MPI_Compare_and_swap(&data, &compare, &result, datatype(), target_rank,
+                           target_displacement, win_);
+    }
+  };
+
+}  // namespace mplr
+
+#endif
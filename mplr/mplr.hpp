@@ -47,11 +47,15 @@ namespace mplr {
 #include "mplr/impl/tag.hpp"
 #include "mplr/impl/ranks.hpp"
 #include "mplr/impl/flat_memory.hpp"
+#include "mplr/impl/large_count.hpp"
 #include "mplr/impl/datatype.hpp"
+#include "mplr/impl/shared_datatype.hpp"
+#include "mplr/impl/datatype_cache.hpp"
 #include "mplr/impl/layout.hpp"
 #include "mplr/impl/status.hpp"
 #include "mplr/impl/message.hpp"
 #include "mplr/impl/operator.hpp"
+#include "mplr/impl/wait_policy.hpp"
 #include "mplr/impl/request.hpp"
 #include "mplr/impl/info.hpp"
 #include "mplr/impl/comm_group.hpp"
@@ -60,8 +64,13 @@ namespace mplr {
 #include "mplr/impl/cartesian_communicator.hpp"
 #include "mplr/impl/graph_communicator.hpp"
 #include "mplr/impl/file.hpp"
+#include "mplr/impl/window.hpp"
 #include "mplr/impl/distributed_graph_communicator.hpp"
 #include "mplr/impl/distributed_grid.hpp"
+#include "mplr/impl/halo_exchange.hpp"
+#include "mplr/impl/message_aggregator.hpp"
+#include "mplr/impl/active_message.hpp"
+#include "mplr/impl/hierarchical_communicator.hpp"
 // clang-format on
 
 #endif
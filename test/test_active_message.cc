@@ -0,0 +1,93 @@
+#define BOOST_TEST_MODULE active_message
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+
+#include <vector>
+
+
+// each process pings all processes, pings are answered by replies, additionally tokens travel
+// around the ring for a number of hops, handlers send further messages
+bool active_message_test(mplr::active_message_dispatcher &dispatcher, int hops) {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  const mplr::tag_t ping{1}, reply{2}, token{3};
+  int pings{0}, replies{0}, tokens{0};
+  bool ok{true};
+  dispatcher.on<int>(ping, [&](const std::vector<int> &data, const mplr::status_t &s) {
+    if (data.size() != 1 or data[0] != s.source())
+      ok = false;
+    ++pings;
+    dispatcher.send(std::vector<double>(s.source() + 1, 0.5 * rank), s.source(), reply);
+  });
+  dispatcher.on<double>(reply, [&](const std::vector<double> &data, const mplr::status_t &s) {
+    if (data != std::vector<double>(rank + 1, 0.5 * s.source()))
+      ok = false;
+    ++replies;
+  });
+  dispatcher.on<int>(token, [&](const std::vector<int> &data, const mplr::status_t &) {
+    ++tokens;
+    if (data[0] > 1)
+      dispatcher.send(data[0] - 1, (rank + 1) % size, token);
+  });
+  for (int i{0}; i < size; ++i)
+    dispatcher.send(rank, i, ping);
+  dispatcher.send(hops, (rank + 1) % size, token);
+  dispatcher.run();
+  // every process receives one token per hop as tokens of all processes travel in lockstep
+  return ok and pings == size and replies == size and tokens == hops;
+}
+
+
+bool active_message_reuse_test() {
+  const auto comm_world{mplr::comm_world()};
+  mplr::active_message_dispatcher dispatcher{comm_world, 4};
+  const bool ok_1{active_message_test(dispatcher, 10)};
+  // a second exchange starts only after global termination of the first one
+  const bool ok_2{active_message_test(dispatcher, 3)};
+  const auto expected{static_cast<unsigned long long>(4 * comm_world.size() + 13)};
+  return ok_1 and ok_2 and dispatcher.sent() == expected and dispatcher.handled() == expected;
+}
+
+
+bool active_message_wait_policy_test() {
+  const auto comm_world{mplr::comm_world()};
+  mplr::active_message_dispatcher dispatcher{comm_world};
+  int received{0};
+  dispatcher.on<int>(mplr::tag_t{0},
+                     [&](const std::vector<int> &, const mplr::status_t &) { ++received; });
+  if (comm_world.rank() == 0)
+    for (int i{0}; i < comm_world.size(); ++i)
+      dispatcher.send(i, i, mplr::tag_t{0});
+  dispatcher.run(mplr::backoff_wait{});
+  return received == 1;
+}
+
+
+// a message without handler is discarded, the exchange still terminates
+bool active_message_invalid_tag_test() {
+  const auto comm_world{mplr::comm_world()};
+  mplr::active_message_dispatcher dispatcher{comm_world};
+  dispatcher.send(comm_world.rank(), (comm_world.rank() + 1) % comm_world.size(),
+                  mplr::tag_t{7});
+  bool thrown{false};
+  while (not thrown) {
+    try {
+      dispatcher.poll();
+    } catch (mplr::invalid_tag &) {
+      thrown = true;
+    }
+  }
+  dispatcher.run();
+  return dispatcher.sent() == 1 and dispatcher.handled() == 1;
+}
+
+
+BOOST_AUTO_TEST_CASE(active_message) {
+  if (not mplr::initialized())
+    mplr::init();
+  BOOST_TEST(active_message_reuse_test());
+  BOOST_TEST(active_message_wait_policy_test());
+  BOOST_TEST(active_message_invalid_tag_test());
+}
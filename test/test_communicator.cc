@@ -3,6 +3,8 @@
 #include "boost/test/included/unit_test.hpp"
 #include "mplr/mplr.hpp"
 
+#include <utility>
+
 
 // test properties of the predefined communicator comm_word
 bool communicator_comm_world_test() {
@@ -101,6 +103,38 @@ bool communicator_comm_self_test() {
 }
 
 
+// test that size and rank survive moves of a communicator and that wrapped MPI communicators
+// are not freed
+bool communicator_move_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int rank{comm_world.rank()};
+  mplr::communicator comm_1{mplr::communicator::split, comm_world, rank % 2 == 0};
+  int size_mpi;
+  MPI_Comm_size(comm_1.native_handle(), &size_mpi);
+  int rank_mpi;
+  MPI_Comm_rank(comm_1.native_handle(), &rank_mpi);
+  mplr::communicator comm_2{std::move(comm_1)};
+  if (comm_1.is_valid() or not comm_2.is_valid())
+    return false;
+  if (comm_2.size() != size_mpi or comm_2.rank() != rank_mpi)
+    return false;
+  mplr::communicator comm_3{comm_world, {}};
+  comm_3 = std::move(comm_2);
+  if (comm_2.is_valid() or comm_3.size() != size_mpi or comm_3.rank() != rank_mpi)
+    return false;
+  MPI_Comm comm_mpi;
+  MPI_Comm_dup(MPI_COMM_WORLD, &comm_mpi);
+  {
+    mplr::mpi_communicator comm_4{comm_mpi};
+    mplr::communicator comm_5{std::move(comm_4)};
+    if (comm_5.size() != comm_world.size() or comm_5.rank() != rank)
+      return false;
+  }
+  // must not have been freed by one of the wrappers
+  return MPI_Comm_free(&comm_mpi) == MPI_SUCCESS and comm_mpi == MPI_COMM_NULL;
+}
+
+
 BOOST_AUTO_TEST_CASE(communicator) {
   if (not mplr::initialized())
     mplr::init();
@@ -110,4 +144,5 @@ BOOST_AUTO_TEST_CASE(communicator) {
   BOOST_TEST(communicator_comm_world_split_test());
   BOOST_TEST(communicator_comm_world_split_shared_memory_test());
   BOOST_TEST(communicator_comm_self_test());
+  BOOST_TEST(communicator_move_test());
 }
@@ -27,6 +27,22 @@ bool iallgather_test(const T &val) {
 }
 
 
+
+template<typename T>
+bool allgather_init_test(const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  std::vector<T> v(comm_world.size());
+  auto r{comm_world.allgather_init(val, v.data())};
+  for (int iteration{0}; iteration < 2; ++iteration) {
+    std::fill(v.begin(), v.end(), T{});
+    r.start();
+    r.wait();
+    if (not std::all_of(v.begin(), v.end(), [&val](const auto &x) { return x == val; }))
+      return false;
+  }
+  return true;
+}
+
 BOOST_AUTO_TEST_CASE(allgather) {
   if (not mplr::initialized())
     mplr::init();
@@ -36,4 +52,7 @@ BOOST_AUTO_TEST_CASE(allgather) {
 
   BOOST_TEST(iallgather_test(1.0));
   BOOST_TEST(iallgather_test(std::array{1, 2, 3, 4}));
+
+  BOOST_TEST(allgather_init_test(1.0));
+  BOOST_TEST(allgather_init_test(std::array{1, 2, 3, 4}));
 }
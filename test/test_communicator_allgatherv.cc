@@ -4,6 +4,7 @@
 #include "mplr/mplr.hpp"
 #include "test_helper.hpp"
 
+#include <algorithm>
 #include <numeric>
 #include <vector>
 
@@ -85,6 +86,44 @@ bool iallgatherv_contiguous_test(const T &val) {
 }
 
 
+template<typename T>
+bool allgatherv_vector_test(const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  const int N{(comm_world.size() * comm_world.size() + comm_world.size()) / 2};
+  std::vector<T> v1(N);
+  std::iota(begin(v1), end(v1), val);
+  const int rank{comm_world.rank()};
+  const int offset{(rank * rank + rank) / 2};
+  const std::vector<T> send_data(v1.begin() + offset, v1.begin() + offset + rank + 1);
+  // the second call reuses the internal scratch buffers
+  return comm_world.allgatherv(send_data) == v1 and comm_world.allgatherv(send_data) == v1;
+}
+
+
+
+template<typename T>
+bool allgatherv_init_test(const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  const int N{(comm_world.size() * comm_world.size() + comm_world.size()) / 2};
+  std::vector<T> v1(N);
+  std::vector<T> v2(N);
+  std::iota(begin(v1), end(v1), val);
+  mplr::layouts<T> l;
+  for (int i{0}, i_end{comm_world.size()}, offset{0}; i < i_end; ++i) {
+    l.push_back(mplr::indexed_layout<T>({{i + 1, offset}}));
+    offset += i + 1;
+  }
+  auto r{comm_world.allgatherv_init(v1.data(), l[comm_world.rank()], v2.data(), l)};
+  for (int iteration{0}; iteration < 2; ++iteration) {
+    std::fill(begin(v2), end(v2), T{});
+    r.start();
+    r.wait();
+    if (v1 != v2)
+      return false;
+  }
+  return true;
+}
+
 BOOST_AUTO_TEST_CASE(allgatherv) {
   if (not mplr::initialized())
     mplr::init();
@@ -100,4 +139,10 @@ BOOST_AUTO_TEST_CASE(allgatherv) {
 
   BOOST_TEST(allgatherv_contiguous_test(1.0));
   BOOST_TEST(allgatherv_contiguous_test(tuple{1, 2.0}));
+
+  BOOST_TEST(allgatherv_vector_test(1.0));
+  BOOST_TEST(allgatherv_vector_test(tuple{1, 2.0}));
+
+  BOOST_TEST(allgatherv_init_test(1.0));
+  BOOST_TEST(allgatherv_init_test(tuple{1, 2.0}));
 }
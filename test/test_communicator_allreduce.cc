@@ -4,6 +4,10 @@
 #include "mplr/mplr.hpp"
 #include "test_helper.hpp"
 
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+
 
 template<typename F, typename T>
 bool allreduce_test(F f, const T &val) {
@@ -165,6 +169,110 @@ bool iallreduce_test_with_layout_inplace(F f, const T &val) {
 }
 
 
+// persistent all-reduce, which is started several times with different input data
+template<typename F, typename T>
+bool allreduce_init_test(F f, const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  T x{};
+  T y{};
+  auto r{comm_world.allreduce_init(f, x, y)};
+  for (int iteration{0}; iteration < 3; ++iteration) {
+    x = val;
+    for (int i{0}; i < comm_world.rank() + iteration; ++i)
+      ++x;
+    r.start();
+    r.wait();
+    T x2{val};
+    for (int i{0}; i < iteration; ++i)
+      ++x2;
+    T expected{x2};
+    for (int i{1}; i < comm_world.size(); ++i) {
+      ++x2;
+      expected = f(expected, x2);
+    }
+    if (not(y == expected))
+      return false;
+  }
+  return true;
+}
+
+
+// several persistent collective operations, which are started together via a pool
+template<typename F, typename T>
+bool allreduce_init_pool_test(F f, const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  T x{val};
+  for (int i{0}; i < comm_world.rank(); ++i)
+    ++x;
+  const int n{5};
+  mplr::contiguous_layout<T> l(n);
+  std::vector<T> v_x(n, x);
+  std::vector<T> v_y(n);
+  T y{};
+  mplr::prequest_pool r;
+  r.push(comm_world.allreduce_init(f, v_x.data(), v_y.data(), l));
+  r.push(comm_world.barrier_init());
+  r.push(comm_world.allreduce_init(f, x, y));
+  T expected{val};
+  T x2{val};
+  for (int i{1}; i < comm_world.size(); ++i) {
+    ++x2;
+    expected = f(expected, x2);
+  }
+  std::vector<T> v_expected(n, expected);
+  for (int iteration{0}; iteration < 3; ++iteration) {
+    std::fill(v_y.begin(), v_y.end(), T{});
+    y = T{};
+    r.startall();
+    r.waitall();
+    if (not(v_y == v_expected and y == expected))
+      return false;
+  }
+  return true;
+}
+
+
+// reduction operations on builtin types that are mapped to predefined MPI operations,
+// the value contributed by each process is given by g(rank)
+template<typename F, typename G>
+bool allreduce_predefined_test(F f, G g) {
+  const auto comm_world{mplr::comm_world()};
+  using T = decltype(g(0));
+  const T x{g(comm_world.rank())};
+  T y{};
+  comm_world.allreduce(f, x, y);
+  T expected{g(0)};
+  for (int i{1}; i < comm_world.size(); ++i)
+    expected = f(expected, g(i));
+  return y == expected;
+}
+
+
+// user-defined reduction operation that reduces a whole block of values at once
+class batched_plus {
+public:
+  void operator()(const double *in, double *in_out, int n) const {
+    for (int i{0}; i < n; ++i)
+      in_out[i] += in[i];
+  }
+};
+
+
+// user-defined reduction operations over blocks of values, which are large enough to be split
+// into several pieces by the MPI library
+bool allreduce_batched_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int n{100000};
+  mplr::contiguous_layout<double> l(n);
+  std::vector<double> v_x(n, comm_world.rank());
+  std::vector<double> v_y(n);
+  comm_world.allreduce(batched_plus(), v_x.data(), v_y.data(), l);
+  const int size{comm_world.size()};
+  const double sum{0.5 * size * (size - 1)};
+  return std::all_of(v_y.begin(), v_y.end(), [sum](double y) { return y == sum; });
+}
+
+
 BOOST_AUTO_TEST_CASE(allreduce) {
   if (not mplr::initialized())
     mplr::init();
@@ -228,3 +336,54 @@ BOOST_AUTO_TEST_CASE(allreduce) {
   BOOST_TEST(
       iallreduce_test_with_layout_inplace([](auto a, auto b) { return a + b; }, tuple{1, 2.0}));
 }
+
+
+BOOST_AUTO_TEST_CASE(allreduce_init) {
+  if (not mplr::initialized())
+    mplr::init();
+
+  BOOST_TEST(allreduce_init_test(add<double>(), 1.0));
+  BOOST_TEST(allreduce_init_test(add<tuple>(), tuple{1, 2.0}));
+  BOOST_TEST(allreduce_init_test(mplr::plus<double>(), 1.0));
+  BOOST_TEST(allreduce_init_test([](auto a, auto b) { return a + b; }, 1.0));
+
+  BOOST_TEST(allreduce_init_pool_test(add<double>(), 1.0));
+  BOOST_TEST(allreduce_init_pool_test(mplr::plus<tuple>(), tuple{1, 2.0}));
+}
+
+
+BOOST_AUTO_TEST_CASE(allreduce_predefined) {
+  if (not mplr::initialized())
+    mplr::init();
+
+  BOOST_TEST(allreduce_predefined_test(mplr::max<int>(), [](int i) { return 3 - i; }));
+  BOOST_TEST(allreduce_predefined_test(mplr::min<long double>(),
+                                       [](int i) { return static_cast<long double>(i); }));
+  BOOST_TEST(allreduce_predefined_test(mplr::plus<unsigned long>(),
+                                       [](int i) { return static_cast<unsigned long>(i); }));
+  BOOST_TEST(allreduce_predefined_test(mplr::multiplies<std::complex<double>>(), [](int i) {
+    return std::complex<double>(1, i);
+  }));
+  BOOST_TEST(
+      allreduce_predefined_test(mplr::logical_and<bool>(), [](int i) { return i < 2; }));
+  BOOST_TEST(allreduce_predefined_test(mplr::logical_or<int>(), [](int i) { return i % 2; }));
+  BOOST_TEST(
+      allreduce_predefined_test(mplr::logical_xor<bool>(), [](int i) { return i > 0; }));
+  BOOST_TEST(allreduce_predefined_test(mplr::bit_and<unsigned char>(), [](int i) {
+    return static_cast<unsigned char>(0xff - i);
+  }));
+  BOOST_TEST(allreduce_predefined_test(mplr::bit_or<short>(),
+                                       [](int i) { return static_cast<short>(1 << i); }));
+  BOOST_TEST(allreduce_predefined_test(mplr::bit_xor<std::byte>(),
+                                       [](int i) { return static_cast<std::byte>(i + 1); }));
+  // integer logical_xor is not mapped to MPI_LXOR, it computes the bitwise exclusive or
+  BOOST_TEST(allreduce_predefined_test(mplr::logical_xor<int>(), [](int i) { return i + 1; }));
+}
+
+
+BOOST_AUTO_TEST_CASE(allreduce_batched) {
+  if (not mplr::initialized())
+    mplr::init();
+
+  BOOST_TEST(allreduce_batched_test());
+}
@@ -126,6 +126,32 @@ bool ialltoall_inplace_test(const T &val) {
 }
 
 
+
+template<typename T>
+bool alltoall_init_test(const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  T send_val{val};
+  for (int i{0}; i < comm_world.rank(); ++i)
+    ++send_val;
+  std::vector<T> send_data(comm_world.size(), send_val);
+  std::vector<T> recv_data(comm_world.size());
+  std::vector<T> expected;
+  T expected_val{val};
+  for (int i{0}; i < comm_world.size(); ++i) {
+    expected.push_back(expected_val);
+    ++expected_val;
+  }
+  auto r{comm_world.alltoall_init(send_data.data(), recv_data.data())};
+  for (int iteration{0}; iteration < 2; ++iteration) {
+    std::fill(recv_data.begin(), recv_data.end(), T{});
+    r.start();
+    r.wait();
+    if (recv_data != expected)
+      return false;
+  }
+  return true;
+}
+
 BOOST_AUTO_TEST_CASE(alltoall) {
   if (not mplr::initialized())
     mplr::init();
@@ -147,4 +173,7 @@ BOOST_AUTO_TEST_CASE(alltoall) {
 
   BOOST_TEST(ialltoall_inplace_test(1.0));
   BOOST_TEST(ialltoall_inplace_test(tuple{1, 2.0}));
+
+  BOOST_TEST(alltoall_init_test(1.0));
+  BOOST_TEST(alltoall_init_test(tuple{1, 2.0}));
 }
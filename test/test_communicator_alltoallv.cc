@@ -4,6 +4,10 @@
 #include "mplr/mplr.hpp"
 #include "test_helper.hpp"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 
 template<typename T>
 bool alltoallv_with_displacements_test(const T &val) {
@@ -208,6 +212,103 @@ bool ialltoallv_without_displacements_test(const T &val) {
 }
 
 
+template<typename T>
+bool ialltoallv_pool_test(const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  const int N_processes{comm_world.size()};
+  const int N_send{comm_world.rank() + 1};  // number of elements to send to each process
+  const int N_recv{(N_processes * N_processes + N_processes) /
+                   2};  // total number of elements to receive
+  const int N_ops{4};  // number of concurrent operations
+  std::vector<T> send_data;
+  std::vector<std::vector<T>> recv_data(N_ops, std::vector<T>(N_recv));
+  std::vector<T> expected;
+  T send_val{val};
+  T expected_val{val};
+  for (int i{0}; i < comm_world.rank(); ++i)
+    ++expected_val;
+  for (int j{0}; j < N_processes; ++j) {
+    for (int i{0}; i < N_send; ++i)
+      send_data.push_back(send_val);
+    ++send_val;
+    for (int i{0}; i < j + 1; ++i)
+      expected.push_back(expected_val);
+  }
+  mplr::irequest_pool r;
+  for (int k{0}; k < N_ops; ++k) {
+    // layouts and displacements go out of scope before the operations complete
+    mplr::layouts<T> sendls;
+    mplr::layouts<T> recvls;
+    mplr::displacements senddispls;
+    mplr::displacements recvdispls;
+    for (int j{0}; j < N_processes; ++j) {
+      sendls.push_back(mplr::vector_layout<T>(N_send));
+      senddispls.push_back(j * N_send);
+      recvls.push_back(mplr::vector_layout<T>(j + 1));
+      recvdispls.push_back((j * j + j) / 2);
+    }
+    r.push(comm_world.ialltoallv(send_data.data(), sendls, senddispls, recv_data[k].data(),
+                                 recvls, recvdispls));
+  }
+  r.waitall();
+  return std::all_of(recv_data.begin(), recv_data.end(),
+                     [&expected](const auto &data) { return data == expected; });
+}
+
+
+// persistent all-to-all, which is started several times
+template<typename T>
+bool alltoallv_init_test(const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  const int N_processes{comm_world.size()};
+  const int N_send{comm_world.rank() + 1};  // number of elements to send to each process
+  const int N_recv{(N_processes * N_processes + N_processes) /
+                   2};  // total number of elements to receive
+  std::vector<T> send_data;
+  std::vector<T> recv_data(N_recv);
+  std::vector<T> recv_data_contiguous(N_recv);
+  std::vector<T> expected;
+  mplr::layouts<T> sendls;
+  mplr::layouts<T> recvls;
+  mplr::contiguous_layouts<T> sendls_contiguous;
+  mplr::contiguous_layouts<T> recvls_contiguous;
+  mplr::displacements senddispls;
+  mplr::displacements recvdispls;
+  T send_val{val};
+  T expected_val{val};
+  for (int i{0}; i < comm_world.rank(); ++i)
+    ++expected_val;
+  for (int j{0}; j < N_processes; ++j) {
+    for (int i{0}; i < N_send; ++i)
+      send_data.push_back(send_val);
+    ++send_val;
+    sendls.push_back(mplr::vector_layout<T>(N_send));
+    sendls_contiguous.push_back(mplr::contiguous_layout<T>(N_send));
+    senddispls.push_back(j * N_send);
+    recvls.push_back(mplr::vector_layout<T>(j + 1));
+    recvls_contiguous.push_back(mplr::contiguous_layout<T>(j + 1));
+    recvdispls.push_back((j * j + j) / 2);
+    for (int i{0}; i < j + 1; ++i)
+      expected.push_back(expected_val);
+  }
+  mplr::prequest_pool r;
+  r.push(comm_world.alltoallv_init(send_data.data(), sendls, senddispls, recv_data.data(),
+                                   recvls, recvdispls));
+  r.push(comm_world.alltoallv_init(send_data.data(), sendls_contiguous, senddispls,
+                                   recv_data_contiguous.data(), recvls_contiguous,
+                                   recvdispls));
+  for (int iteration{0}; iteration < 3; ++iteration) {
+    std::fill(recv_data.begin(), recv_data.end(), T{});
+    std::fill(recv_data_contiguous.begin(), recv_data_contiguous.end(), T{});
+    r.startall();
+    r.waitall();
+    if (recv_data != expected or recv_data_contiguous != expected)
+      return false;
+  }
+  return true;
+}
+
+
 template<typename T>
 bool alltoallv_in_place_with_displacements_test(const T &val) {
   const auto comm_world{mplr::comm_world()};
@@ -322,6 +423,31 @@ bool ialltoallv_in_place_without_displacements_test(const T &val) {
 }
 
 
+template<typename T>
+bool alltoallv_vector_test(const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  // process i sends (i + j) % 3 elements to process j, some messages are empty
+  auto make_block{[&val](int source, int destination) {
+    std::vector<T> block((source + destination) % 3);
+    std::iota(begin(block), end(block), val);
+    for (int k{0}; k < source; ++k)
+      for (auto &x : block)
+        ++x;
+    return block;
+  }};
+  std::vector<std::vector<T>> sendrecv_data;
+  for (int i{0}; i < size; ++i)
+    sendrecv_data.push_back(make_block(rank, i));
+  comm_world.alltoallv(sendrecv_data);
+  for (int i{0}; i < size; ++i)
+    if (sendrecv_data[i] != make_block(i, rank))
+      return false;
+  return true;
+}
+
+
 BOOST_AUTO_TEST_CASE(alltoallv) {
   if (not mplr::initialized())
     mplr::init();
@@ -344,6 +470,12 @@ BOOST_AUTO_TEST_CASE(alltoallv) {
   BOOST_TEST(ialltoallv_without_displacements_test(1.0));
   BOOST_TEST(ialltoallv_without_displacements_test(tuple{1, 2.0}));
 
+  BOOST_TEST(ialltoallv_pool_test(1.0));
+  BOOST_TEST(ialltoallv_pool_test(tuple{1, 2.0}));
+
+  BOOST_TEST(alltoallv_init_test(1.0));
+  BOOST_TEST(alltoallv_init_test(tuple{1, 2.0}));
+
   BOOST_TEST(alltoallv_in_place_with_displacements_test(1.0));
   BOOST_TEST(alltoallv_in_place_with_displacements_test(tuple{1, 2.0}));
 
@@ -358,4 +490,7 @@ BOOST_AUTO_TEST_CASE(alltoallv) {
   BOOST_TEST(ialltoallv_in_place_without_displacements_test(1.0));
   BOOST_TEST(ialltoallv_in_place_without_displacements_test(tuple{1, 2.0}));
 #endif
+
+  BOOST_TEST(alltoallv_vector_test(1.0));
+  BOOST_TEST(alltoallv_vector_test(tuple{1, 2.0}));
 }
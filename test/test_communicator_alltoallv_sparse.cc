@@ -0,0 +1,112 @@
+#define BOOST_TEST_MODULE communicator_alltoallv_sparse
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+
+#include <set>
+#include <vector>
+
+
+// each process sends to its successors at distance one and three, the i-th element for
+// destination d is 1000 * source + 10 * d + i, every second element of the send buffer is
+// skipped
+std::set<int> destinations(int rank, int size) {
+  return {(rank + 1) % size, (rank + 3) % size};
+}
+
+
+int message_size(int source, int destination) {
+  return 1 + (source + destination) % 3;
+}
+
+
+bool alltoallv_sparse_test(mplr::sparse_schedule schedule, bool non_blocking) {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::vector<int> send_data;
+  mplr::sparse_layouts<int> sendls;
+  for (int destination : destinations(rank, size)) {
+    const int n{message_size(rank, destination)};
+    sendls.push_back(destination, mplr::strided_vector_layout<int>(n, 1, 2),
+                     static_cast<MPI_Aint>(send_data.size()));
+    for (int i{0}; i < n; ++i) {
+      send_data.push_back(1000 * rank + 10 * destination + i);
+      send_data.push_back(-1);
+    }
+  }
+  std::vector<int> expected;
+  mplr::sparse_layouts<int> recvls;
+  for (int source{0}; source < size; ++source)
+    if (destinations(source, size).count(rank) > 0) {
+      const int n{message_size(source, rank)};
+      recvls.push_back(source, mplr::vector_layout<int>(n),
+                       static_cast<MPI_Aint>(expected.size()));
+      for (int i{0}; i < n; ++i)
+        expected.push_back(1000 * source + 10 * rank + i);
+    }
+  std::vector<int> recv_data(expected.size(), -1);
+  if (non_blocking) {
+    auto requests{comm_world.ialltoallv(send_data.data(), sendls, recv_data.data(), recvls,
+                                        mplr::tag_t{1})};
+    requests.waitall();
+  } else
+    comm_world.alltoallv(send_data.data(), sendls, recv_data.data(), recvls, mplr::tag_t{1},
+                         schedule);
+  return recv_data == expected;
+}
+
+
+// the same exchange via sparse and dense layouts with equal displacements in units of the
+// element type gives the same result
+bool alltoallv_sparse_dense_test(mplr::sparse_schedule schedule) {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  constexpr int n{3};
+  const std::vector<double> send_data(2 * n * size, rank);
+  mplr::sparse_layouts<double> sparse_sendls, sparse_recvls;
+  mplr::layouts<double> dense_sendls(size), dense_recvls(size);
+  mplr::displacements senddispls(size), recvdispls(size);
+  for (int destination : destinations(rank, size)) {
+    sparse_sendls.push_back(destination, mplr::vector_layout<double>(n), n * destination);
+    dense_sendls[destination] = mplr::vector_layout<double>(n);
+    senddispls[destination] = n * destination;
+  }
+  for (int source{0}; source < size; ++source)
+    if (destinations(source, size).count(rank) > 0) {
+      sparse_recvls.push_back(source, mplr::vector_layout<double>(n), 2 * n * source + 1);
+      dense_recvls[source] = mplr::vector_layout<double>(n);
+      recvdispls[source] = 2 * n * source + 1;
+    }
+  std::vector<double> sparse_recv_data(2 * n * size, -1);
+  std::vector<double> dense_recv_data(2 * n * size, -1);
+  comm_world.alltoallv(send_data.data(), sparse_sendls, sparse_recv_data.data(),
+                       sparse_recvls, mplr::tag_t{3}, schedule);
+  comm_world.alltoallv(send_data.data(), dense_sendls, senddispls, dense_recv_data.data(),
+                       dense_recvls, recvdispls);
+  return sparse_recv_data == dense_recv_data;
+}
+
+// no process exchanges any data
+bool alltoallv_sparse_empty_test() {
+  const auto comm_world{mplr::comm_world()};
+  const mplr::sparse_layouts<double> ls;
+  const std::vector<double> send_data(1, 1.0);
+  std::vector<double> recv_data(1, 2.0);
+  comm_world.alltoallv(send_data.data(), ls, recv_data.data(), ls, mplr::tag_t{2});
+  return recv_data[0] == 2.0;
+}
+
+
+BOOST_AUTO_TEST_CASE(alltoallv_sparse) {
+  if (not mplr::initialized())
+    mplr::init();
+  BOOST_TEST(alltoallv_sparse_test(mplr::sparse_schedule::automatic, false));
+  BOOST_TEST(alltoallv_sparse_test(mplr::sparse_schedule::point_to_point, false));
+  BOOST_TEST(alltoallv_sparse_test(mplr::sparse_schedule::collective, false));
+  BOOST_TEST(alltoallv_sparse_test(mplr::sparse_schedule::automatic, true));
+  BOOST_TEST(alltoallv_sparse_dense_test(mplr::sparse_schedule::point_to_point));
+  BOOST_TEST(alltoallv_sparse_dense_test(mplr::sparse_schedule::collective));
+  BOOST_TEST(alltoallv_sparse_empty_test());
+}
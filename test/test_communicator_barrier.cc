@@ -19,10 +19,25 @@ bool ibarrier_test() {
 }
 
 
+bool barrier_init_test() {
+  const auto comm_world = mplr::comm_world();
+  auto r{comm_world.barrier_init()};
+  for (int iteration{0}; iteration < 3; ++iteration) {
+    r.start();
+    r.wait();
+    // a completed persistent request is inactive, not null, also if it is emulated
+    if (not r.is_valid())
+      return false;
+  }
+  return true;
+}
+
+
 BOOST_AUTO_TEST_CASE(barrier) {
   if (not mplr::initialized())
     mplr::init();
 
   BOOST_TEST(barrier_test());
   BOOST_TEST(ibarrier_test());
+  BOOST_TEST(barrier_init_test());
 }
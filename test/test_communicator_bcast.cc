@@ -3,6 +3,8 @@
 #include "boost/test/included/unit_test.hpp"
 #include "mplr/mplr.hpp"
 
+#include <algorithm>
+
 
 template<typename T>
 bool bcast_test(const T &val) {
@@ -58,6 +60,44 @@ bool ibcast_test(const std::vector<T> &send, const std::vector<T> &expected,
 }
 
 
+template<typename T>
+bool bcast_init_test(const T &val) {
+  const auto comm_world = mplr::comm_world();
+  T x{};
+  auto r{comm_world.bcast_init(0, x)};
+  for (int iteration{0}; iteration < 3; ++iteration) {
+    x = T{};
+    if (comm_world.rank() == 0)
+      x = val;
+    r.start();
+    r.wait();
+    if (not(x == val))
+      return false;
+  }
+  return true;
+}
+
+
+template<typename T>
+bool bcast_init_test(const std::vector<T> &send, const std::vector<T> &expected,
+                     const mplr::layout<T> &l) {
+  const auto comm_world = mplr::comm_world();
+  std::vector<T> x(send.size(), {});
+  auto r{comm_world.bcast_init(0, x.data(), l)};
+  for (int iteration{0}; iteration < 3; ++iteration) {
+    if (comm_world.rank() == 0)
+      x = send;
+    else
+      std::fill(x.begin(), x.end(), T{});
+    r.start();
+    r.wait();
+    if (x != (comm_world.rank() == 0 ? send : expected))
+      return false;
+  }
+  return true;
+}
+
+
 BOOST_AUTO_TEST_CASE(bcast) {
   if (not mplr::initialized())
     mplr::init();
@@ -71,4 +111,9 @@ BOOST_AUTO_TEST_CASE(bcast) {
   BOOST_TEST(ibcast_test(std::array{1, 2, 3, 4}));
   BOOST_TEST(ibcast_test(std::vector{1, 2, 3, 4, 5, 6}, std::vector{0, 2, 3, 0, 5, 0},
                          mplr::indexed_layout<int>{{{2, 1}, {1, 4}}}));
+
+  BOOST_TEST(bcast_init_test(1.0));
+  BOOST_TEST(bcast_init_test(std::array{1, 2, 3, 4}));
+  BOOST_TEST(bcast_init_test(std::vector{1, 2, 3, 4, 5, 6}, std::vector{0, 2, 3, 0, 5, 0},
+                             mplr::indexed_layout<int>{{{2, 1}, {1, 4}}}));
 }
@@ -3,6 +3,7 @@
 #include "boost/test/included/unit_test.hpp"
 #include "mplr/mplr.hpp"
 
+#include <algorithm>
 #include <iterator>
 
 
@@ -80,6 +81,21 @@ bool igather_test(const std::vector<T> &send, const std::vector<T> &expected,
 }
 
 
+
+template<typename T>
+bool gather_init_test(const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  std::vector<T> v(comm_world.rank() == 0 ? comm_world.size() : 0);
+  auto r{comm_world.gather_init(0, val, v.data())};
+  for (int iteration{0}; iteration < 3; ++iteration) {
+    r.start();
+    r.wait();
+    if (not r.is_valid())
+      return false;
+  }
+  return std::all_of(v.begin(), v.end(), [&val](const auto &x) { return x == val; });
+}
+
 BOOST_AUTO_TEST_CASE(gather) {
   if (not mplr::initialized())
     mplr::init();
@@ -103,4 +119,7 @@ BOOST_AUTO_TEST_CASE(gather) {
     l.resize(0, 6);
     BOOST_TEST(igather_test(send, expected, l));
   }
+
+  BOOST_TEST(gather_init_test(1.0));
+  BOOST_TEST(gather_init_test(std::array{1, 2, 3, 4}));
 }
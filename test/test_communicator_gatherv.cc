@@ -4,7 +4,10 @@
 #include "mplr/mplr.hpp"
 #include "test_helper.hpp"
 
+#include <algorithm>
+#include <numeric>
 #include <tuple>
+#include <vector>
 
 
 template<use_non_root_overload variant, typename T>
@@ -145,6 +148,52 @@ bool igatherv_contiguous_test(const T &val) {
 }
 
 
+template<typename T>
+bool gatherv_vector_test(const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  const int N{(comm_world.size() * comm_world.size() + comm_world.size()) / 2};
+  std::vector<T> v1(N);
+  std::iota(begin(v1), end(v1), val);
+  const int rank{comm_world.rank()};
+  const int offset{(rank * rank + rank) / 2};
+  const std::vector<T> send_data(v1.begin() + offset, v1.begin() + offset + rank + 1);
+  const int root_rank{comm_world.size() - 1};
+  const auto recv_data{comm_world.gatherv(root_rank, send_data)};
+  return rank == root_rank ? recv_data == v1 : recv_data.empty();
+}
+
+
+
+template<typename T>
+bool gatherv_init_test(const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  const int N{(comm_world.size() * comm_world.size() + comm_world.size()) / 2};
+  std::vector<T> v_gather(N);
+  std::vector<T> v_send(comm_world.rank() + 1);
+  std::vector<T> v_expected(N);
+  std::iota(begin(v_expected), end(v_expected), val);
+  mplr::layouts<T> layouts;
+  for (int i{0}, i_end{comm_world.size()}, offset{0}; i < i_end; ++i) {
+    layouts.push_back(mplr::indexed_layout<T>({{i + 1, offset}}));
+    offset += i + 1;
+  }
+  T t_val{val};
+  for (int i{0}, i_end{(comm_world.rank() * comm_world.rank() + comm_world.rank()) / 2};
+       i < i_end; ++i)
+    ++t_val;
+  std::iota(begin(v_send), end(v_send), t_val);
+  const mplr::vector_layout<T> layout(comm_world.rank() + 1);
+  auto r{comm_world.gatherv_init(0, v_send.data(), layout, v_gather.data(), layouts)};
+  for (int iteration{0}; iteration < 2; ++iteration) {
+    std::fill(begin(v_gather), end(v_gather), T{});
+    r.start();
+    r.wait();
+    if (comm_world.rank() == 0 and v_gather != v_expected)
+      return false;
+  }
+  return true;
+}
+
 BOOST_AUTO_TEST_CASE(gatherv) {
   if (not mplr::initialized())
     mplr::init();
@@ -175,4 +224,10 @@ BOOST_AUTO_TEST_CASE(gatherv) {
 
   BOOST_TEST(igatherv_contiguous_test<use_non_root_overload::yes>(1.0));
   BOOST_TEST(igatherv_contiguous_test<use_non_root_overload::yes>(tuple{1, 2.0}));
+
+  BOOST_TEST(gatherv_vector_test(1.0));
+  BOOST_TEST(gatherv_vector_test(tuple{1, 2.0}));
+
+  BOOST_TEST(gatherv_init_test(1.0));
+  BOOST_TEST(gatherv_init_test(tuple{1, 2.0}));
 }
@@ -4,10 +4,13 @@
 #include "mplr/mplr.hpp"
 #include "test_helper.hpp"
 
+#include <array>
 #include <complex>
 #include <cstddef>
+#include <deque>
 #include <limits>
 #include <list>
+#include <numeric>
 #include <set>
 #include <string>
 #include <tuple>
@@ -336,6 +339,118 @@ bool irsend_irecv_iter_test(const T &data) {
 }
 
 
+template<typename T>
+bool isend_irecv_many_test(const T &data, int n) {
+  const auto comm_world = mplr::comm_world();
+  if (comm_world.size() < 2)
+    return false;
+  if (comm_world.rank() == 0) {
+    std::vector<T> data_s(n, data);
+    mplr::irequest_pool r;
+    for (int i{0}; i < n; ++i) {
+      data_s[i].push_back(i);
+      r.push(comm_world.isend(data_s[i], 1));
+    }
+    r.waitall();
+  }
+  if (comm_world.rank() == 1) {
+    std::vector<T> data_r(n);
+    mplr::irequest_pool r;
+    for (int i{0}; i < n; ++i)
+      r.push(comm_world.irecv(data_r[i], 0));
+    r.waitall();
+    // messages from the same source with the same tag must be received in order
+    for (int i{0}; i < n; ++i) {
+      T expected{data};
+      expected.push_back(i);
+      if (data_r[i] != expected)
+        return false;
+    }
+  }
+  return true;
+}
+
+
+// receives n messages via a pool, completions are collected via the allocation-free
+// overloads of waitsome and testsome and via for_each_completed
+bool irequest_pool_some_test(int n) {
+  const auto comm_world = mplr::comm_world();
+  if (comm_world.size() < 2)
+    return false;
+  for (int mode{0}; mode < 4; ++mode) {
+    if (comm_world.rank() == 0) {
+      std::vector<int> data_s(n);
+      mplr::irequest_pool r;
+      for (int i{0}; i < n; ++i) {
+        data_s[i] = mode * n + i;
+        r.push(comm_world.isend(data_s[i], 1, mplr::tag_t{i}));
+      }
+      r.waitall();
+    }
+    if (comm_world.rank() == 1) {
+      std::vector<int> data_r(n, -1);
+      mplr::irequest_pool r;
+      for (int i{0}; i < n; ++i)
+        r.push(comm_world.irecv(data_r[i], 0, mplr::tag_t{i}));
+      std::vector<mplr::irequest_pool::size_type> indices(n);
+      std::vector<mplr::status_t> statuses(n);
+      std::vector<int> visited(n, 0);
+      bool ok{true};
+      auto visit = [&](mplr::irequest_pool::size_type i, const mplr::status_t &s) {
+        ++visited[i];
+        if (data_r[i] != mode * n + static_cast<int>(i) or
+            s.tag() != mplr::tag_t{static_cast<int>(i)})
+          ok = false;
+      };
+      while (true) {
+        if (mode == 0 or mode == 1) {
+          const auto [result, count]{mode == 0 ? r.waitsome(indices.data(), statuses.data())
+                                               : r.testsome(indices.data(), statuses.data())};
+          if (result == mplr::test_result::no_active_requests)
+            break;
+          for (mplr::irequest_pool::size_type j{0}; j < count; ++j)
+            visit(indices[j], statuses[j]);
+        } else if (mode == 2) {
+          if (r.for_each_completed(visit) == mplr::test_result::no_active_requests)
+            break;
+        } else {
+          const auto result{r.for_each_completed([&](mplr::irequest_pool::size_type i) {
+            ++visited[i];
+            if (data_r[i] != mode * n + static_cast<int>(i))
+              ok = false;
+          })};
+          if (result == mplr::test_result::no_active_requests)
+            break;
+        }
+      }
+      if (not ok)
+        return false;
+      for (int i{0}; i < n; ++i)
+        if (visited[i] != 1 or data_r[i] != mode * n + i)
+          return false;
+    }
+  }
+  return true;
+}
+
+
+// STL containers that are large enough to be sent without a serialized copy
+std::deque<double> large_deque() {
+  std::deque<double> data(std::size_t{1} << 21);
+  std::iota(data.begin(), data.end(), 0);
+  return data;
+}
+
+
+std::list<std::array<double, 64>> large_list() {
+  std::list<std::array<double, 64>> data(std::size_t{1} << 15);
+  double x{0};
+  for (auto &array : data)
+    array.fill(++x);
+  return data;
+}
+
+
 BOOST_AUTO_TEST_CASE(isend_irecv) {
   if (not mplr::initialized())
     mplr::init();
@@ -381,6 +496,8 @@ BOOST_AUTO_TEST_CASE(isend_irecv) {
   BOOST_TEST(isend_irecv_test(std::vector<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(isend_irecv_test(std::list<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(isend_irecv_test(std::set<int>{1, 2, 3, 4, 5}));
+  BOOST_TEST(isend_irecv_test(large_deque()));
+  BOOST_TEST(isend_irecv_test(large_list()));
   // iterators
   BOOST_TEST(isend_irecv_iter_test(std::array<int, 5>{1, 2, 3, 4, 5}));
   BOOST_TEST(isend_irecv_iter_test(std::vector<int>{1, 2, 3, 4, 5}));
@@ -546,3 +663,22 @@ BOOST_AUTO_TEST_CASE(irsend_irecv) {
   BOOST_TEST(irsend_irecv_iter_test(std::list<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(irsend_irecv_iter_test(std::set<int>{1, 2, 3, 4, 5}));
 }
+
+
+BOOST_AUTO_TEST_CASE(isend_irecv_many) {
+  if (not mplr::initialized())
+    mplr::init();
+
+  BOOST_TEST(isend_irecv_many_test(std::vector<int>{1, 2, 3}, 100));
+  BOOST_TEST(isend_irecv_many_test(std::list<int>{1, 2, 3}, 100));
+  BOOST_TEST(isend_irecv_many_test(std::deque<int>{1, 2, 3}, 100));
+}
+
+
+BOOST_AUTO_TEST_CASE(irequest_pool_some) {
+  if (not mplr::initialized())
+    mplr::init();
+
+  BOOST_TEST(irequest_pool_some_test(1));
+  BOOST_TEST(irequest_pool_some_test(100));
+}
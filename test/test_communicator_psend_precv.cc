@@ -0,0 +1,67 @@
+#define BOOST_TEST_MODULE communicator_psend_precv
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+
+// every process sends a partitioned message to its right neighbor, partitions are filled and
+// marked as ready by several threads in reverse order, the receiver waits for each partition
+// individually
+bool psend_precv_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  const int right{(rank + 1) % size};
+  const int left{(rank + size - 1) % size};
+  const int partitions{8};
+  const int partition_size{1000};
+  const int threads{4};
+  std::vector<int> send_data(partitions * partition_size);
+  std::vector<int> recv_data(partitions * partition_size);
+  const mplr::vector_layout<int> l(partition_size);
+  auto send_req{comm_world.psend_init(send_data.data(), partitions, l, right)};
+  auto recv_req{comm_world.precv_init(recv_data.data(), partitions, l, left)};
+  for (int iteration{0}; iteration < 3; ++iteration) {
+    std::fill(recv_data.begin(), recv_data.end(), -1);
+    recv_req.start();
+    send_req.start();
+    std::vector<std::thread> workers;
+    for (int k{0}; k < threads; ++k)
+      workers.emplace_back([&, k]() {
+        for (int p{partitions - 1 - k}; p >= 0; p -= threads) {
+          auto first{send_data.begin() + p * partition_size};
+          std::iota(first, first + partition_size, (iteration * size + rank) * 100000 + p);
+          send_req.pready(p);
+        }
+      });
+    bool ok{true};
+    for (int p{0}; p < partitions; ++p) {
+      while (not recv_req.parrived(p))
+        std::this_thread::yield();
+      auto first{recv_data.begin() + p * partition_size};
+      std::vector<int> expected(partition_size);
+      std::iota(expected.begin(), expected.end(), (iteration * size + left) * 100000 + p);
+      ok = ok and std::equal(expected.begin(), expected.end(), first);
+    }
+    for (auto& worker : workers)
+      worker.join();
+    send_req.wait();
+    recv_req.wait();
+    if (not ok)
+      return false;
+  }
+  return true;
+}
+
+
+BOOST_AUTO_TEST_CASE(psend_precv) {
+  if (not mplr::initialized())
+    mplr::init();
+
+  BOOST_TEST(psend_precv_test());
+}
@@ -99,6 +99,34 @@ bool ireduce_scatter_block_test_with_layout(F f, const T &val) {
 }
 
 
+
+template<typename F, typename T>
+bool reduce_scatter_block_init_test(F f, const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  T x{val};
+  std::vector<T> v_x;
+  for (int i{0}; i < comm_world.size(); ++i) {
+    v_x.push_back(x);
+    ++x;
+  }
+  T y{};
+  auto r{comm_world.reduce_scatter_block_init(f, v_x.data(), y)};
+  x = val;
+  for (int i{0}; i < comm_world.rank(); ++i)
+    ++x;
+  T expected{x};
+  for (int i{1}; i < comm_world.size(); ++i)
+    expected = f(expected, x);
+  for (int iteration{0}; iteration < 2; ++iteration) {
+    y = T{};
+    r.start();
+    r.wait();
+    if (not(y == expected))
+      return false;
+  }
+  return true;
+}
+
 BOOST_AUTO_TEST_CASE(reduce_scatter_block) {
   if (not mplr::initialized())
     mplr::init();
@@ -132,4 +160,7 @@ BOOST_AUTO_TEST_CASE(reduce_scatter_block) {
   BOOST_TEST(ireduce_scatter_block_test_with_layout([](auto a, auto b) { return a + b; }, 1.0));
   BOOST_TEST(ireduce_scatter_block_test_with_layout([](auto a, auto b) { return a + b; },
                                                     tuple{1, 2.0}));
+
+  BOOST_TEST(reduce_scatter_block_init_test(add<double>(), 1.0));
+  BOOST_TEST(reduce_scatter_block_init_test(mplr::plus<tuple>(), tuple{1, 2.0}));
 }
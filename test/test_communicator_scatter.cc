@@ -70,6 +70,23 @@ bool iscatter_test(const std::vector<T> &send, const std::vector<T> &expected,
 }
 
 
+
+template<typename T>
+bool scatter_init_test(const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  std::vector<T> v(comm_world.rank() == 0 ? comm_world.size() : 0, val);
+  T recv;
+  auto r{comm_world.scatter_init(0, v.data(), recv)};
+  for (int iteration{0}; iteration < 2; ++iteration) {
+    recv = T{};
+    r.start();
+    r.wait();
+    if (recv != val)
+      return false;
+  }
+  return true;
+}
+
 BOOST_AUTO_TEST_CASE(scatter) {
   if (not mplr::initialized())
     mplr::init();
@@ -93,4 +110,7 @@ BOOST_AUTO_TEST_CASE(scatter) {
     l.resize(0, 6);
     BOOST_TEST(iscatter_test(send, expected, l));
   }
+
+  BOOST_TEST(scatter_init_test(1.0));
+  BOOST_TEST(scatter_init_test(std::array{1, 2, 3, 4}));
 }
@@ -4,7 +4,10 @@
 #include "mplr/mplr.hpp"
 #include "test_helper.hpp"
 
+#include <algorithm>
+#include <numeric>
 #include <tuple>
+#include <vector>
 
 
 template<use_non_root_overload variant, typename T>
@@ -145,6 +148,55 @@ bool iscatterv_contiguous_test(const T &val) {
 }
 
 
+template<typename T>
+bool scatterv_vector_test(const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  const int root_rank{0};
+  std::vector<std::vector<T>> send_data;
+  if (rank == root_rank)
+    for (int i{0}; i < size; ++i) {
+      send_data.emplace_back(i + 1);
+      std::iota(begin(send_data.back()), end(send_data.back()), val);
+    }
+  std::vector<T> expected(rank + 1);
+  std::iota(begin(expected), end(expected), val);
+  return comm_world.scatterv(root_rank, send_data) == expected;
+}
+
+
+
+template<typename T>
+bool scatterv_init_test(const T &val) {
+  const auto comm_world{mplr::comm_world()};
+  const int N{(comm_world.size() * comm_world.size() + comm_world.size()) / 2};
+  std::vector<T> v_scatter(N);
+  std::vector<T> v_recv(comm_world.rank() + 1);
+  std::vector<T> v_expected(comm_world.rank() + 1);
+  std::iota(begin(v_scatter), end(v_scatter), val);
+  mplr::layouts<T> layouts;
+  for (int i{0}, i_end{comm_world.size()}, offset{0}; i < i_end; ++i) {
+    layouts.push_back(mplr::indexed_layout<T>({{i + 1, offset}}));
+    offset += i + 1;
+  }
+  T t_val{val};
+  for (int i{0}, i_end{(comm_world.rank() * comm_world.rank() + comm_world.rank()) / 2};
+       i < i_end; ++i)
+    ++t_val;
+  std::iota(begin(v_expected), end(v_expected), t_val);
+  const mplr::vector_layout<T> layout(comm_world.rank() + 1);
+  auto r{comm_world.scatterv_init(0, v_scatter.data(), layouts, v_recv.data(), layout)};
+  for (int iteration{0}; iteration < 2; ++iteration) {
+    std::fill(begin(v_recv), end(v_recv), T{});
+    r.start();
+    r.wait();
+    if (v_recv != v_expected)
+      return false;
+  }
+  return true;
+}
+
 BOOST_AUTO_TEST_CASE(scatterv) {
   if (not mplr::initialized())
     mplr::init();
@@ -175,4 +227,10 @@ BOOST_AUTO_TEST_CASE(scatterv) {
 
   BOOST_TEST(iscatterv_contiguous_test<use_non_root_overload::yes>(1.0));
   BOOST_TEST(iscatterv_contiguous_test<use_non_root_overload::yes>(tuple{1, 2.0}));
+
+  BOOST_TEST(scatterv_vector_test(1.0));
+  BOOST_TEST(scatterv_vector_test(tuple{1, 2.0}));
+
+  BOOST_TEST(scatterv_init_test(1.0));
+  BOOST_TEST(scatterv_init_test(tuple{1, 2.0}));
 }
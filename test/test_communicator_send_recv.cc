@@ -5,14 +5,19 @@
 #include "test_helper.hpp"
 
 #include <algorithm>
+#include <array>
 #include <complex>
 #include <cstddef>
+#include <deque>
 #include <limits>
 #include <list>
+#include <map>
+#include <numeric>
 #include <set>
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -360,6 +365,40 @@ bool rsend_recv_iter_test(const T &data) {
 }
 
 
+// receive into a container that holds some elements already
+template<typename T>
+bool send_recv_reuse_test(const T &data, const T &data_r_init) {
+  const auto comm_world = mplr::comm_world();
+  if (comm_world.size() < 2)
+    return false;
+  if (comm_world.rank() == 0)
+    comm_world.send(data, 1);
+  if (comm_world.rank() == 1) {
+    T data_r{data_r_init};
+    comm_world.recv(data_r, 0);
+    return data_r == data;
+  }
+  return true;
+}
+
+
+// STL containers that are large enough to be sent without a serialized copy
+std::deque<double> large_deque() {
+  std::deque<double> data(std::size_t{1} << 21);
+  std::iota(data.begin(), data.end(), 0);
+  return data;
+}
+
+
+std::list<std::array<double, 64>> large_list() {
+  std::list<std::array<double, 64>> data(std::size_t{1} << 15);
+  double x{0};
+  for (auto &array : data)
+    array.fill(++x);
+  return data;
+}
+
+
 BOOST_AUTO_TEST_CASE(send_recv) {
   if (not mplr::initialized())
     mplr::init();
@@ -412,6 +451,19 @@ BOOST_AUTO_TEST_CASE(send_recv) {
   BOOST_TEST(send_recv_test(std::vector<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(send_recv_test(std::list<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(send_recv_test(std::set<int>{1, 2, 3, 4, 5}));
+  BOOST_TEST(send_recv_test(large_deque()));
+  BOOST_TEST(send_recv_test(large_list()));
+  // receive into non-empty containers
+  BOOST_TEST(send_recv_reuse_test(std::deque<int>{1, 2, 3, 4, 5}, std::deque<int>{6, 7}));
+  BOOST_TEST(send_recv_reuse_test(std::list<int>{1, 2}, std::list<int>{3, 4, 5, 6, 7}));
+  BOOST_TEST(send_recv_reuse_test(std::set<int>{1, 2, 3, 4, 5}, std::set<int>{0, 3, 6}));
+  BOOST_TEST(send_recv_reuse_test(std::multiset<int>{1, 1, 2}, std::multiset<int>{3, 4, 4, 5}));
+  BOOST_TEST(send_recv_reuse_test(std::map<int, double>{{1, 1.5}, {2, 2.5}, {3, 3.5}},
+                                  std::map<int, double>{{2, 0.5}, {7, 7.5}}));
+  BOOST_TEST(send_recv_reuse_test(std::unordered_map<int, double>{{1, 1.5}, {2, 2.5}},
+                                  std::unordered_map<int, double>{{2, 0.5}, {7, 7.5}, {8, 1}}));
+  BOOST_TEST(send_recv_reuse_test(large_deque(), std::deque<double>{1, 2, 3}));
+  BOOST_TEST(send_recv_reuse_test(large_list(), large_list()));
   // iterators
   BOOST_TEST(send_recv_iter_test(std::array<int, 5>{1, 2, 3, 4, 5}));
   BOOST_TEST(send_recv_iter_test(std::vector<int>{1, 2, 3, 4, 5}));
@@ -472,6 +524,8 @@ BOOST_AUTO_TEST_CASE(bsend_recv) {
   BOOST_TEST(bsend_recv_test(std::vector<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(bsend_recv_test(std::list<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(bsend_recv_test(std::set<int>{1, 2, 3, 4, 5}));
+  BOOST_TEST(bsend_recv_test(large_deque()));
+  BOOST_TEST(bsend_recv_test(large_list()));
   // iterators
   BOOST_TEST(bsend_recv_iter_test(std::array<int, 5>{1, 2, 3, 4, 5}));
   BOOST_TEST(bsend_recv_iter_test(std::vector<int>{1, 2, 3, 4, 5}));
@@ -532,6 +586,8 @@ BOOST_AUTO_TEST_CASE(ssend_recv) {
   BOOST_TEST(ssend_recv_test(std::vector<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(ssend_recv_test(std::list<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(ssend_recv_test(std::set<int>{1, 2, 3, 4, 5}));
+  BOOST_TEST(ssend_recv_test(large_deque()));
+  BOOST_TEST(ssend_recv_test(large_list()));
   // iterators
   BOOST_TEST(ssend_recv_iter_test(std::array<int, 5>{1, 2, 3, 4, 5}));
   BOOST_TEST(ssend_recv_iter_test(std::vector<int>{1, 2, 3, 4, 5}));
@@ -592,6 +648,8 @@ BOOST_AUTO_TEST_CASE(rsend_recv) {
   BOOST_TEST(rsend_recv_test(std::vector<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(rsend_recv_test(std::list<int>{1, 2, 3, 4, 5}));
   BOOST_TEST(rsend_recv_test(std::set<int>{1, 2, 3, 4, 5}));
+  BOOST_TEST(rsend_recv_test(large_deque()));
+  BOOST_TEST(rsend_recv_test(large_list()));
   // iterators
   BOOST_TEST(rsend_recv_iter_test(std::array<int, 5>{1, 2, 3, 4, 5}));
   BOOST_TEST(rsend_recv_iter_test(std::vector<int>{1, 2, 3, 4, 5}));
@@ -0,0 +1,105 @@
+#define BOOST_TEST_MODULE communicator_sparse_exchange
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+
+// each process sends to a few processes determined by its rank, message sizes depend on
+// source and destination
+std::set<int> destinations(int rank, int size, int offset) {
+  return {(rank + 1) % size, (rank + offset) % size};
+}
+
+
+std::vector<double> payload(int source, int destination) {
+  std::vector<double> v((source + 2 * destination) % 5);
+  for (std::size_t i{0}; i < v.size(); ++i)
+    v[i] = 100 * source + destination + 0.5 * static_cast<double>(i);
+  return v;
+}
+
+
+bool sparse_exchange_test(int offset, mplr::tag_t t) {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::map<int, std::vector<double>> send_data;
+  for (int destination : destinations(rank, size, offset))
+    send_data[destination] = payload(rank, destination);
+  const auto recv_data{comm_world.sparse_exchange(send_data, t)};
+  std::vector<int> expected_sources;
+  for (int source{0}; source < size; ++source)
+    if (destinations(source, size, offset).count(rank) > 0)
+      expected_sources.push_back(source);
+  std::vector<int> sources;
+  for (const auto &[source, data] : recv_data) {
+    sources.push_back(source);
+    if (data != payload(source, rank))
+      return false;
+  }
+  std::sort(sources.begin(), sources.end());
+  return sources == expected_sources;
+}
+
+
+// only one process sends at all
+bool sparse_exchange_single_sender_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::map<int, std::vector<int>> send_data;
+  if (rank == 0)
+    for (int i{0}; i < size; ++i)
+      send_data[i] = std::vector<int>(i + 1, i);
+  const auto recv_data{comm_world.sparse_exchange(send_data, mplr::tag_t{5})};
+  return recv_data.size() == 1 and recv_data[0].first == 0 and
+         recv_data[0].second == std::vector<int>(rank + 1, rank);
+}
+
+
+// every process sends to its successor, the waiting thread backs off
+bool sparse_exchange_wait_policy_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::map<int, std::vector<int>> send_data;
+  send_data[(rank + 1) % size] = std::vector<int>(3, rank);
+  const auto recv_data{
+      comm_world.sparse_exchange(send_data, mplr::tag_t{6}, mplr::backoff_wait{})};
+  const int source{(rank + size - 1) % size};
+  return recv_data.size() == 1 and recv_data[0].first == source and
+         recv_data[0].second == std::vector<int>(3, source);
+}
+
+
+// a message that does not hold a whole number of elements is discarded and rejected
+bool sparse_exchange_invalid_count_test() {
+  const auto comm_self{mplr::comm_self()};
+  const std::vector<char> bytes(3);
+  auto r{comm_self.isend(bytes.data(), mplr::vector_layout<char>(bytes.size()), 0,
+                         mplr::tag_t{7})};
+  [[maybe_unused]] const auto s{comm_self.probe(0, mplr::tag_t{7})};
+  try {
+    comm_self.sparse_exchange(std::map<int, std::vector<int>>{}, mplr::tag_t{7});
+  } catch (mplr::invalid_count &) {
+    r.wait();
+    return not comm_self.iprobe(0, mplr::tag_t{7});
+  }
+  return false;
+}
+
+BOOST_AUTO_TEST_CASE(sparse_exchange) {
+  if (not mplr::initialized())
+    mplr::init();
+  BOOST_TEST(sparse_exchange_test(0, mplr::tag_t{1}));
+  BOOST_TEST(sparse_exchange_test(3, mplr::tag_t{2}));
+  BOOST_TEST(sparse_exchange_test(5, mplr::tag_t{3}));
+  BOOST_TEST(sparse_exchange_single_sender_test());
+  BOOST_TEST(sparse_exchange_wait_policy_test());
+  BOOST_TEST(sparse_exchange_invalid_count_test());
+}
@@ -0,0 +1,99 @@
+#define BOOST_TEST_MODULE completion_queue
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+
+// passes tokens around the ring several times, each callback posts the next receive and
+// sends the next token
+bool completion_queue_ring_test(bool use_this_thread) {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  const int left{(rank + size - 1) % size};
+  const int right{(rank + 1) % size};
+  const int rounds{5};
+  mplr::completion_queue local_queue;
+  auto &queue{use_this_thread ? mplr::completion_queue::this_thread() : local_queue};
+  std::vector<int> send_tokens(rounds);
+  for (int i{0}; i < rounds; ++i)
+    send_tokens[i] = i * size + rank;
+  int token{-1};
+  int received{0};
+  bool ok{true};
+  std::function<void(const mplr::status_t &)> on_recv = [&](const mplr::status_t &s) {
+    if (s.source() != left or token != received * size + left)
+      ok = false;
+    ++received;
+    if (received < rounds) {
+      comm_world.irecv(token, left).then(queue, on_recv);
+      comm_world.isend(send_tokens[received], right).then(queue, []() {});
+    }
+  };
+  comm_world.irecv(token, left).then(queue, on_recv);
+  if (use_this_thread)
+    comm_world.isend(send_tokens[0], right).then([]() {});
+  else
+    comm_world.isend(send_tokens[0], right).then(queue, []() {});
+  if (queue.empty())
+    return false;
+  queue.run(mplr::backoff_wait{});
+  return ok and received == rounds and queue.empty();
+}
+
+
+// callbacks of many requests, progressed by polling
+bool completion_queue_progress_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  mplr::completion_queue queue;
+  std::vector<int> v(size, -1);
+  int completed{0};
+  for (int i{0}; i < size; ++i)
+    comm_world.irecv(v[i], i).then(queue, [&, i]() {
+      if (v[i] == i)
+        ++completed;
+    });
+  for (int i{0}; i < size; ++i)
+    comm_world.isend(rank, i).then(queue, [&completed]() { ++completed; });
+  if (queue.size() != static_cast<mplr::completion_queue::size_type>(2 * size))
+    return false;
+  mplr::completion_queue::size_type invoked{0};
+  while (not queue.empty())
+    invoked += queue.progress();
+  return invoked == static_cast<mplr::completion_queue::size_type>(2 * size) and
+         completed == 2 * size;
+}
+
+
+// an exception thrown by a callback is propagated, other callbacks are invoked later
+bool completion_queue_exception_test() {
+  const auto comm_world{mplr::comm_world()};
+  mplr::completion_queue queue;
+  int invoked{0};
+  comm_world.ibarrier().then(queue, []() { throw std::runtime_error{"error in callback"}; });
+  comm_world.ibarrier().then(queue, [&invoked]() { ++invoked; });
+  bool thrown{false};
+  try {
+    queue.run();
+  } catch (std::runtime_error &) {
+    thrown = true;
+  }
+  queue.run();
+  return thrown and invoked == 1;
+}
+
+
+BOOST_AUTO_TEST_CASE(completion_queue) {
+  if (not mplr::initialized())
+    mplr::init();
+  BOOST_TEST(completion_queue_ring_test(false));
+  BOOST_TEST(completion_queue_ring_test(true));
+  BOOST_TEST(completion_queue_progress_test());
+  BOOST_TEST(completion_queue_exception_test());
+}
@@ -0,0 +1,136 @@
+#define BOOST_TEST_MODULE coroutine
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/coroutine.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+
+// exchanges values with the neighbors in a ring, each step awaits a single request
+mplr::request_task ring_task(const mplr::communicator &comm, int tag, int steps, bool &ok) {
+  const int size{comm.size()};
+  const int rank{comm.rank()};
+  const int left{(rank + size - 1) % size};
+  const int right{(rank + 1) % size};
+  for (int i{0}; i < steps; ++i) {
+    int x{-1};
+    auto r{comm.irecv(x, left, mplr::tag_t{tag})};
+    const int y{1000 * tag + 10 * rank + i};
+    co_await comm.isend(y, right, mplr::tag_t{tag});
+    const auto s{co_await r};
+    if (x != 1000 * tag + 10 * left + i or s.source() != left)
+      ok = false;
+  }
+}
+
+
+// exchanges values with all processes, awaits pools of requests
+mplr::request_task all_task(const mplr::communicator &comm, int tag, bool any, bool &ok) {
+  const int size{comm.size()};
+  const int rank{comm.rank()};
+  std::vector<int> v(size, -1);
+  std::vector<int> w(size, rank + tag);
+  mplr::irequest_pool recv_pool, send_pool;
+  for (int i{0}; i < size; ++i)
+    recv_pool.push(comm.irecv(v[i], i, mplr::tag_t{tag}));
+  for (int i{0}; i < size; ++i)
+    send_pool.push(comm.isend(w[i], i, mplr::tag_t{tag}));
+  if (any) {
+    int completed{0};
+    while (true) {
+      const auto [result, index]{co_await mplr::when_any(recv_pool)};
+      if (result == mplr::test_result::no_active_requests)
+        break;
+      if (v[index] != static_cast<int>(index) + tag)
+        ok = false;
+      ++completed;
+    }
+    if (completed != size)
+      ok = false;
+  } else {
+    co_await mplr::when_all(recv_pool);
+    for (int i{0}; i < size; ++i)
+      if (v[i] != i + tag)
+        ok = false;
+  }
+  co_await mplr::when_all(send_pool);
+}
+
+
+// repeats an exchange with the neighbors in a ring via persistent requests
+mplr::request_task persistent_task(const mplr::communicator &comm, int tag, int steps,
+                                   bool &ok) {
+  const int size{comm.size()};
+  const int rank{comm.rank()};
+  const int left{(rank + size - 1) % size};
+  const int right{(rank + 1) % size};
+  int x{-1}, y{0};
+  auto r{comm.recv_init(x, left, mplr::tag_t{tag})};
+  auto s{comm.send_init(y, right, mplr::tag_t{tag})};
+  for (int i{0}; i < steps; ++i) {
+    y = 100 * rank + i;
+    r.start();
+    s.start();
+    co_await s;
+    co_await r;
+    if (x != 100 * left + i)
+      ok = false;
+  }
+}
+
+
+mplr::request_task throwing_task(const mplr::communicator &comm) {
+  co_await comm.ibarrier();
+  throw std::runtime_error{"error in coroutine"};
+}
+
+
+bool coroutine_test() {
+  const auto comm_world{mplr::comm_world()};
+  bool ok{true};
+  mplr::request_scheduler scheduler;
+  scheduler.spawn(ring_task(comm_world, 1, 10, ok));
+  scheduler.spawn(ring_task(comm_world, 2, 20, ok));
+  scheduler.spawn(all_task(comm_world, 3, false, ok));
+  scheduler.spawn(all_task(comm_world, 4, true, ok));
+  scheduler.spawn(persistent_task(comm_world, 5, 10, ok));
+  if (scheduler.size() != 5)
+    return false;
+  scheduler.run();
+  return ok and scheduler.empty();
+}
+
+
+bool coroutine_poll_test() {
+  const auto comm_world{mplr::comm_world()};
+  bool ok{true};
+  mplr::request_scheduler scheduler;
+  scheduler.spawn(ring_task(comm_world, 1, 10, ok));
+  scheduler.spawn(all_task(comm_world, 2, true, ok));
+  while (scheduler.poll()) {
+  }
+  return ok;
+}
+
+
+bool coroutine_exception_test() {
+  const auto comm_world{mplr::comm_world()};
+  mplr::request_scheduler scheduler;
+  scheduler.spawn(throwing_task(comm_world));
+  try {
+    scheduler.run(mplr::backoff_wait{});
+  } catch (std::runtime_error &) {
+    return scheduler.empty();
+  }
+  return false;
+}
+
+
+BOOST_AUTO_TEST_CASE(coroutine) {
+  if (not mplr::initialized())
+    mplr::init();
+  BOOST_TEST(coroutine_test());
+  BOOST_TEST(coroutine_poll_test());
+  BOOST_TEST(coroutine_exception_test());
+}
@@ -0,0 +1,81 @@
+#define BOOST_TEST_MODULE datatype_cache
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+#include "test_helper.hpp"
+
+#include <numeric>
+#include <vector>
+
+
+// layouts with equal parameters share a cached data type, counters reflect hits and misses
+bool datatype_cache_hit_test() {
+  mplr::datatype_cache::enable(16);
+  mplr::datatype_cache::clear();
+  mplr::datatype_cache::reset_statistics();
+  for (int i{0}; i < 3; ++i) {
+    const mplr::indexed_layout<double> l1({{1, 0}, {2, 4}});
+    const mplr::vector_layout<double> l2(10);
+    const mplr::contiguous_layout<double> l3(10);
+    const mplr::subarray_layout<int> l4({{8, 4, 2}, {8, 4, 2}});
+    const mplr::strided_vector_layout<tuple> l5(4, 2, 3);
+  }
+  const auto stats{mplr::datatype_cache::statistics()};
+  // cache hits share the cached data type
+  const mplr::indexed_layout<double> l1({{1, 0}, {2, 4}});
+  const mplr::indexed_layout<double> l1_again({{1, 0}, {2, 4}});
+  const bool ok{stats.misses == 4 and stats.hits == 11 and stats.evictions == 0 and
+                mplr::datatype_cache::size() == 4 and
+                l1.native_handle() == l1_again.native_handle()};
+  mplr::datatype_cache::disable();
+  return ok and not mplr::datatype_cache::enabled() and mplr::datatype_cache::size() == 0;
+}
+
+
+// the least recently used data type is evicted, layouts remain valid after eviction
+bool datatype_cache_eviction_test() {
+  mplr::datatype_cache::enable(2);
+  mplr::datatype_cache::reset_statistics();
+  const mplr::indexed_layout<int> l1({{1, 0}});
+  const mplr::indexed_layout<int> l2({{1, 1}});
+  const mplr::indexed_layout<int> l1_again({{1, 0}});
+  const mplr::indexed_layout<int> l3({{1, 2}});
+  const auto stats{mplr::datatype_cache::statistics()};
+  const bool ok{stats.misses == 3 and stats.hits == 1 and stats.evictions == 1 and
+                mplr::datatype_cache::size() == 2 and l2.extent() == 1};
+  // l2 was evicted, constructing it again is a miss
+  const mplr::indexed_layout<int> l2_again({{1, 1}});
+  const bool ok_2{mplr::datatype_cache::statistics().misses == 4};
+  mplr::datatype_cache::disable();
+  return ok and ok_2;
+}
+
+
+// data is transferred correctly via layouts with cached data types
+bool datatype_cache_transfer_test() {
+  const auto comm_world{mplr::comm_world()};
+  mplr::datatype_cache::enable();
+  std::vector<int> v1(16), v2(16, 0);
+  std::iota(v1.begin(), v1.end(), comm_world.rank());
+  bool ok{true};
+  for (int i{0}; i < 2; ++i) {
+    const mplr::strided_vector_layout<int> l(4, 2, 4);
+    comm_world.sendrecv(v1.data(), l, comm_world.rank(), mplr::tag_t{0}, v2.data(), l,
+                        comm_world.rank(), mplr::tag_t{0});
+    for (int j{0}; j < 16; ++j)
+      if (v2[j] != (j % 4 < 2 ? v1[j] : 0))
+        ok = false;
+  }
+  ok = ok and mplr::datatype_cache::statistics().hits > 0;
+  mplr::datatype_cache::disable();
+  return ok;
+}
+
+
+BOOST_AUTO_TEST_CASE(datatype_cache) {
+  if (not mplr::initialized())
+    mplr::init();
+  BOOST_TEST(datatype_cache_hit_test());
+  BOOST_TEST(datatype_cache_eviction_test());
+  BOOST_TEST(datatype_cache_transfer_test());
+}
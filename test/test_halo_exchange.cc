@@ -0,0 +1,84 @@
+#define BOOST_TEST_MODULE halo_exchange
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+
+#include <vector>
+
+
+// exchanges data with the neighbors in a ring via a persistent plan several times
+template<bool lazy_wait>
+bool halo_exchange_ring_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  const int left{(rank + size - 1) % size};
+  const int right{(rank + 1) % size};
+  const int n{64};
+  // layout: left overlap, n interior values, right overlap
+  std::vector<int> v(n + 2);
+  const mplr::contiguous_layout<int> l(1);
+  mplr::halo_exchange plan;
+  plan.add(comm_world, v.data() + 1, l, left, v.data() + n + 1, l, right);
+  plan.add(comm_world, v.data() + n, l, right, v.data(), l, left);
+  if (plan.size() != 4)
+    return false;
+  for (int iteration{0}; iteration < 3; ++iteration) {
+    for (int i{1}; i <= n; ++i)
+      v[i] = 1000 * iteration + 100 * rank + i;
+    if constexpr (lazy_wait)
+      plan.exchange(mplr::duty_ratio::preset::moderate);
+    else {
+      plan.start();
+      plan.wait();
+    }
+    if (v[0] != 1000 * iteration + 100 * left + n or
+        v[n + 1] != 1000 * iteration + 100 * right + 1)
+      return false;
+  }
+  return true;
+}
+
+
+// updates the overlap data of a two-dimensional distributed grid
+bool halo_exchange_grid_test() {
+  const auto comm_world{mplr::comm_world()};
+  mplr::cartesian_communicator::dimensions size{mplr::cartesian_communicator::non_periodic,
+                                                mplr::cartesian_communicator::non_periodic};
+  mplr::cartesian_communicator comm_c{comm_world, mplr::dims_create(comm_world.size(), size)};
+  const int n_x{20}, n_y{12};
+  mplr::distributed_grid<2, int> grid(comm_c, {{n_x, 1}, {n_y, 1}});
+  for (auto j{grid.obegin(1)}, j_end{grid.oend(1)}; j < j_end; ++j)
+    for (auto i{grid.obegin(0)}, i_end{grid.oend(0)}; i < i_end; ++i)
+      grid(i, j) = -1;
+  for (auto j{grid.begin(1)}, j_end{grid.end(1)}; j < j_end; ++j)
+    for (auto i{grid.begin(0)}, i_end{grid.end(0)}; i < i_end; ++i)
+      grid(i, j) = 1000 * grid.gindex(0, i) + grid.gindex(1, j);
+  mplr::halo_exchange plan(comm_c, grid);
+  plan.exchange();
+  auto expected = [&](auto i, auto j) {
+    const auto g_i{grid.gindex(0, i)};
+    const auto g_j{grid.gindex(1, j)};
+    if (g_i < 0 or g_i >= n_x or g_j < 0 or g_j >= n_y)
+      return -1;
+    return static_cast<int>(1000 * g_i + g_j);
+  };
+  for (auto j{grid.begin(1)}, j_end{grid.end(1)}; j < j_end; ++j)
+    for (auto i : {grid.obegin(0), grid.oend(0) - 1})
+      if (grid(i, j) != expected(i, j))
+        return false;
+  for (auto j : {grid.obegin(1), grid.oend(1) - 1})
+    for (auto i{grid.begin(0)}, i_end{grid.end(0)}; i < i_end; ++i)
+      if (grid(i, j) != expected(i, j))
+        return false;
+  return true;
+}
+
+
+BOOST_AUTO_TEST_CASE(halo_exchange) {
+  if (not mplr::initialized())
+    mplr::init();
+  BOOST_TEST(halo_exchange_ring_test<false>());
+  BOOST_TEST(halo_exchange_ring_test<true>());
+  BOOST_TEST(halo_exchange_grid_test());
+}
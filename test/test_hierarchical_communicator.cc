@@ -0,0 +1,110 @@
+#define BOOST_TEST_MODULE hierarchical_communicator
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+
+#include <numeric>
+#include <vector>
+
+
+bool allreduce_test(const mplr::hierarchical_communicator &comm) {
+  const int size{comm.size()};
+  const int rank{comm.rank()};
+  int sum{0};
+  comm.allreduce(mplr::plus<int>(), rank + 1, sum);
+  if (sum != size * (size + 1) / 2)
+    return false;
+  const int n{5};
+  std::vector<double> x(n), y(n);
+  std::iota(x.begin(), x.end(), rank);
+  comm.allreduce(mplr::max<double>(), x.data(), y.data(), mplr::contiguous_layout<double>(n));
+  std::vector<double> expected(n);
+  std::iota(expected.begin(), expected.end(), size - 1);
+  return y == expected;
+}
+
+
+// projections onto the left and the right operand are associative but not commutative, the
+// results reveal whether the data was reduced in the order of ranks
+bool allreduce_non_commutative_test(const mplr::hierarchical_communicator &comm) {
+  const auto left{[](int a, int) { return a; }};
+  const auto right{[](int, int b) { return b; }};
+  const int size{comm.size()};
+  const int rank{comm.rank()};
+  int first{-1}, last{-1};
+  comm.allreduce(left, rank, first);
+  comm.allreduce(right, rank, last);
+  const int n{3};
+  const std::vector<int> x(n, rank);
+  std::vector<int> y(n);
+  comm.allreduce(right, x.data(), y.data(), mplr::contiguous_layout<int>(n));
+  return first == 0 and last == size - 1 and y == std::vector<int>(n, size - 1);
+}
+
+
+bool bcast_test(const mplr::hierarchical_communicator &comm) {
+  const int size{comm.size()};
+  const int rank{comm.rank()};
+  for (int root{0}; root < size; ++root) {
+    int x{rank == root ? 100 + root : -1};
+    comm.bcast(root, x);
+    if (x != 100 + root)
+      return false;
+    std::vector<int> v(4, rank == root ? root : -1);
+    comm.bcast(root, v.data(), mplr::vector_layout<int>(v.size()));
+    if (v != std::vector<int>(4, root))
+      return false;
+  }
+  return true;
+}
+
+
+bool gather_test(const mplr::hierarchical_communicator &comm) {
+  const int size{comm.size()};
+  const int rank{comm.rank()};
+  std::vector<int> expected(size);
+  std::iota(expected.begin(), expected.end(), 0);
+  std::vector<int> expected_blocks(2 * size);
+  for (int i{0}; i < 2 * size; ++i)
+    expected_blocks[i] = 10 * (i / 2) + i % 2;
+  const int block[]{10 * rank, 10 * rank + 1};
+  for (int root{0}; root < size; ++root) {
+    std::vector<int> v(rank == root ? size : 0);
+    comm.gather(root, rank, v.data());
+    if (rank == root and v != expected)
+      return false;
+    std::vector<int> w(rank == root ? 2 * size : 0);
+    comm.gather(root, block, mplr::contiguous_layout<int>(2), w.data());
+    if (rank == root and w != expected_blocks)
+      return false;
+  }
+  return true;
+}
+
+
+bool hierarchical_test(const mplr::hierarchical_communicator &comm) {
+  return allreduce_test(comm) and allreduce_non_commutative_test(comm) and bcast_test(comm) and
+         gather_test(comm);
+}
+
+
+BOOST_AUTO_TEST_CASE(hierarchical_communicator) {
+  if (not mplr::initialized())
+    mplr::init();
+  const auto comm_world{mplr::comm_world()};
+  const mplr::hierarchical_communicator shared_memory{comm_world};
+  BOOST_TEST(shared_memory.node_communicator().size() <= comm_world.size());
+  BOOST_TEST(hierarchical_test(shared_memory));
+  // emulated nodes with consecutive ranks
+  const mplr::hierarchical_communicator consecutive{mplr::communicator::split, comm_world,
+                                                    comm_world.rank() / 2};
+  BOOST_TEST(consecutive.node_count() == (comm_world.size() + 1) / 2);
+  BOOST_TEST(hierarchical_test(consecutive));
+  // emulated nodes with interleaved ranks
+  const mplr::hierarchical_communicator interleaved{mplr::communicator::split, comm_world,
+                                                    comm_world.rank() % 2};
+  BOOST_TEST(interleaved.node_count() == std::min(comm_world.size(), 2));
+  BOOST_TEST(interleaved.leader_communicator().is_valid() ==
+             (interleaved.node_communicator().rank() == 0));
+  BOOST_TEST(hierarchical_test(interleaved));
+}
@@ -0,0 +1,240 @@
+#define BOOST_TEST_MODULE large_count
+
+// a small limit exercises the large-count code paths with small messages
+#define MPLR_LARGE_COUNT_LIMIT 64
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+
+#include <numeric>
+#include <vector>
+
+
+// each process sends n elements to each process, blocks are separated by gaps, such that
+// displacements exceed the limit
+constexpr int n{8};
+constexpr int stride{100};
+
+
+bool alltoallv_large_displacements_test(bool non_blocking) {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::vector<int> send_data(stride * size, -1);
+  std::vector<int> recv_data(stride * size, -1);
+  std::vector<int> expected(stride * size, -1);
+  mplr::layouts<int> ls;
+  mplr::displacements displs;
+  for (int i{0}; i < size; ++i) {
+    ls.push_back(mplr::vector_layout<int>(n));
+    displs.push_back(stride * i);
+    for (int j{0}; j < n; ++j) {
+      send_data[stride * i + j] = 1000 * rank + 10 * i + j;
+      expected[stride * i + j] = 1000 * i + 10 * rank + j;
+    }
+  }
+  if (non_blocking)
+    comm_world.ialltoallv(send_data.data(), ls, displs, recv_data.data(), ls, displs).wait();
+  else
+    comm_world.alltoallv(send_data.data(), ls, displs, recv_data.data(), ls, displs);
+  return recv_data == expected;
+}
+
+
+bool alltoallv_in_place_large_displacements_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::vector<int> sendrecv_data(stride * size, -1);
+  std::vector<int> expected(stride * size, -1);
+  mplr::layouts<int> ls;
+  mplr::displacements displs;
+  for (int i{0}; i < size; ++i) {
+    ls.push_back(mplr::vector_layout<int>(n));
+    displs.push_back(stride * i);
+    for (int j{0}; j < n; ++j) {
+      sendrecv_data[stride * i + j] = 1000 * rank + 10 * i + j;
+      expected[stride * i + j] = 1000 * i + 10 * rank + j;
+    }
+  }
+  comm_world.alltoallv(sendrecv_data.data(), ls, displs);
+  return sendrecv_data == expected;
+}
+
+
+bool gatherv_scatterv_large_displacements_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  const int root{size - 1};
+  std::vector<int> block(n);
+  std::iota(block.begin(), block.end(), 100 * rank);
+  mplr::layouts<int> ls;
+  mplr::displacements displs;
+  for (int i{0}; i < size; ++i) {
+    ls.push_back(mplr::vector_layout<int>(n));
+    displs.push_back(stride * i);
+  }
+  std::vector<int> gathered(stride * size, -1);
+  if (rank == root)
+    comm_world.gatherv(root, block.data(), mplr::vector_layout<int>(n), gathered.data(), ls,
+                       displs);
+  else
+    comm_world.gatherv(root, block.data(), mplr::vector_layout<int>(n));
+  if (rank == root)
+    for (int i{0}; i < size; ++i)
+      for (int j{0}; j < n; ++j)
+        if (gathered[stride * i + j] != 100 * i + j)
+          return false;
+  std::vector<int> scattered(n, -1);
+  comm_world.scatterv(root, gathered.data(), ls, displs, scattered.data(),
+                      mplr::vector_layout<int>(n));
+  return scattered == block;
+}
+
+
+bool sparse_alltoallv_large_displacements_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  const int next{(rank + 1) % size};
+  const int previous{(rank + size - 1) % size};
+  std::vector<int> send_data(stride + n, -1);
+  std::iota(send_data.begin() + stride, send_data.end(), 100 * rank);
+  std::vector<int> recv_data(2 * stride, -1);
+  mplr::sparse_layouts<int> sendls, recvls;
+  sendls.push_back(next, mplr::vector_layout<int>(n), stride);
+  recvls.push_back(previous, mplr::vector_layout<int>(n), 2 * stride - 16);
+  comm_world.alltoallv(send_data.data(), sendls, recv_data.data(), recvls, mplr::tag_t{0},
+                       mplr::sparse_schedule::collective);
+  const auto first{recv_data.begin() + 2 * stride - 16};
+  std::vector<int> expected(n);
+  std::iota(expected.begin(), expected.end(), 100 * previous);
+  return std::equal(expected.begin(), expected.end(), first);
+}
+
+
+// point-to-point communication and broadcasts pass large contiguous data via derived data
+// types
+bool send_recv_bcast_large_count_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::vector<double> data(stride);
+  if (rank == 0)
+    std::iota(data.begin(), data.end(), 0.5);
+  const mplr::contiguous_layout<double> l(data.size());
+  comm_world.bcast(0, data.data(), l);
+  std::vector<double> expected(stride);
+  std::iota(expected.begin(), expected.end(), 0.5);
+  if (data != expected)
+    return false;
+  std::vector<double> recv_data(stride);
+  comm_world.sendrecv(data.data(), l, (rank + 1) % size, mplr::tag_t{1}, recv_data.data(),
+                      mplr::vector_layout<double>(stride), (rank + size - 1) % size,
+                      mplr::tag_t{1});
+  return recv_data == expected;
+}
+
+
+// contiguous layouts with counts above the limit need the large-count bindings
+bool gatherv_contiguous_large_count_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::vector<int> block(stride, rank);
+  mplr::contiguous_layouts<int> ls;
+  mplr::displacements displs;
+  for (int i{0}; i < size; ++i) {
+    ls.push_back(mplr::contiguous_layout<int>(stride));
+    displs.push_back(stride * i);
+  }
+  std::vector<int> gathered(stride * size, -1);
+#if defined MPLR_HAS_LARGE_COUNT
+  comm_world.gatherv(0, block.data(), mplr::contiguous_layout<int>(stride), gathered.data(),
+                     ls, displs);
+  if (rank == 0)
+    for (int i{0}; i < size * stride; ++i)
+      if (gathered[i] != i / stride)
+        return false;
+  return true;
+#else
+  try {
+    comm_world.gatherv(0, block.data(), mplr::contiguous_layout<int>(stride), gathered.data(),
+                       ls, displs);
+  } catch (mplr::invalid_count &) {
+    return true;
+  }
+  return false;
+#endif
+}
+
+
+// the variable-size collectives for containers reject sizes and offsets above the limit on
+// all processes
+template<typename F>
+bool throws_invalid_count(F &&f) {
+  try {
+    f();
+  } catch (mplr::invalid_count &) {
+    return true;
+  }
+  return false;
+}
+
+
+bool container_v_collectives_oversized_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  // the block of rank 0 exceeds the limit
+  const std::vector<int> oversized(rank == 0 ? stride : n, rank);
+  if (not throws_invalid_count([&] { comm_world.allgatherv(oversized); }))
+    return false;
+  if (not throws_invalid_count([&] { comm_world.gatherv(size - 1, oversized); }))
+    return false;
+  // the offset of the block of rank 2 exceeds the limit
+  const std::vector<int> block(40, rank);
+  if (throws_invalid_count([&] { comm_world.allgatherv(block); }) != (size > 2))
+    return false;
+  if (throws_invalid_count([&] { comm_world.gatherv(0, block); }) != (size > 2))
+    return false;
+  const std::vector<std::vector<int>> blocks(size, block);
+  if (throws_invalid_count([&] { comm_world.scatterv(0, blocks); }) != (size > 2))
+    return false;
+  std::vector<std::vector<int>> sendrecv_data(size, std::vector<int>(n, rank));
+  if (rank == 0)
+    sendrecv_data.back().resize(stride);
+  return throws_invalid_count([&] { comm_world.alltoallv(sendrecv_data); });
+}
+
+
+// the in-place alltoallv for containers places blocks beyond the limit via derived data types
+bool alltoallv_container_large_total_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::vector<std::vector<int>> sendrecv_data;
+  for (int i{0}; i < size; ++i)
+    sendrecv_data.emplace_back(40 + i, rank);
+  comm_world.alltoallv(sendrecv_data);
+  for (int i{0}; i < size; ++i)
+    if (sendrecv_data[i] != std::vector<int>(40 + rank, i))
+      return false;
+  return true;
+}
+
+
+BOOST_AUTO_TEST_CASE(large_count) {
+  if (not mplr::initialized())
+    mplr::init();
+  BOOST_TEST(alltoallv_large_displacements_test(false));
+  BOOST_TEST(alltoallv_large_displacements_test(true));
+  BOOST_TEST(alltoallv_in_place_large_displacements_test());
+  BOOST_TEST(gatherv_scatterv_large_displacements_test());
+  BOOST_TEST(sparse_alltoallv_large_displacements_test());
+  BOOST_TEST(send_recv_bcast_large_count_test());
+  BOOST_TEST(gatherv_contiguous_large_count_test());
+  BOOST_TEST(container_v_collectives_oversized_test());
+  BOOST_TEST(alltoallv_container_large_total_test());
+}
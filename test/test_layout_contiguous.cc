@@ -0,0 +1,114 @@
+#define BOOST_TEST_MODULE layout_contiguous
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+#include "test_helper.hpp"
+
+#include <array>
+#include <numeric>
+#include <vector>
+
+
+// contiguity is derived from the layouts' parameters
+bool is_contiguous_test() {
+  const std::vector<int> v(8);
+  const std::array<const int *, 3> gaps{&v[0], &v[1], &v[3]};
+  return mplr::vector_layout<double>(5).is_contiguous() and
+         mplr::contiguous_layout<tuple>(5).is_contiguous() and
+         mplr::empty_layout<int>().is_contiguous() and
+         not mplr::null_layout<int>().is_contiguous() and
+         mplr::strided_vector_layout<int>(3, 2, 2).is_contiguous() and
+         mplr::strided_vector_layout<int>(1, 4, 9).is_contiguous() and
+         not mplr::strided_vector_layout<int>(3, 2, 3).is_contiguous() and
+         mplr::indexed_layout<int>({{2, 3}, {0, 100}, {3, 5}}).is_contiguous() and
+         not mplr::indexed_layout<int>({{2, 0}, {3, 3}}).is_contiguous() and
+         not mplr::indexed_layout<int>({{1, 1}, {1, 0}}).is_contiguous() and
+         not mplr::indexed_layout<int>({{1, 0}, {1, 0}}).is_contiguous() and
+         mplr::hindexed_layout<int>({{2, 8}, {1, 8 + 2 * sizeof(int)}}).is_contiguous() and
+         not mplr::hindexed_layout<int>({{2, 8}, {1, 8 + sizeof(int)}}).is_contiguous() and
+         mplr::indexed_block_layout<int>(2, {4, 6, 8}).is_contiguous() and
+         not mplr::indexed_block_layout<int>(2, {4, 7}).is_contiguous() and
+         mplr::hindexed_block_layout<int>(1, {0, sizeof(int)}).is_contiguous() and
+         mplr::iterator_layout<int>(v.begin(), v.end()).is_contiguous() and
+         not mplr::iterator_layout<int>(gaps.begin(), gaps.end()).is_contiguous() and
+         mplr::subarray_layout<int>({{4, 1, 1}, {8, 8, 0}}).is_contiguous() and
+         mplr::subarray_layout<int>({{4, 2, 1}, {8, 8, 0}}).is_contiguous() and
+         mplr::subarray_layout<int>({{4, 1, 1}, {1, 1, 0}, {8, 3, 2}}).is_contiguous() and
+         not mplr::subarray_layout<int>({{4, 2, 1}, {8, 4, 0}}).is_contiguous() and
+         not mplr::vector_layout<int>(2, mplr::vector_layout<int>(3)).is_contiguous();
+}
+
+
+bool is_contiguous_fortran_order_test() {
+  mplr::subarray_layout<int>::parameter rows({{8, 8, 0}, {4, 2, 1}});
+  rows.order(mplr::array_orders::Fortran_order);
+  mplr::subarray_layout<int>::parameter columns({{8, 4, 0}, {4, 2, 1}});
+  columns.order(mplr::array_orders::Fortran_order);
+  return mplr::subarray_layout<int>(rows).is_contiguous() and
+         not mplr::subarray_layout<int>(columns).is_contiguous();
+}
+
+
+// copies and resized layouts remain contiguous
+bool is_contiguous_copy_test() {
+  const mplr::indexed_layout<int> l1({{4, 2}});
+  mplr::indexed_layout<int> l2(l1);
+  const mplr::indexed_layout<int> l3(l2);
+  l2.resize(0, 10);
+  mplr::layouts<int> ls;
+  ls.push_back(l1);
+  return l1.is_contiguous() and l2.is_contiguous() and l3.is_contiguous() and
+         ls[0].is_contiguous() and l2.extent() == 10;
+}
+
+
+// contiguous layouts at an offset are transferred to and from non-contiguous layouts
+template<typename T>
+bool send_recv_test(const T &init) {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::vector<T> send_data(12);
+  std::iota(send_data.begin(), send_data.end(), init);
+  const mplr::indexed_layout<T> send_layout({{4, 3}});
+  const mplr::strided_vector_layout<T> recv_layout(4, 1, 2);
+  std::vector<T> recv_data(8);
+  comm_world.sendrecv(send_data.data(), send_layout, (rank + 1) % size, mplr::tag_t{0},
+                      recv_data.data(), recv_layout, (rank + size - 1) % size, mplr::tag_t{0});
+  std::vector<T> expected(8);
+  for (int i{0}; i < 4; ++i)
+    expected[2 * i] = send_data[3 + i];
+  return send_layout.is_contiguous() and not recv_layout.is_contiguous() and
+         recv_data == expected;
+}
+
+
+// a contiguous subarray is broadcast into a contiguous layout at an offset
+bool bcast_test() {
+  const auto comm_world{mplr::comm_world()};
+  std::vector<int> data(32, -1);
+  if (comm_world.rank() == 0)
+    std::iota(data.begin(), data.end(), 0);
+  const mplr::subarray_layout<int> root_layout({{4, 2, 1}, {8, 8, 0}});
+  const mplr::vector_layout<int> layout(16);
+  if (comm_world.rank() == 0) {
+    comm_world.bcast(0, data.data(), root_layout);
+    return true;
+  }
+  comm_world.bcast(0, data.data() + 4, layout);
+  std::vector<int> expected(32, -1);
+  std::iota(expected.begin() + 4, expected.begin() + 20, 8);
+  return data == expected;
+}
+
+
+BOOST_AUTO_TEST_CASE(layout_contiguous) {
+  if (not mplr::initialized())
+    mplr::init();
+  BOOST_TEST(is_contiguous_test());
+  BOOST_TEST(is_contiguous_fortran_order_test());
+  BOOST_TEST(is_contiguous_copy_test());
+  BOOST_TEST(send_recv_test(1.0));
+  BOOST_TEST(send_recv_test(tuple{1, 2.0}));
+  BOOST_TEST(bcast_test());
+}
@@ -0,0 +1,68 @@
+#define BOOST_TEST_MODULE layout_copy
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+
+#include <numeric>
+#include <utility>
+#include <vector>
+
+
+// copies of a layout share the underlying data type
+bool layout_copy_shares_datatype_test() {
+  const mplr::strided_vector_layout<int> l1(4, 1, 2);
+  const mplr::strided_vector_layout<int> l2(l1);
+  mplr::strided_vector_layout<int> l3;
+  l3 = l2;
+  const mplr::layout<int> l4(l3);
+  const mplr::layouts<int> ls(8, l1);
+  bool ok{l1.native_handle() == l2.native_handle() and
+          l1.native_handle() == l3.native_handle() and l1.native_handle() == l4.native_handle()};
+  for (const auto &l : ls)
+    ok = ok and l.native_handle() == l1.native_handle();
+  const mplr::layouts<int> ls_copy(ls);
+  return ok and ls_copy[7].native_handle() == l1.native_handle();
+}
+
+
+// resizing a copy does not affect the other copies
+bool layout_copy_resize_test() {
+  const mplr::vector_layout<int> l1(4);
+  mplr::vector_layout<int> l2(l1);
+  l2.resize(0, 8);
+  return l1.native_handle() != l2.native_handle() and l1.extent() == 4 and
+         l2.extent() == 8 and l2.is_contiguous();
+}
+
+
+// the data type remains valid as long as any copy exists
+bool layout_copy_lifetime_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::vector<int> send_data(8);
+  std::iota(send_data.begin(), send_data.end(), 8 * rank);
+  std::vector<int> recv_data(8, -1);
+  mplr::layout<int> l;
+  {
+    const mplr::strided_vector_layout<int> original(4, 1, 2);
+    l = original;
+  }
+  mplr::layout<int> moved{std::move(l)};
+  comm_world.sendrecv(send_data.data(), moved, (rank + 1) % size, mplr::tag_t{0},
+                      recv_data.data(), moved, (rank + size - 1) % size, mplr::tag_t{0});
+  const int source{(rank + size - 1) % size};
+  for (int i{0}; i < 8; ++i)
+    if (recv_data[i] != (i % 2 == 0 ? 8 * source + i : -1))
+      return false;
+  return l.native_handle() == MPI_DATATYPE_NULL;
+}
+
+
+BOOST_AUTO_TEST_CASE(layout_copy) {
+  if (not mplr::initialized())
+    mplr::init();
+  BOOST_TEST(layout_copy_shares_datatype_test());
+  BOOST_TEST(layout_copy_resize_test());
+  BOOST_TEST(layout_copy_lifetime_test());
+}
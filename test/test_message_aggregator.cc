@@ -0,0 +1,100 @@
+#define BOOST_TEST_MODULE message_aggregator
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+
+// record: source rank, destination rank, sequence number
+using record = std::array<int, 3>;
+
+
+// every process pushes n records to every process including itself and receives all records
+// sent to it, records sent via the same tag must arrive in order
+template<bool use_try_receive>
+bool message_aggregator_test(int n, std::size_t max_bytes, double max_delay) {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::vector<std::array<int, 2>> next(size, {0, 1});
+  bool ok{true};
+  {
+    mplr::message_aggregator<record> aggregator(comm_world, max_bytes, max_delay);
+    for (int i{0}; i < n; ++i)
+      for (int destination{0}; destination < size; ++destination)
+        aggregator.push({rank, destination, i}, destination, mplr::tag_t{i % 2});
+    aggregator.flush();
+    int received{0};
+    while (received < n * size) {
+      mplr::message_aggregator<record>::batch batch;
+      if constexpr (use_try_receive) {
+        auto b{aggregator.try_receive()};
+        if (not b) {
+          aggregator.poll();
+          continue;
+        }
+        batch = std::move(*b);
+      } else
+        batch = aggregator.receive();
+      const int source{batch.status().source()};
+      const int tag{static_cast<int>(batch.status().tag())};
+      if (batch.empty() or batch.size() * sizeof(record) > std::max(max_bytes, sizeof(record)))
+        ok = false;
+      for (const auto& r : batch) {
+        if (r[0] != source or r[1] != rank or r[2] % 2 != tag or r[2] != next[source][tag])
+          ok = false;
+        next[source][tag] += 2;
+      }
+      received += static_cast<int>(batch.size());
+    }
+  }
+  comm_world.barrier();
+  return ok;
+}
+
+
+// an application message with the same tag on the parent communicator is left untouched
+bool message_aggregator_isolation_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int rank{comm_world.rank()};
+  const int application_message{-rank - 1};
+  auto request{comm_world.isend(application_message, rank, mplr::tag_t{0})};
+  bool ok{true};
+  {
+    mplr::message_aggregator<record> aggregator(comm_world);
+    aggregator.push({rank, rank, 0}, rank, mplr::tag_t{0});
+    aggregator.flush();
+    const auto batch{aggregator.receive()};
+    if (batch.size() != 1 or batch.begin()->at(0) != rank)
+      ok = false;
+  }
+  int received{0};
+  comm_world.recv(received, rank, mplr::tag_t{0});
+  request.wait();
+  comm_world.barrier();
+  return ok and received == application_message;
+}
+
+
+BOOST_AUTO_TEST_CASE(message_aggregator) {
+  if (not mplr::initialized())
+    mplr::init();
+  // size threshold
+  BOOST_TEST(message_aggregator_test<false>(1000, 1 << 10,
+                                            std::numeric_limits<double>::infinity()));
+  BOOST_TEST(message_aggregator_test<false>(1000, 1, std::numeric_limits<double>::infinity()));
+  // explicit flush only
+  BOOST_TEST(message_aggregator_test<false>(1000, 1 << 20,
+                                            std::numeric_limits<double>::infinity()));
+  // age threshold
+  BOOST_TEST(message_aggregator_test<true>(1000, 1 << 20, 0));
+  BOOST_TEST(message_aggregator_test<true>(1000, 1 << 10, 1e-4));
+  // isolation from other messages
+  BOOST_TEST(message_aggregator_isolation_test());
+}
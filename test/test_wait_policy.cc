@@ -0,0 +1,151 @@
+#define BOOST_TEST_MODULE wait_policy
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+
+// sends a value around the ring, the receiving side waits with the given policy while the
+// sending side delays its message
+template<typename P>
+bool wait_request_test(const P &policy) {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  for (int iteration{0}; iteration < 4; ++iteration) {
+    int x{0};
+    auto r{comm_world.irecv(x, (rank + size - 1) % size)};
+    std::this_thread::sleep_for(std::chrono::microseconds{100});
+    comm_world.send(rank + iteration, (rank + 1) % size);
+    const auto s{r.wait(policy)};
+    if (x != (rank + size - 1) % size + iteration or s.source() != (rank + size - 1) % size)
+      return false;
+  }
+  return true;
+}
+
+
+// receives values from all processes into a pool and waits with the given policy
+template<typename P>
+bool wait_pool_test(const P &policy) {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::vector<int> v(size, -1);
+  // waitall
+  {
+    mplr::irequest_pool pool;
+    for (int i{0}; i < size; ++i)
+      pool.push(comm_world.irecv(v[i], i));
+    for (int i{0}; i < size; ++i)
+      comm_world.send(rank, i);
+    pool.waitall(policy);
+    for (int i{0}; i < size; ++i)
+      if (v[i] != i)
+        return false;
+  }
+  // waitany and waitsome
+  for (int mode{0}; mode < 2; ++mode) {
+    mplr::irequest_pool pool;
+    for (int i{0}; i < size; ++i)
+      pool.push(comm_world.irecv(v[i], i));
+    for (int i{0}; i < size; ++i)
+      comm_world.send(-rank, i);
+    int completed{0};
+    while (true) {
+      if (mode == 0) {
+        const auto [result, index]{pool.waitany(policy)};
+        if (result == mplr::test_result::no_active_requests)
+          break;
+        ++completed;
+        if (v[index] != -static_cast<int>(index))
+          return false;
+      } else {
+        const auto [result, indices]{pool.waitsome(policy)};
+        if (result == mplr::test_result::no_active_requests)
+          break;
+        for (auto index : indices) {
+          ++completed;
+          if (v[index] != -static_cast<int>(index))
+            return false;
+        }
+      }
+    }
+    if (completed != size)
+      return false;
+  }
+  // wait for a single request
+  {
+    mplr::irequest_pool pool;
+    pool.push(comm_world.irecv(v[0], rank));
+    comm_world.send(42, rank);
+    pool.wait(0, policy);
+    if (v[0] != 42)
+      return false;
+  }
+  return true;
+}
+
+
+// blocking collectives that wait with the given policy
+template<typename P>
+bool collectives_test(const P &policy) {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  comm_world.barrier(policy);
+  int x{rank == 0 ? 17 : 0};
+  comm_world.bcast(0, x, policy);
+  if (x != 17)
+    return false;
+  std::vector<int> v(3, rank == 0 ? 23 : 0);
+  comm_world.bcast(0, v.data(), mplr::contiguous_layout<int>(v.size()), policy);
+  if (v != std::vector<int>(3, 23))
+    return false;
+  int sum{0};
+  comm_world.allreduce(mplr::plus<int>(), rank, sum, policy);
+  if (sum != size * (size - 1) / 2)
+    return false;
+  std::vector<int> sums(3);
+  comm_world.allreduce(mplr::plus<int>(), v.data(), sums.data(),
+                       mplr::contiguous_layout<int>(v.size()), policy);
+  if (sums != std::vector<int>(3, 23 * size))
+    return false;
+  sum = 0;
+  comm_world.reduce(mplr::plus<int>(), 0, rank, sum, policy);
+  if (rank == 0 and sum != size * (size - 1) / 2)
+    return false;
+  std::fill(sums.begin(), sums.end(), 0);
+  comm_world.reduce(mplr::plus<int>(), 0, v.data(), sums.data(),
+                    mplr::contiguous_layout<int>(v.size()), policy);
+  if (rank == 0 and sums != std::vector<int>(3, 23 * size))
+    return false;
+  return true;
+}
+
+
+template<typename P>
+bool wait_policy_test(const P &policy) {
+  return wait_request_test(policy) and wait_pool_test(policy) and collectives_test(policy);
+}
+
+
+BOOST_AUTO_TEST_CASE(wait_policy) {
+  if (not mplr::initialized())
+    mplr::init();
+  BOOST_TEST(wait_policy_test(mplr::busy_wait{}));
+  BOOST_TEST(wait_policy_test(mplr::backoff_wait{}));
+  BOOST_TEST(wait_policy_test(mplr::backoff_wait{0, 0}));
+  BOOST_TEST(wait_policy_test(mplr::deadline_wait{std::chrono::milliseconds{1}}));
+  BOOST_TEST(wait_policy_test(mplr::deadline_wait{mplr::deadline_wait::clock::now()}));
+  BOOST_TEST(wait_policy_test(mplr::duty_ratio{mplr::duty_ratio::preset::moderate}));
+  mplr::adaptive_wait adaptive;
+  BOOST_TEST(wait_policy_test(adaptive));
+  BOOST_TEST((adaptive.expected_duration() > mplr::adaptive_wait::duration::zero()));
+  adaptive.reset();
+  BOOST_TEST((adaptive.expected_duration() == mplr::adaptive_wait::duration::zero()));
+}
@@ -0,0 +1,132 @@
+#define BOOST_TEST_MODULE window
+
+#include "boost/test/included/unit_test.hpp"
+#include "mplr/mplr.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+// each process writes into the window of the next process and reads from the window of the
+// previous process within fences
+bool put_get_fence_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  const int next{(rank + 1) % size};
+  const int previous{(rank + size - 1) % size};
+  const int n{8};
+  mplr::window<int> win{comm_world, 2 * n};
+  std::fill_n(win.data(), 2 * n, -1);
+  win.fence();
+  win.put(rank, next, 0);
+  // every second element of the first half
+  std::vector<int> x(n / 2);
+  std::iota(x.begin(), x.end(), 10 * rank);
+  win.put(x.data(), mplr::vector_layout<int>(x.size()), next, 1,
+          mplr::strided_vector_layout<int>(n / 2, 1, 2));
+  win.fence();
+  bool ok{win.data()[0] == previous};
+  for (int i{0}; i < n / 2; ++i)
+    ok = ok and win.data()[1 + 2 * i] == 10 * previous + i;
+  std::iota(win.data() + n, win.data() + 2 * n, 100 * rank);
+  win.fence();
+  std::vector<int> y(n, -1);
+  win.get(y.data(), mplr::contiguous_layout<int>(n), previous, n);
+  int z{-1};
+  win.get(z, previous, 2 * n - 1);
+  win.fence();
+  std::vector<int> expected(n);
+  std::iota(expected.begin(), expected.end(), 100 * previous);
+  return ok and y == expected and z == 100 * previous + n - 1;
+}
+
+
+// all processes add to and exchange elements of the window of process 0 atomically
+bool atomic_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  std::vector<long> memory(4, 0);
+  mplr::window<long> win{comm_world, memory.data(), memory.size()};
+  win.fence();
+  win.accumulate(mplr::plus<long>(), rank + 1, 0, 0);
+  const std::vector<long> ones(2, 1);
+  win.accumulate(mplr::plus<long>(), ones.data(), mplr::contiguous_layout<long>(2), 0, 1);
+  win.fence();
+  bool ok{true};
+  if (rank == 0)
+    ok = memory[0] == size * (size + 1) / 2 and memory[1] == size and memory[2] == size;
+  comm_world.barrier();
+  win.lock(0, mplr::lock_type::shared);
+  long ticket{-1};
+  win.fetch_and_op(mplr::plus<long>(), 1, ticket, 0, 3);
+  win.unlock(0);
+  std::vector<long> tickets(size);
+  comm_world.allgather(ticket, tickets.data());
+  std::sort(tickets.begin(), tickets.end());
+  for (int i{0}; i < size; ++i)
+    ok = ok and tickets[i] == i;
+  // each process replaces an element of the next process's window if it has not changed
+  comm_world.barrier();
+  const int next{(rank + 1) % size};
+  const long unchanged{next == 0 ? size : 0};
+  win.lock(next);
+  long previous{-1};
+  win.compare_and_swap(rank + 10, unchanged, previous, next, 3);
+  win.unlock(next);
+  comm_world.barrier();
+  win.lock(rank, mplr::lock_type::shared);
+  win.sync();
+  ok = ok and previous == unchanged and memory[3] == (rank + size - 1) % size + 10;
+  win.unlock(rank);
+  comm_world.barrier();
+  win.lock(0, mplr::lock_type::shared);
+  long old_values[2];
+  const long new_values[2]{0, 0};
+  win.get_accumulate(mplr::max<long>(), new_values, old_values,
+                     mplr::contiguous_layout<long>(2), 0, 1);
+  win.unlock(0);
+  return ok and old_values[0] == size and old_values[1] == size;
+}
+
+
+// request-based operations within a passive-target epoch of all windows
+bool request_test() {
+  const auto comm_world{mplr::comm_world()};
+  const int size{comm_world.size()};
+  const int rank{comm_world.rank()};
+  mplr::window<double> win{comm_world, static_cast<std::size_t>(size)};
+  std::fill_n(win.data(), size, -1.0);
+  comm_world.barrier();
+  win.lock_all();
+  mplr::irequest_pool requests;
+  const double value{0.5 * rank};
+  for (int i{0}; i < size; ++i)
+    requests.push(win.rput(value, i, rank));
+  requests.waitall();
+  win.flush_all();
+  win.unlock_all();
+  comm_world.barrier();
+  win.lock_all();
+  std::vector<double> values(size);
+  const int previous{(rank + size - 1) % size};
+  requests.push(win.rget(values.data(), mplr::contiguous_layout<double>(size), previous, 0));
+  requests.waitall();
+  win.unlock_all();
+  comm_world.barrier();
+  bool ok{true};
+  for (int i{0}; i < size; ++i)
+    ok = ok and values[i] == 0.5 * i;
+  return ok;
+}
+
+
+BOOST_AUTO_TEST_CASE(window) {
+  if (not mplr::initialized())
+    mplr::init();
+  BOOST_TEST(put_get_fence_test());
+  BOOST_TEST(atomic_test());
+  BOOST_TEST(request_test());
+}